@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationcounter.cpp
+// ============
+// count of heap allocations, for checking that steady frames allocate nothing
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _DEBUG
+
+// declaration of global variables
+namespace
+{
+	// incremented by every allocation on any thread
+	std::atomic<unsigned long long> g_AllocationCount(0);
+}
+
+/***********************************************************
+ *  operator new()
+ *
+ *  The replacements count the call and use malloc, the
+ *  same as the default allocator. The nothrow and sized
+ *  forms of the standard library call these.
+ ***********************************************************/
+void* operator new(std::size_t size)
+{
+	g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	void* pMemory = std::malloc((size > 0) ? size : 1);
+	if (pMemory == NULL)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+/***********************************************************
+ *  IsEnabled()
+ ***********************************************************/
+bool AllocationCounter::IsEnabled()
+{
+	return true;
+}
+
+/***********************************************************
+ *  GetCount()
+ ***********************************************************/
+unsigned long long AllocationCounter::GetCount()
+{
+	return g_AllocationCount.load(std::memory_order_relaxed);
+}
+
+#else
+
+/***********************************************************
+ *  IsEnabled()
+ ***********************************************************/
+bool AllocationCounter::IsEnabled()
+{
+	return false;
+}
+
+/***********************************************************
+ *  GetCount()
+ ***********************************************************/
+unsigned long long AllocationCounter::GetCount()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,27 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationcounter.h
+// ============
+// count of heap allocations, for checking that steady frames allocate nothing
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+/***********************************************************
+ *  AllocationCounter
+ *
+ *  This class reports how many times the global operator
+ *  new has run. Debug builds replace operator new to count
+ *  every call; release builds keep the standard allocator
+ *  and the count stays at zero.
+ ***********************************************************/
+class AllocationCounter
+{
+public:
+	// whether allocations are being counted in this build
+	static bool IsEnabled();
+	// heap allocations made since the program started
+	static unsigned long long GetCount();
+};
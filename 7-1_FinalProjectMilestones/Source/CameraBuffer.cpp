@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerabuffer.cpp
+// ============
+// uniform buffer holding the matrices of every view rendered in a frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraBuffer.h"
+#include "ResourceAccounting.h"
+
+// declaration of global variables
+namespace
+{
+	// name of the uniform block in the scene shaders
+	const char* g_CameraBlockName = "CameraBlock";
+}
+
+/***********************************************************
+ *  CameraBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraBuffer::CameraBuffer()
+{
+	m_bufferID = 0;
+}
+
+/***********************************************************
+ *  ~CameraBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CameraBuffer::~CameraBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ ***********************************************************/
+void CameraBuffer::Initialize()
+{
+	Destroy();
+
+	glGenBuffers(1, &m_bufferID);
+	glBindBuffer(GL_UNIFORM_BUFFER, m_bufferID);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(CAMERA_DATA) * MAX_VIEWS, NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, "camera views",
+		sizeof(CAMERA_DATA) * MAX_VIEWS, 0);
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void CameraBuffer::Destroy()
+{
+	if (m_bufferID != 0)
+	{
+		glDeleteBuffers(1, &m_bufferID);
+		m_bufferID = 0;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, "camera views");
+	}
+}
+
+/***********************************************************
+ *  Update()
+ ***********************************************************/
+void CameraBuffer::Update(const CAMERA_VIEW* pViews, int viewCount)
+{
+	if (m_bufferID == 0)
+		return;
+
+	CAMERA_DATA cameras[MAX_VIEWS];
+	if (viewCount > MAX_VIEWS)
+		viewCount = MAX_VIEWS;
+	for (int i = 0; i < viewCount; i++)
+	{
+		cameras[i].view = pViews[i].view;
+		cameras[i].projection = pViews[i].projection;
+		cameras[i].position = glm::vec4(pViews[i].position, 1.0f);
+	}
+
+	glBindBuffer(GL_UNIFORM_BUFFER, m_bufferID);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(CAMERA_DATA) * viewCount, cameras);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+/***********************************************************
+ *  Bind()
+ ***********************************************************/
+void CameraBuffer::Bind()
+{
+	if (m_bufferID != 0)
+	{
+		glBindBufferBase(GL_UNIFORM_BUFFER, BINDING_POINT, m_bufferID);
+	}
+}
+
+/***********************************************************
+ *  BindProgram()
+ *
+ *  This method is used to connect a program's camera block
+ *  to the buffer. GLSL 3.30 has no binding qualifier, so
+ *  this is done once for each program after it is linked.
+ ***********************************************************/
+void CameraBuffer::BindProgram(GLuint programID)
+{
+	GLuint blockIndex = glGetUniformBlockIndex(programID, g_CameraBlockName);
+	if (blockIndex != GL_INVALID_INDEX)
+	{
+		glUniformBlockBinding(programID, blockIndex, BINDING_POINT);
+	}
+}
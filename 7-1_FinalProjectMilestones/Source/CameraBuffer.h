@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerabuffer.h
+// ============
+// uniform buffer holding the matrices of every view rendered in a frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  CameraBuffer
+ *
+ *  This class keeps the camera of each view in a uniform
+ *  buffer that every scene shader permutation reads, so
+ *  the cameras are uploaded once per frame instead of to
+ *  each program, and a draw can be rendered into several
+ *  views by indexing the buffer.
+ ***********************************************************/
+class CameraBuffer
+{
+public:
+	// constructor
+	CameraBuffer();
+	// destructor
+	~CameraBuffer();
+
+	// most views rendered in one frame
+	static const int MAX_VIEWS = 4;
+	// uniform buffer binding point used by the scene shaders
+	static const GLuint BINDING_POINT = 1;
+
+	// one camera and the part of the frame it is shown in
+	struct CAMERA_VIEW
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec3 position;
+		// left, bottom, width and height as fractions of the
+		// render target
+		glm::vec4 viewport;
+	};
+
+	// create the buffer
+	void Initialize();
+	// free the buffer
+	void Destroy();
+	bool IsAvailable() const { return m_bufferID != 0; }
+
+	// upload the cameras of a frame's views
+	void Update(const CAMERA_VIEW* pViews, int viewCount);
+	// bind the buffer to the shader binding point
+	void Bind();
+	// point a program's camera block at the binding point
+	static void BindProgram(GLuint programID);
+
+private:
+	// camera laid out to match the std140 CameraView struct in
+	// the scene shaders
+	struct CAMERA_DATA
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec4 position;
+	};
+
+	GLuint m_bufferID;
+};
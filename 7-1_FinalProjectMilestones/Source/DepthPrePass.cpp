@@ -0,0 +1,339 @@
+///////////////////////////////////////////////////////////////////////////////
+// depthprepass.cpp
+// ============
+// depth-only pre-pass shader and overdraw measurement for the 3D scene
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DepthPrePass.h"
+#include "ResourceCache.h"
+
+#include <iostream>
+
+#include "GLFW/glfw3.h"
+#include <glm/gtc/type_ptr.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the vertex transform must match the main vertex shader
+	// exactly so the lighting pass can use GL_EQUAL
+	const char* g_DepthVertexShader =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 inVertexPosition;\n"
+		"uniform mat4 model;\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 projection;\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = projection * view * model * vec4(inVertexPosition, 1.0f);\n"
+		"}\n";
+
+	// color output is only visible in the overdraw view
+	const char* g_DepthFragmentShader =
+		"#version 330 core\n"
+		"uniform vec4 overdrawColor;\n"
+		"out vec4 outFragmentColor;\n"
+		"void main()\n"
+		"{\n"
+		"	outFragmentColor = overdrawColor;\n"
+		"}\n";
+
+	// brightness added by every rasterized layer in the overdraw view
+	const float g_OverdrawStep = 0.08f;
+
+	// seconds between overdraw reports on the console
+	const double g_ReportInterval = 2.0;
+}
+
+/***********************************************************
+ *  DepthPrePass()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+DepthPrePass::DepthPrePass()
+{
+	m_programID = 0;
+	m_modelLocation = -1;
+	m_viewLocation = -1;
+	m_projectionLocation = -1;
+	m_colorLocation = -1;
+
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		m_queryIDs[i] = 0;
+		m_queryIssued[i] = false;
+		m_queryPixels[i] = 0;
+	}
+	m_queryIndex = 0;
+
+	m_overdraw = 0.0f;
+	m_bReport = false;
+	m_lastReportTime = 0.0;
+}
+
+/***********************************************************
+ *  ~DepthPrePass()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+DepthPrePass::~DepthPrePass()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to build the depth-only program
+ *  and create the samples passed queries.
+ ***********************************************************/
+bool DepthPrePass::Initialize(ShaderProgramCache* pProgramCache)
+{
+	if (pProgramCache == NULL)
+		return false;
+
+	m_programID = pProgramCache->BuildProgram(g_DepthVertexShader, g_DepthFragmentShader, "");
+	if (m_programID == 0)
+		return false;
+
+	m_modelLocation = glGetUniformLocation(m_programID, "model");
+	m_viewLocation = glGetUniformLocation(m_programID, "view");
+	m_projectionLocation = glGetUniformLocation(m_programID, "projection");
+	m_colorLocation = glGetUniformLocation(m_programID, "overdrawColor");
+
+	glGenQueries(QUERY_COUNT, m_queryIDs);
+
+	return true;
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used to free the program and queries.
+ ***********************************************************/
+void DepthPrePass::Destroy()
+{
+	if (m_programID != 0)
+	{
+		ResourceCache::ReleaseProgram(m_programID);
+		m_programID = 0;
+	}
+	if (m_queryIDs[0] != 0)
+	{
+		glDeleteQueries(QUERY_COUNT, m_queryIDs);
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			m_queryIDs[i] = 0;
+			m_queryIssued[i] = false;
+		}
+	}
+}
+
+/***********************************************************
+ *  BindProgram()
+ *
+ *  This method is used to bind the depth-only program and
+ *  set the camera matrices for the frame.
+ ***********************************************************/
+void DepthPrePass::BindProgram(const glm::mat4& view, const glm::mat4& projection)
+{
+	glUseProgram(m_programID);
+	glUniformMatrix4fv(m_viewLocation, 1, GL_FALSE, glm::value_ptr(view));
+	glUniformMatrix4fv(m_projectionLocation, 1, GL_FALSE, glm::value_ptr(projection));
+}
+
+/***********************************************************
+ *  BeginDepthPass()
+ *
+ *  This method is used to set up the depth-only pass, which
+ *  fills the depth buffer without touching the color buffer.
+ ***********************************************************/
+void DepthPrePass::BeginDepthPass(const glm::mat4& view, const glm::mat4& projection)
+{
+	BindProgram(view, projection);
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LESS);
+}
+
+/***********************************************************
+ *  EndDepthPass()
+ *
+ *  This method is used to end the depth-only pass, leaving
+ *  the default write masks and depth test.
+ ***********************************************************/
+void DepthPrePass::EndDepthPass()
+{
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+/***********************************************************
+ *  BeginLightingPass()
+ *
+ *  This method is used to set up a lighting pass over the
+ *  pre-pass depth, which only shades the fragments whose
+ *  depth matches the nearest surface.
+ ***********************************************************/
+void DepthPrePass::BeginLightingPass()
+{
+	glDepthMask(GL_FALSE);
+	glDepthFunc(GL_EQUAL);
+}
+
+/***********************************************************
+ *  EndLightingPass()
+ *
+ *  This method is used to restore the default depth state,
+ *  which the next frame's depth clear depends on.
+ ***********************************************************/
+void DepthPrePass::EndLightingPass()
+{
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LESS);
+}
+
+/***********************************************************
+ *  BeginOverdrawView()
+ *
+ *  This method is used to draw every rasterized fragment
+ *  with additive blending, so brighter pixels are covered
+ *  by more layers of geometry.
+ ***********************************************************/
+void DepthPrePass::BeginOverdrawView(const glm::mat4& view, const glm::mat4& projection)
+{
+	BindProgram(view, projection);
+	glUniform4f(m_colorLocation, g_OverdrawStep, g_OverdrawStep * 0.5f, g_OverdrawStep * 0.25f, 1.0f);
+
+	glDisable(GL_DEPTH_TEST);
+	glBlendFunc(GL_ONE, GL_ONE);
+}
+
+/***********************************************************
+ *  EndOverdrawView()
+ *
+ *  This method is used to restore the default depth and
+ *  blending state after the overdraw view.
+ ***********************************************************/
+void DepthPrePass::EndOverdrawView()
+{
+	glEnable(GL_DEPTH_TEST);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+/***********************************************************
+ *  BeginBoundsPass()
+ *
+ *  This method is used to test bounding boxes against the
+ *  depth buffer without changing the frame.
+ ***********************************************************/
+void DepthPrePass::BeginBoundsPass(const glm::mat4& view, const glm::mat4& projection)
+{
+	BindProgram(view, projection);
+
+	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+	glDepthMask(GL_FALSE);
+	glDepthFunc(GL_LEQUAL);
+}
+
+/***********************************************************
+ *  EndBoundsPass()
+ *
+ *  This method is used to restore the default write masks
+ *  and depth test after the bounding boxes are tested.
+ ***********************************************************/
+void DepthPrePass::EndBoundsPass()
+{
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LESS);
+}
+
+/***********************************************************
+ *  SetModel()
+ *
+ *  This method is used to set the model matrix for the
+ *  next depth-only draw.
+ ***********************************************************/
+void DepthPrePass::SetModel(const glm::mat4& model)
+{
+	glUniformMatrix4fv(m_modelLocation, 1, GL_FALSE, glm::value_ptr(model));
+}
+
+/***********************************************************
+ *  BeginShadingQuery()
+ *
+ *  This method is used to start counting the samples that
+ *  pass the depth test, which is the number of fragments
+ *  the lighting shader has to shade.
+ ***********************************************************/
+void DepthPrePass::BeginShadingQuery()
+{
+	if (m_queryIDs[0] == 0)
+		return;
+
+	CollectQueryResults();
+
+	// all queries still in flight, skip measuring this frame
+	// rather than stalling on an older result
+	if (m_queryIssued[m_queryIndex] == true)
+		return;
+
+	glBeginQuery(GL_SAMPLES_PASSED, m_queryIDs[m_queryIndex]);
+	m_queryIssued[m_queryIndex] = true;
+}
+
+/***********************************************************
+ *  EndShadingQuery()
+ *
+ *  This method is used to stop counting shaded samples for
+ *  the frame.
+ ***********************************************************/
+void DepthPrePass::EndShadingQuery(int framebufferWidth, int framebufferHeight)
+{
+	if ((m_queryIDs[0] == 0) || (m_queryPixels[m_queryIndex] != 0))
+		return;
+
+	glEndQuery(GL_SAMPLES_PASSED);
+	m_queryPixels[m_queryIndex] = framebufferWidth * framebufferHeight;
+	m_queryIndex = (m_queryIndex + 1) % QUERY_COUNT;
+}
+
+/***********************************************************
+ *  CollectQueryResults()
+ *
+ *  This method is used to read back the results of queries
+ *  from earlier frames without waiting on the GPU.
+ ***********************************************************/
+void DepthPrePass::CollectQueryResults()
+{
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		if ((m_queryIssued[i] == false) || (m_queryPixels[i] == 0))
+			continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(m_queryIDs[i], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			continue;
+
+		GLuint samples = 0;
+		glGetQueryObjectuiv(m_queryIDs[i], GL_QUERY_RESULT, &samples);
+		m_overdraw = (float)samples / (float)m_queryPixels[i];
+		m_queryIssued[i] = false;
+		m_queryPixels[i] = 0;
+	}
+
+	if (m_bReport == false)
+		return;
+
+	double currentTime = glfwGetTime();
+	if (currentTime - m_lastReportTime >= g_ReportInterval)
+	{
+		std::cout << "INFO: Shaded fragments per pixel: " << m_overdraw << std::endl;
+		m_lastReportTime = currentTime;
+	}
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// depthprepass.h
+// ============
+// depth-only pre-pass shader and overdraw measurement for the 3D scene
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "ShaderProgramCache.h"
+
+/***********************************************************
+ *  DepthPrePass
+ *
+ *  This class owns a minimal shader program that only
+ *  writes depth, used to lay down the depth buffer before
+ *  the full lighting pass, and the occlusion queries used
+ *  to measure how many fragments the lighting pass shades.
+ ***********************************************************/
+class DepthPrePass
+{
+public:
+	// constructor
+	DepthPrePass();
+	// destructor
+	~DepthPrePass();
+
+	// build the depth-only program and create the queries
+	bool Initialize(ShaderProgramCache* pProgramCache);
+	// free the program and queries
+	void Destroy();
+
+	// bind the depth-only program with color writes disabled
+	void BeginDepthPass(const glm::mat4& view, const glm::mat4& projection);
+	// restore color writes after the depth-only pass
+	void EndDepthPass();
+	// shade only the nearest surface with GL_EQUAL, leaving
+	// the pre-pass depth untouched
+	void BeginLightingPass();
+	// restore the default depth state after the lighting pass
+	void EndLightingPass();
+
+	// bind the depth-only program with additive blending so
+	// every rasterized layer brightens the pixel
+	void BeginOverdrawView(const glm::mat4& view, const glm::mat4& projection);
+	// restore the default depth and blend state
+	void EndOverdrawView();
+
+	// bind the depth-only program with color and depth writes
+	// disabled, for drawing occlusion query bounding boxes
+	void BeginBoundsPass(const glm::mat4& view, const glm::mat4& projection);
+	// restore color and depth writes
+	void EndBoundsPass();
+
+	// set the model matrix for the next depth-only draw
+	void SetModel(const glm::mat4& model);
+
+	// count the samples shaded between these two calls
+	void BeginShadingQuery();
+	void EndShadingQuery(int framebufferWidth, int framebufferHeight);
+
+	// average number of shaded fragments per pixel
+	float GetOverdraw() const { return m_overdraw; }
+	// print the overdraw to the console every few seconds,
+	// which is off unless a diagnostic view asks for it
+	void SetReportEnabled(bool bEnabled) { m_bReport = bEnabled; }
+	bool IsReportEnabled() const { return m_bReport; }
+
+private:
+	// number of queries in flight, so results are never waited on
+	static const int QUERY_COUNT = 3;
+
+	// depth-only shader program
+	GLuint m_programID;
+	GLint m_modelLocation;
+	GLint m_viewLocation;
+	GLint m_projectionLocation;
+	GLint m_colorLocation;
+
+	// samples passed queries used round robin
+	GLuint m_queryIDs[QUERY_COUNT];
+	bool m_queryIssued[QUERY_COUNT];
+	int m_queryIndex;
+	// pixel count of the frame each query was issued for
+	int m_queryPixels[QUERY_COUNT];
+
+	// latest overdraw measurement
+	float m_overdraw;
+	// whether the overdraw is printed, and when it last was
+	bool m_bReport;
+	double m_lastReportTime;
+
+	// bind the program and set the camera matrices
+	void BindProgram(const glm::mat4& view, const glm::mat4& projection);
+	// read back any query results that are ready
+	void CollectQueryResults();
+};
@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////
+// drawdataring.cpp
+// ============
+// persistently mapped ring of per-draw shader data
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DrawDataRing.h"
+#include "ResourceAccounting.h"
+
+#include <iostream>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// nanoseconds to block on a fence before checking again
+	const GLuint64 g_FenceWaitTimeout = 1000000000;
+}
+
+/***********************************************************
+ *  DrawDataRing()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+DrawDataRing::DrawDataRing()
+{
+	m_bufferID = 0;
+	m_pMapped = NULL;
+	m_maxDraws = 0;
+	m_regionSize = 0;
+	m_region = 0;
+	m_drawCount = 0;
+	m_stallCount = 0;
+
+	for (int i = 0; i < REGION_COUNT; i++)
+	{
+		m_fences[i] = 0;
+	}
+}
+
+/***********************************************************
+ *  ~DrawDataRing()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+DrawDataRing::~DrawDataRing()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to create the buffer with immutable
+ *  storage and map it once. The coherent mapping means
+ *  writes are seen by the GPU without explicit flushes.
+ ***********************************************************/
+bool DrawDataRing::Initialize(int maxDrawsPerFrame)
+{
+	Destroy();
+
+	if (!(GLEW_VERSION_4_4 ||
+		(GLEW_ARB_buffer_storage && GLEW_ARB_shader_storage_buffer_object)))
+	{
+		std::cout << "INFO: Persistent buffers not supported, per-draw data uses uniforms" << std::endl;
+		return false;
+	}
+
+	// each region has to start on a valid binding offset
+	GLint alignment = 1;
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	if (alignment < 1)
+		alignment = 1;
+
+	m_maxDraws = maxDrawsPerFrame;
+	m_regionSize = (GLsizeiptr)(sizeof(DRAW_DATA) * maxDrawsPerFrame);
+	m_regionSize = ((m_regionSize + alignment - 1) / alignment) * alignment;
+
+	GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	glGenBuffers(1, &m_bufferID);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bufferID);
+	glBufferStorage(GL_SHADER_STORAGE_BUFFER, m_regionSize * REGION_COUNT, NULL, flags);
+	m_pMapped = (unsigned char*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0,
+		m_regionSize * REGION_COUNT, flags);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	if (m_pMapped == NULL)
+	{
+		std::cout << "Could not map the per-draw data buffer" << std::endl;
+		Destroy();
+		return false;
+	}
+
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, "per-draw data",
+		(unsigned long long)(m_regionSize * REGION_COUNT), 0);
+
+	m_region = 0;
+	m_drawCount = 0;
+	return true;
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void DrawDataRing::Destroy()
+{
+	for (int i = 0; i < REGION_COUNT; i++)
+	{
+		if (m_fences[i] != 0)
+		{
+			glDeleteSync(m_fences[i]);
+			m_fences[i] = 0;
+		}
+	}
+
+	if (m_bufferID != 0)
+	{
+		if (m_pMapped != NULL)
+		{
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_bufferID);
+			glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+			glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &m_bufferID);
+		m_bufferID = 0;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, "per-draw data");
+
+		std::cout << "INFO: Per-draw data waited on the GPU in "
+			<< m_stallCount << " frames" << std::endl;
+	}
+	m_pMapped = NULL;
+	m_stallCount = 0;
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used to start writing the next region.
+ *  With three regions the fence has normally signaled
+ *  already, so the wait only happens when the GPU falls
+ *  more than two frames behind.
+ ***********************************************************/
+void DrawDataRing::BeginFrame()
+{
+	if (m_pMapped == NULL)
+		return;
+
+	m_region = (m_region + 1) % REGION_COUNT;
+	m_drawCount = 0;
+
+	GLsync fence = m_fences[m_region];
+	if (fence == 0)
+		return;
+
+	GLenum result = glClientWaitSync(fence, 0, 0);
+	if (result == GL_TIMEOUT_EXPIRED)
+	{
+		m_stallCount++;
+		do
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, g_FenceWaitTimeout);
+		} while (result == GL_TIMEOUT_EXPIRED);
+	}
+
+	glDeleteSync(fence);
+	m_fences[m_region] = 0;
+}
+
+/***********************************************************
+ *  Append()
+ ***********************************************************/
+int DrawDataRing::Append(const DRAW_DATA& data)
+{
+	if ((m_pMapped == NULL) || (m_drawCount >= m_maxDraws))
+		return -1;
+
+	unsigned char* pRegion = m_pMapped + (m_regionSize * m_region);
+	memcpy(pRegion + (sizeof(DRAW_DATA) * m_drawCount), &data, sizeof(DRAW_DATA));
+
+	return(m_drawCount++);
+}
+
+/***********************************************************
+ *  Bind()
+ ***********************************************************/
+void DrawDataRing::Bind()
+{
+	if (m_pMapped == NULL)
+		return;
+
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, BINDING_POINT, m_bufferID,
+		m_regionSize * m_region, m_regionSize);
+}
+
+/***********************************************************
+ *  EndFrame()
+ ***********************************************************/
+void DrawDataRing::EndFrame()
+{
+	if (m_pMapped == NULL)
+		return;
+
+	if (m_fences[m_region] != 0)
+	{
+		glDeleteSync(m_fences[m_region]);
+	}
+	m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
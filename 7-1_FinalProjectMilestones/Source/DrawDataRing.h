@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// drawdataring.h
+// ============
+// persistently mapped ring of per-draw shader data
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  DrawDataRing
+ *
+ *  This class keeps the per-draw shader data in a shader
+ *  storage buffer that stays mapped for the whole run. The
+ *  buffer is split into one region per frame in flight, and
+ *  a fence on each region keeps the CPU from overwriting
+ *  data the GPU has not read yet. Writing a draw's data is
+ *  a plain copy into mapped memory.
+ ***********************************************************/
+class DrawDataRing
+{
+public:
+	// constructor
+	DrawDataRing();
+	// destructor
+	~DrawDataRing();
+
+	// per-draw data, laid out to match the std430 DrawData
+	// struct in the scene shaders
+	struct DRAW_DATA
+	{
+		glm::mat4 model;
+		glm::vec4 color;
+		// xy hold the UV scale, z is 1 when the atlas tile repeats
+		glm::vec4 uvScale;
+		// atlas tile corner and size, zero outside the atlas
+		glm::vec4 atlasRect;
+		// w holds the shininess
+		glm::vec4 diffuseColor;
+		glm::vec4 specularColor;
+		// lightmap tile corner and size, zero when not baked
+		glm::vec4 lightmapRect;
+	};
+
+	// number of frames that can be in flight at once
+	static const int REGION_COUNT = 3;
+	// shader storage binding point used by the scene shaders
+	static const GLuint BINDING_POINT = 0;
+
+	// create and map the buffer, if the context supports it
+	bool Initialize(int maxDrawsPerFrame);
+	// unmap and free the buffer
+	void Destroy();
+	bool IsAvailable() const { return m_pMapped != NULL; }
+
+	// move to the next region, waiting for the GPU to finish
+	// with it if it is still in use
+	void BeginFrame();
+	// copy one draw's data into the current region, returning
+	// its index in the region, or -1 when the region is full
+	int Append(const DRAW_DATA& data);
+	// bind the current region to the shader binding point
+	void Bind();
+	// fence the current region after the frame's last draw
+	void EndFrame();
+
+private:
+	GLuint m_bufferID;
+	// start of the mapped buffer
+	unsigned char* m_pMapped;
+	// one fence per region, 0 when the region is free
+	GLsync m_fences[REGION_COUNT];
+	// draws that fit in each region
+	int m_maxDraws;
+	// bytes per region, padded to the binding alignment
+	GLsizeiptr m_regionSize;
+	// region written this frame
+	int m_region;
+	// draws written to the region this frame
+	int m_drawCount;
+	// frames that had to wait on a fence
+	int m_stallCount;
+};
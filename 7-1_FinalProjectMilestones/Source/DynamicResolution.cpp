@@ -0,0 +1,343 @@
+///////////////////////////////////////////////////////////////////////////////
+// dynamicresolution.cpp
+// ============
+// offscreen scene rendering at a resolution scaled to hold a GPU frame time
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DynamicResolution.h"
+#include "ResourceAccounting.h"
+
+#include <iostream>
+#include <cmath>
+
+#include "GLFW/glfw3.h"
+
+// declaration of global variables
+namespace
+{
+	// default GPU time per frame, leaving headroom under 60 Hz
+	const double g_DefaultTargetFrameTime = 14.0;
+
+	// render scale limits and the step the scale moves in, so
+	// small timing changes do not reallocate the target
+	const float g_MinScale = 0.5f;
+	const float g_MaxScale = 1.0f;
+	const float g_ScaleStep = 0.05f;
+
+	// seconds between scale adjustments
+	const double g_AdjustInterval = 0.5;
+
+	// frames under this share of the target can scale up
+	const double g_ScaleUpThreshold = 0.8;
+
+	// weight of the newest timer result in the average
+	const double g_AverageWeight = 0.1;
+}
+
+/***********************************************************
+ *  DynamicResolution()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+DynamicResolution::DynamicResolution()
+{
+	m_bEnabled = true;
+	m_targetFrameTime = g_DefaultTargetFrameTime;
+	m_scale = g_MaxScale;
+	m_averageFrameTime = -1.0;
+	m_lastAdjustTime = 0.0;
+
+	m_framebufferID = 0;
+	m_colorTextureID = 0;
+	m_depthRenderbufferID = 0;
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	m_windowWidth = 0;
+	m_windowHeight = 0;
+
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		m_queryIDs[i] = 0;
+		m_bQueryIssued[i] = false;
+	}
+	m_queryIndex = 0;
+	m_bQueryActive = false;
+}
+
+/***********************************************************
+ *  ~DynamicResolution()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+DynamicResolution::~DynamicResolution()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ ***********************************************************/
+void DynamicResolution::Initialize()
+{
+	glGenQueries(QUERY_COUNT, m_queryIDs);
+	m_lastAdjustTime = glfwGetTime();
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void DynamicResolution::Destroy()
+{
+	DestroyTarget();
+
+	if (m_queryIDs[0] != 0)
+	{
+		glDeleteQueries(QUERY_COUNT, m_queryIDs);
+		for (int i = 0; i < QUERY_COUNT; i++)
+		{
+			m_queryIDs[i] = 0;
+			m_bQueryIssued[i] = false;
+		}
+	}
+}
+
+/***********************************************************
+ *  SetEnabled()
+ ***********************************************************/
+void DynamicResolution::SetEnabled(bool bEnabled)
+{
+	m_bEnabled = bEnabled;
+	m_scale = g_MaxScale;
+	m_averageFrameTime = -1.0;
+	std::cout << "INFO: Dynamic resolution " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  DestroyTarget()
+ ***********************************************************/
+void DynamicResolution::DestroyTarget()
+{
+	if (m_framebufferID != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebufferID);
+		m_framebufferID = 0;
+	}
+	if (m_colorTextureID != 0)
+	{
+		glDeleteTextures(1, &m_colorTextureID);
+		m_colorTextureID = 0;
+	}
+	if (m_depthRenderbufferID != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthRenderbufferID);
+		m_depthRenderbufferID = 0;
+	}
+	m_targetWidth = 0;
+	m_targetHeight = 0;
+	ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_RENDER_TARGET, "dynamic resolution");
+}
+
+/***********************************************************
+ *  ResizeTarget()
+ ***********************************************************/
+void DynamicResolution::ResizeTarget(int width, int height)
+{
+	if ((width == m_targetWidth) && (height == m_targetHeight) && (m_framebufferID != 0))
+		return;
+
+	DestroyTarget();
+
+	glGenTextures(1, &m_colorTextureID);
+	glBindTexture(GL_TEXTURE_2D, m_colorTextureID);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenRenderbuffers(1, &m_depthRenderbufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebufferID);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_colorTextureID, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbufferID);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cout << "Could not create the dynamic resolution target" << std::endl;
+		DestroyTarget();
+		return;
+	}
+
+	m_targetWidth = width;
+	m_targetHeight = height;
+
+	// RGBA8 color and packed 24 bit depth with 8 bit stencil
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_RENDER_TARGET, "dynamic resolution",
+		(unsigned long long)width * height * 8, 0);
+}
+
+/***********************************************************
+ *  CollectQueryResults()
+ *
+ *  This method is used to read the timer queries that the
+ *  GPU has finished, without waiting for the rest.
+ ***********************************************************/
+void DynamicResolution::CollectQueryResults()
+{
+	for (int i = 0; i < QUERY_COUNT; i++)
+	{
+		if (m_bQueryIssued[i] == false)
+			continue;
+
+		GLuint available = 0;
+		glGetQueryObjectuiv(m_queryIDs[i], GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available == 0)
+			continue;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(m_queryIDs[i], GL_QUERY_RESULT, &elapsed);
+		m_bQueryIssued[i] = false;
+
+		double milliseconds = elapsed / 1000000.0;
+		if (m_averageFrameTime < 0.0)
+			m_averageFrameTime = milliseconds;
+		else
+			m_averageFrameTime += (milliseconds - m_averageFrameTime) * g_AverageWeight;
+	}
+}
+
+/***********************************************************
+ *  AdjustScale()
+ *
+ *  This method is used to move the scale toward the target.
+ *  GPU time grows with the pixel count, the square of the
+ *  scale, so a frame over budget jumps straight to the
+ *  estimated scale, while scaling up goes one step at a
+ *  time to avoid oscillating around the target.
+ ***********************************************************/
+void DynamicResolution::AdjustScale(double now)
+{
+	if ((m_averageFrameTime <= 0.0) || (now - m_lastAdjustTime < g_AdjustInterval))
+		return;
+	m_lastAdjustTime = now;
+
+	float scale = m_scale;
+	if (m_averageFrameTime > m_targetFrameTime)
+	{
+		scale = m_scale * (float)std::sqrt(m_targetFrameTime / m_averageFrameTime);
+		scale = std::floor(scale / g_ScaleStep) * g_ScaleStep;
+	}
+	else if (m_averageFrameTime < m_targetFrameTime * g_ScaleUpThreshold)
+	{
+		scale = m_scale + g_ScaleStep;
+	}
+
+	if (scale < g_MinScale)
+		scale = g_MinScale;
+	if (scale > g_MaxScale)
+		scale = g_MaxScale;
+
+	if (std::fabs(scale - m_scale) > g_ScaleStep * 0.5f)
+	{
+		std::cout << "INFO: Render scale " << scale * 100.0f << "% (GPU "
+			<< m_averageFrameTime << " ms, target " << m_targetFrameTime << " ms)" << std::endl;
+		m_scale = scale;
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ ***********************************************************/
+void DynamicResolution::BeginFrame(int framebufferWidth, int framebufferHeight)
+{
+	m_windowWidth = framebufferWidth;
+	m_windowHeight = framebufferHeight;
+
+	CollectQueryResults();
+	if (m_bEnabled == true)
+	{
+		AdjustScale(glfwGetTime());
+
+		int width = (int)(framebufferWidth * m_scale + 0.5f);
+		int height = (int)(framebufferHeight * m_scale + 0.5f);
+		if ((width > 0) && (height > 0))
+		{
+			ResizeTarget(width, height);
+		}
+	}
+
+	if ((m_bEnabled == true) && (m_framebufferID != 0))
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+		glViewport(0, 0, m_targetWidth, m_targetHeight);
+	}
+	else
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, framebufferWidth, framebufferHeight);
+	}
+
+	// time the frame unless every query is still in flight
+	m_bQueryActive = false;
+	if ((m_queryIDs[0] != 0) && (m_bQueryIssued[m_queryIndex] == false))
+	{
+		glBeginQuery(GL_TIME_ELAPSED, m_queryIDs[m_queryIndex]);
+		m_bQueryActive = true;
+	}
+}
+
+/***********************************************************
+ *  EndFrame()
+ ***********************************************************/
+void DynamicResolution::EndFrame()
+{
+	if (m_bQueryActive == true)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_bQueryIssued[m_queryIndex] = true;
+		m_queryIndex = (m_queryIndex + 1) % QUERY_COUNT;
+		m_bQueryActive = false;
+	}
+
+	if ((m_bEnabled == true) && (m_framebufferID != 0))
+	{
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebufferID);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, m_targetWidth, m_targetHeight,
+			0, 0, m_windowWidth, m_windowHeight,
+			GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, m_windowWidth, m_windowHeight);
+	}
+}
+
+/***********************************************************
+ *  PresentLastFrame()
+ *
+ *  This method is used to refresh the window from the
+ *  offscreen target, which still holds the last frame.
+ *  Without the target, or after a resize, the frame has to
+ *  be rendered again.
+ ***********************************************************/
+bool DynamicResolution::PresentLastFrame(int framebufferWidth, int framebufferHeight)
+{
+	if ((m_bEnabled == false) || (m_framebufferID == 0) ||
+		(framebufferWidth != m_windowWidth) || (framebufferHeight != m_windowHeight))
+		return false;
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebufferID);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+	glBlitFramebuffer(0, 0, m_targetWidth, m_targetHeight,
+		0, 0, m_windowWidth, m_windowHeight,
+		GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	return true;
+}
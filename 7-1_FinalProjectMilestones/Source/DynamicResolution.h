@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// dynamicresolution.h
+// ============
+// offscreen scene rendering at a resolution scaled to hold a GPU frame time
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+/***********************************************************
+ *  DynamicResolution
+ *
+ *  This class renders the scene into an offscreen color and
+ *  depth target, then scales it up to the window. The GPU
+ *  time of each frame is measured with timer queries, read
+ *  back a few frames later so the CPU never waits, and the
+ *  render resolution is lowered when frames run over the
+ *  target time and raised again when there is headroom.
+ ***********************************************************/
+class DynamicResolution
+{
+public:
+	// constructor
+	DynamicResolution();
+	// destructor
+	~DynamicResolution();
+
+	// create the timer queries
+	void Initialize();
+	// free the render target and queries
+	void Destroy();
+
+	// enable or disable scaling, rendering at full size when off
+	void SetEnabled(bool bEnabled);
+	bool IsEnabled() const { return m_bEnabled; }
+	// GPU time per frame the scale is adjusted to hold
+	void SetTargetFrameTime(double milliseconds) { m_targetFrameTime = milliseconds; }
+
+	// bind the render target for a frame of the given window
+	// framebuffer size and set the viewport to match
+	void BeginFrame(int framebufferWidth, int framebufferHeight);
+	// scale the rendered frame up to the window framebuffer
+	void EndFrame();
+	// show the last rendered frame again without rendering,
+	// returning false if there is no frame to show
+	bool PresentLastFrame(int framebufferWidth, int framebufferHeight);
+
+	float GetScale() const { return m_scale; }
+
+private:
+	// number of timer queries in flight
+	static const int QUERY_COUNT = 4;
+
+	bool m_bEnabled;
+	double m_targetFrameTime;
+	// current render scale for each axis
+	float m_scale;
+	// smoothed GPU frame time in milliseconds, or negative
+	// before the first result
+	double m_averageFrameTime;
+	double m_lastAdjustTime;
+
+	// offscreen target and its size
+	GLuint m_framebufferID;
+	GLuint m_colorTextureID;
+	GLuint m_depthRenderbufferID;
+	int m_targetWidth;
+	int m_targetHeight;
+	// window framebuffer size for the current frame
+	int m_windowWidth;
+	int m_windowHeight;
+
+	// round robin GPU timer queries
+	GLuint m_queryIDs[QUERY_COUNT];
+	bool m_bQueryIssued[QUERY_COUNT];
+	int m_queryIndex;
+	bool m_bQueryActive;
+
+	// read any finished timer queries into the average
+	void CollectQueryResults();
+	// move the scale toward the target frame time
+	void AdjustScale(double now);
+	// make the render target match a size
+	void ResizeTarget(int width, int height);
+	void DestroyTarget();
+};
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.cpp
+// ============
+// linear allocator for scratch memory that only lives for one frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameArena.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// alignment of every block, enough for any scalar type
+	const size_t g_BlockAlignment = alignof(std::max_align_t);
+}
+
+/***********************************************************
+ *  FrameArena()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameArena::FrameArena()
+{
+	m_pBlock = NULL;
+	m_capacity = 0;
+	m_used = 0;
+	m_frameUsed = 0;
+	m_highWater = 0;
+}
+
+/***********************************************************
+ *  ~FrameArena()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameArena::~FrameArena()
+{
+	Reset();
+	delete[] m_pBlock;
+	m_pBlock = NULL;
+}
+
+/***********************************************************
+ *  Reserve()
+ *
+ *  This method is used to grow the main block. It must not
+ *  be called while memory from the current frame is in use.
+ ***********************************************************/
+void FrameArena::Reserve(size_t bytes)
+{
+	if (bytes <= m_capacity)
+		return;
+
+	delete[] m_pBlock;
+	m_pBlock = new unsigned char[bytes];
+	m_capacity = bytes;
+	m_used = 0;
+}
+
+/***********************************************************
+ *  Reset()
+ ***********************************************************/
+void FrameArena::Reset()
+{
+	for (unsigned char* pBlock : m_overflowBlocks)
+	{
+		delete[] pBlock;
+	}
+
+	// the last frame did not fit, so make room for all of it
+	if (m_overflowBlocks.empty() == false)
+	{
+		m_overflowBlocks.clear();
+		std::cout << "INFO: Frame arena grown to " << m_highWater << " bytes" << std::endl;
+		Reserve(m_highWater);
+	}
+
+	m_used = 0;
+	m_frameUsed = 0;
+}
+
+/***********************************************************
+ *  AllocateBytes()
+ *
+ *  This method is used to take the next aligned range of
+ *  the main block, or a block of its own when the main
+ *  block is full. Padding for the alignment is counted in
+ *  the high water mark, so the grown block fits the same
+ *  frame again.
+ ***********************************************************/
+void* FrameArena::AllocateBytes(size_t size, size_t alignment)
+{
+	size_t offset = (m_used + alignment - 1) & ~(alignment - 1);
+	if (offset + size <= m_capacity)
+	{
+		m_frameUsed += offset + size - m_used;
+		m_used = offset + size;
+		if (m_frameUsed > m_highWater)
+			m_highWater = m_frameUsed;
+		return m_pBlock + offset;
+	}
+
+	size_t blockSize = (size > 0) ? size : 1;
+	unsigned char* pBlock = new unsigned char[blockSize];
+	m_overflowBlocks.push_back(pBlock);
+	m_frameUsed += blockSize + g_BlockAlignment;
+	if (m_frameUsed > m_highWater)
+		m_highWater = m_frameUsed;
+	return pBlock;
+}
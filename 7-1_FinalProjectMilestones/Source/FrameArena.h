@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.h
+// ============
+// linear allocator for scratch memory that only lives for one frame
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  FrameArena
+ *
+ *  This class hands out scratch memory for the current
+ *  frame by moving an offset through one block. Nothing is
+ *  freed on its own; Reset() at the start of the next frame
+ *  releases everything at once. A frame that needs more than
+ *  the block holds gets extra blocks, and the next Reset()
+ *  grows the main block to the most any frame has used, so
+ *  once the scene is steady no frame touches the heap.
+ ***********************************************************/
+class FrameArena
+{
+public:
+	// constructor
+	FrameArena();
+	// destructor
+	~FrameArena();
+
+	// make sure the main block holds at least this many bytes
+	void Reserve(size_t bytes);
+	// release everything allocated in the last frame
+	void Reset();
+
+	// uninitialized storage for count values of type T, valid
+	// until the next Reset()
+	template<typename T>
+	T* Allocate(size_t count)
+	{
+		return static_cast<T*>(AllocateBytes(sizeof(T) * count, alignof(T)));
+	}
+
+	// most bytes used by any frame so far
+	size_t GetHighWater() const { return m_highWater; }
+
+private:
+	// main block and the bytes of it in use this frame
+	unsigned char* m_pBlock;
+	size_t m_capacity;
+	size_t m_used;
+	// bytes used this frame, including the extra blocks
+	size_t m_frameUsed;
+	size_t m_highWater;
+	// blocks added when the main block ran out this frame
+	std::vector<unsigned char*> m_overflowBlocks;
+
+	void* AllocateBytes(size_t size, size_t alignment);
+};
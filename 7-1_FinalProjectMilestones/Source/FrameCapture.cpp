@@ -0,0 +1,405 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.cpp
+// ============
+// recording of rendered frames through asynchronous pixel buffer readback
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameCapture.h"
+#include "ResourceAccounting.h"
+
+#include <iostream>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// longest wait for a readback when a recording stops
+	const GLuint64 g_FlushTimeout = 1000000000;
+
+	// tag of the pixel pack buffers in the resource table
+	const char* const g_ReadbackTag = "frame capture";
+}
+
+/***********************************************************
+ *  FrameCapture()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameCapture::FrameCapture()
+{
+	m_bCapturing = false;
+	m_format = FORMAT_IMAGE_SEQUENCE;
+	m_pVideoFile = NULL;
+	m_videoWidth = 0;
+	m_videoHeight = 0;
+
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		m_readbacks[i].bufferID = 0;
+		m_readbacks[i].bufferBytes = 0;
+		m_readbacks[i].fence = 0;
+		m_readbacks[i].width = 0;
+		m_readbacks[i].height = 0;
+		m_readbacks[i].frameNumber = 0;
+	}
+	m_firstReadback = 0;
+	m_readbackCount = 0;
+
+	for (int i = 0; i < QUEUE_SIZE; i++)
+	{
+		m_queue[i].width = 0;
+		m_queue[i].height = 0;
+		m_queue[i].frameNumber = 0;
+	}
+	m_firstQueued = 0;
+	m_queuedCount = 0;
+	m_bStopEncoder = false;
+
+	m_frameNumber = 0;
+	m_framesWritten = 0;
+	m_framesDropped = 0;
+}
+
+/***********************************************************
+ *  ~FrameCapture()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameCapture::~FrameCapture()
+{
+	Stop();
+
+	for (int i = 0; i < READBACK_COUNT; i++)
+	{
+		if (m_readbacks[i].bufferID != 0)
+		{
+			glDeleteBuffers(1, &m_readbacks[i].bufferID);
+			m_readbacks[i].bufferID = 0;
+			m_readbacks[i].bufferBytes = 0;
+		}
+	}
+	ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, g_ReadbackTag);
+}
+
+/***********************************************************
+ *  Start()
+ ***********************************************************/
+bool FrameCapture::Start(const std::string& pathPrefix, FORMAT format)
+{
+	if (m_bCapturing == true)
+		return true;
+
+	m_pathPrefix = pathPrefix;
+	m_format = format;
+	m_videoWidth = 0;
+	m_videoHeight = 0;
+	if (format == FORMAT_RAW_VIDEO)
+	{
+		std::string filename = pathPrefix + ".rgb";
+		m_pVideoFile = fopen(filename.c_str(), "wb");
+		if (m_pVideoFile == NULL)
+		{
+			std::cout << "ERROR: Could not open the capture file " << filename << std::endl;
+			return false;
+		}
+	}
+
+	m_frameNumber = 0;
+	m_framesWritten = 0;
+	m_framesDropped = 0;
+	m_firstQueued = 0;
+	m_queuedCount = 0;
+	m_bStopEncoder = false;
+	m_encoderThread = std::thread(&FrameCapture::EncodeFrames, this);
+	m_bCapturing = true;
+
+	std::cout << "INFO: Frame capture started to " << pathPrefix
+		<< ((format == FORMAT_RAW_VIDEO) ? ".rgb" : "_*.ppm") << std::endl;
+	return true;
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used to end a recording. The readbacks
+ *  still in flight are waited for, and the encoder writes
+ *  every queued frame before its thread ends.
+ ***********************************************************/
+void FrameCapture::Stop()
+{
+	if (m_bCapturing == false)
+		return;
+	m_bCapturing = false;
+
+	CollectReadbacks(true);
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_bStopEncoder = true;
+	}
+	m_queueChanged.notify_all();
+	m_encoderThread.join();
+
+	if (m_pVideoFile != NULL)
+	{
+		fclose(m_pVideoFile);
+		m_pVideoFile = NULL;
+	}
+
+	std::cout << "INFO: Frame capture stopped, " << m_framesWritten << " frames written, "
+		<< m_framesDropped << " dropped" << std::endl;
+	if ((m_format == FORMAT_RAW_VIDEO) && (m_videoWidth > 0))
+	{
+		std::cout << "INFO: Raw video is rgb24 at " << m_videoWidth << "x" << m_videoHeight
+			<< ", e.g. ffmpeg -f rawvideo -pixel_format rgb24 -video_size "
+			<< m_videoWidth << "x" << m_videoHeight << " -framerate 60 -i "
+			<< m_pathPrefix << ".rgb " << m_pathPrefix << ".mp4" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  CaptureFrame()
+ *
+ *  This method is used to start the readback of the frame
+ *  just drawn to the window. The copy into the buffer runs
+ *  on the GPU after the frame's draws; glReadPixels returns
+ *  as soon as it is queued because a pack buffer is bound.
+ ***********************************************************/
+void FrameCapture::CaptureFrame(int width, int height)
+{
+	if (m_bCapturing == false)
+		return;
+
+	CollectReadbacks(false);
+
+	if ((width <= 0) || (height <= 0))
+		return;
+
+	// every buffer is still being read back or waiting for
+	// the encoder, so this frame is skipped
+	if (m_readbackCount >= READBACK_COUNT)
+	{
+		m_framesDropped++;
+		m_frameNumber++;
+		return;
+	}
+
+	READBACK& readback = m_readbacks[(m_firstReadback + m_readbackCount) % READBACK_COUNT];
+	GLsizeiptr bytes = (GLsizeiptr)width * height * 4;
+	if (readback.bufferID == 0)
+	{
+		glGenBuffers(1, &readback.bufferID);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.bufferID);
+	if (readback.bufferBytes != bytes)
+	{
+		// reallocated only when the window size changes
+		glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+		readback.bufferBytes = bytes;
+		ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, g_ReadbackTag,
+			(unsigned long long)bytes * READBACK_COUNT, 0);
+	}
+
+	// BGRA matches the usual framebuffer layout, so the
+	// driver can copy without converting
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.width = width;
+	readback.height = height;
+	readback.frameNumber = m_frameNumber;
+	m_frameNumber++;
+	m_readbackCount++;
+}
+
+/***********************************************************
+ *  CollectReadbacks()
+ *
+ *  This method is used to move finished readbacks into the
+ *  encoder queue, oldest first. In a running recording a
+ *  readback whose fence has not signaled, or a full queue,
+ *  stops the collection until the next frame; when the
+ *  recording stops both are waited for instead.
+ ***********************************************************/
+void FrameCapture::CollectReadbacks(bool bFlush)
+{
+	while (m_readbackCount > 0)
+	{
+		READBACK& readback = m_readbacks[m_firstReadback];
+		GLuint64 timeout = (bFlush == true) ? g_FlushTimeout : 0;
+		GLenum result = glClientWaitSync(readback.fence,
+			(bFlush == true) ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+		if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+		{
+			if (bFlush == false)
+				break;
+
+			// the GPU never finished it, drop it
+			m_framesDropped++;
+			DropOldestReadback();
+			continue;
+		}
+
+		int slot = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			if (bFlush == true)
+			{
+				m_queueChanged.wait(lock, [this]() { return m_queuedCount < QUEUE_SIZE; });
+			}
+			else if (m_queuedCount >= QUEUE_SIZE)
+			{
+				break;
+			}
+			slot = (m_firstQueued + m_queuedCount) % QUEUE_SIZE;
+		}
+
+		// the slot is past the encoder's, so it is filled
+		// without holding the lock
+		QUEUED_FRAME& frame = m_queue[slot];
+		size_t bytes = (size_t)readback.width * readback.height * 4;
+		frame.pixels.resize(bytes);
+		frame.width = readback.width;
+		frame.height = readback.height;
+		frame.frameNumber = readback.frameNumber;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.bufferID);
+		const void* pMapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)bytes, GL_MAP_READ_BIT);
+		bool bMapped = (pMapped != NULL);
+		if (bMapped == true)
+		{
+			memcpy(frame.pixels.data(), pMapped, bytes);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		DropOldestReadback();
+
+		if (bMapped == false)
+		{
+			m_framesDropped++;
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_queuedCount++;
+		}
+		m_queueChanged.notify_all();
+	}
+}
+
+/***********************************************************
+ *  DropOldestReadback()
+ ***********************************************************/
+void FrameCapture::DropOldestReadback()
+{
+	glDeleteSync(m_readbacks[m_firstReadback].fence);
+	m_readbacks[m_firstReadback].fence = 0;
+	m_firstReadback = (m_firstReadback + 1) % READBACK_COUNT;
+	m_readbackCount--;
+}
+
+/***********************************************************
+ *  EncodeFrames()
+ *
+ *  This method is used as the encoder thread. It writes the
+ *  oldest queued frame with the lock released, so the
+ *  render thread can keep queueing, and ends once it was
+ *  told to stop and the queue is empty.
+ ***********************************************************/
+void FrameCapture::EncodeFrames()
+{
+	while (true)
+	{
+		int slot = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+			m_queueChanged.wait(lock, [this]() { return (m_queuedCount > 0) || m_bStopEncoder; });
+			if (m_queuedCount == 0)
+				break;
+			slot = m_firstQueued;
+		}
+
+		if (WriteFrame(m_queue[slot]) == true)
+			m_framesWritten++;
+		else
+			m_framesDropped++;
+
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_firstQueued = (m_firstQueued + 1) % QUEUE_SIZE;
+			m_queuedCount--;
+		}
+		m_queueChanged.notify_all();
+	}
+}
+
+/***********************************************************
+ *  WriteFrame()
+ *
+ *  This method is used to write a frame as top-down RGB,
+ *  the row order both outputs use. It writes through C
+ *  files and a row buffer kept between frames, so steady
+ *  recording does not allocate on the heap.
+ ***********************************************************/
+bool FrameCapture::WriteFrame(const QUEUED_FRAME& frame)
+{
+	FILE* pFile = m_pVideoFile;
+	if (m_format == FORMAT_RAW_VIDEO)
+	{
+		// a raw stream cannot change size part way through
+		if (m_videoWidth == 0)
+		{
+			m_videoWidth = frame.width;
+			m_videoHeight = frame.height;
+		}
+		if ((frame.width != m_videoWidth) || (frame.height != m_videoHeight))
+			return false;
+	}
+	else
+	{
+		char filename[512];
+		snprintf(filename, sizeof(filename), "%s_%06d.ppm", m_pathPrefix.c_str(), frame.frameNumber);
+		pFile = fopen(filename, "wb");
+		if (pFile == NULL)
+			return false;
+		fprintf(pFile, "P6\n%d %d\n255\n", frame.width, frame.height);
+	}
+
+	size_t rowBytes = (size_t)frame.width * 3;
+	if (m_rowBuffer.size() < rowBytes)
+	{
+		m_rowBuffer.resize(rowBytes);
+	}
+
+	bool bWritten = true;
+	for (int y = frame.height - 1; y >= 0; y--)
+	{
+		const unsigned char* pSource = frame.pixels.data() + (size_t)y * frame.width * 4;
+		unsigned char* pRow = m_rowBuffer.data();
+		for (int x = 0; x < frame.width; x++)
+		{
+			pRow[x * 3 + 0] = pSource[x * 4 + 2];
+			pRow[x * 3 + 1] = pSource[x * 4 + 1];
+			pRow[x * 3 + 2] = pSource[x * 4 + 0];
+		}
+		if (fwrite(pRow, 1, rowBytes, pFile) != rowBytes)
+		{
+			bWritten = false;
+			break;
+		}
+	}
+
+	if (m_format == FORMAT_IMAGE_SEQUENCE)
+	{
+		fclose(pFile);
+	}
+	return bWritten;
+}
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.h
+// ============
+// recording of rendered frames through asynchronous pixel buffer readback
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FrameCapture
+ *
+ *  This class records the frames shown in the window. Each
+ *  frame is read into one of a ring of pixel pack buffers,
+ *  which lets the copy run on the GPU while rendering goes
+ *  on, and a fence marks when it is done. The buffer is
+ *  mapped a few frames later, once its fence has signaled,
+ *  so the CPU never waits for the GPU. The pixels are then
+ *  copied to a frame queue, and an encoder thread writes
+ *  them out as numbered PPM images or one raw RGB video
+ *  file. When the ring or the queue is full the frame is
+ *  dropped rather than stalling the render loop.
+ ***********************************************************/
+class FrameCapture
+{
+public:
+	// constructor
+	FrameCapture();
+	// destructor
+	~FrameCapture();
+
+	enum FORMAT
+	{
+		FORMAT_IMAGE_SEQUENCE,
+		FORMAT_RAW_VIDEO
+	};
+
+	// start recording to files named after a path prefix,
+	// returning false if the output could not be opened
+	bool Start(const std::string& pathPrefix, FORMAT format);
+	// finish the frames in flight and close the output
+	void Stop();
+	bool IsCapturing() const { return m_bCapturing; }
+
+	// read back the window framebuffer after the frame has
+	// been drawn to it, and hand finished readbacks to the
+	// encoder
+	void CaptureFrame(int width, int height);
+
+private:
+	// pixel pack buffers in flight, so a readback is mapped
+	// this many frames after it was issued at the latest
+	static const int READBACK_COUNT = 3;
+	// frames the encoder can fall behind by
+	static const int QUEUE_SIZE = 8;
+
+	// a readback issued into a pixel pack buffer
+	struct READBACK
+	{
+		GLuint bufferID;
+		GLsizeiptr bufferBytes;
+		GLsync fence;
+		int width;
+		int height;
+		int frameNumber;
+	};
+
+	// a frame waiting for the encoder, as BGRA rows from the
+	// bottom of the image up
+	struct QUEUED_FRAME
+	{
+		std::vector<unsigned char> pixels;
+		int width;
+		int height;
+		int frameNumber;
+	};
+
+	bool m_bCapturing;
+	FORMAT m_format;
+	std::string m_pathPrefix;
+	// raw video file and the frame size it was started with
+	FILE* m_pVideoFile;
+	int m_videoWidth;
+	int m_videoHeight;
+
+	// readbacks in a fixed ring, oldest first
+	READBACK m_readbacks[READBACK_COUNT];
+	int m_firstReadback;
+	int m_readbackCount;
+
+	// frames in a fixed ring shared with the encoder, which
+	// only touches the oldest one and the producer only the
+	// slots after the last
+	QUEUED_FRAME m_queue[QUEUE_SIZE];
+	int m_firstQueued;
+	int m_queuedCount;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueChanged;
+	bool m_bStopEncoder;
+	std::thread m_encoderThread;
+	// RGB row written by the encoder thread
+	std::vector<unsigned char> m_rowBuffer;
+
+	// frame statistics of the current recording, counting
+	// dropped frames in the numbers
+	int m_frameNumber;
+	int m_framesWritten;
+	int m_framesDropped;
+
+	// map the readbacks the GPU has finished and queue them,
+	// waiting for the GPU and the encoder only when flushing
+	void CollectReadbacks(bool bFlush);
+	// delete the fence of the oldest readback and drop it
+	void DropOldestReadback();
+	// body of the encoder thread
+	void EncodeFrames();
+	// write one frame to the output, on the encoder thread
+	bool WriteFrame(const QUEUED_FRAME& frame);
+};
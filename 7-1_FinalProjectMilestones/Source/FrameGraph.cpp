@@ -0,0 +1,943 @@
+///////////////////////////////////////////////////////////////////////////////
+// framegraph.cpp
+// ============
+// render passes ordered and culled by the targets they read and write, and
+// the scene passes run from them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameGraph.h"
+#include "ResourceAccounting.h"
+#include "DepthPrePass.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// tag of the shared transient textures in the resource table
+	const char* const g_TargetTag = "frame graph targets";
+	// tag of the indirect command buffer in the resource table
+	const char* const g_IndirectTag = "indirect draws";
+}
+
+/***********************************************************
+ *  FrameGraph()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameGraph::FrameGraph()
+{
+	m_targetCount = 0;
+	m_passCount = 0;
+	m_physicalTargetCount = 0;
+	m_executedCount = 0;
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  ~FrameGraph()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameGraph::~FrameGraph()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void FrameGraph::Destroy()
+{
+	for (int i = 0; i < m_physicalTargetCount; i++)
+	{
+		if (m_physicalTargets[i].textureID != 0)
+		{
+			glDeleteTextures(1, &m_physicalTargets[i].textureID);
+			m_physicalTargets[i].textureID = 0;
+		}
+	}
+	m_physicalTargetCount = 0;
+	for (int i = 0; i < m_targetCount; i++)
+	{
+		m_targets[i].physicalTarget = -1;
+	}
+	m_bDirty = true;
+	ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_RENDER_TARGET, g_TargetTag);
+}
+
+/***********************************************************
+ *  AddImportedTarget()
+ ***********************************************************/
+int FrameGraph::AddImportedTarget(const char* name)
+{
+	int target = AddTransientTarget(name, GL_NONE, 1.0f);
+	if (target >= 0)
+	{
+		m_targets[target].bImported = true;
+	}
+	return(target);
+}
+
+/***********************************************************
+ *  AddTransientTarget()
+ ***********************************************************/
+int FrameGraph::AddTransientTarget(const char* name, GLenum internalFormat, float scale)
+{
+	if (m_targetCount >= MAX_TARGETS)
+	{
+		std::cout << "ERROR: Too many frame graph targets: " << name << std::endl;
+		return -1;
+	}
+
+	TARGET& target = m_targets[m_targetCount];
+	target.name = name;
+	target.bImported = false;
+	target.bOutput = false;
+	target.internalFormat = internalFormat;
+	target.scale = scale;
+	target.firstWriter = -1;
+	target.physicalTarget = -1;
+	m_bDirty = true;
+
+	return(m_targetCount++);
+}
+
+/***********************************************************
+ *  AddPass()
+ ***********************************************************/
+int FrameGraph::AddPass(const char* name)
+{
+	if (m_passCount >= MAX_PASSES)
+	{
+		std::cout << "ERROR: Too many frame graph passes: " << name << std::endl;
+		return -1;
+	}
+
+	PASS& pass = m_passes[m_passCount];
+	pass.name = name;
+	pass.bEnabled = true;
+	pass.reads = 0;
+	pass.writes = 0;
+	m_bDirty = true;
+
+	return(m_passCount++);
+}
+
+/***********************************************************
+ *  Read()
+ ***********************************************************/
+void FrameGraph::Read(int pass, int target)
+{
+	if ((pass < 0) || (pass >= m_passCount) || (target < 0) || (target >= m_targetCount))
+		return;
+
+	m_passes[pass].reads |= (1u << target);
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  Write()
+ ***********************************************************/
+void FrameGraph::Write(int pass, int target)
+{
+	if ((pass < 0) || (pass >= m_passCount) || (target < 0) || (target >= m_targetCount))
+		return;
+
+	m_passes[pass].writes |= (1u << target);
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  SetPassEnabled()
+ ***********************************************************/
+void FrameGraph::SetPassEnabled(int pass, bool bEnabled)
+{
+	if ((pass < 0) || (pass >= m_passCount) || (m_passes[pass].bEnabled == bEnabled))
+		return;
+
+	m_passes[pass].bEnabled = bEnabled;
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  SetOutput()
+ ***********************************************************/
+void FrameGraph::SetOutput(int target, bool bOutput)
+{
+	if ((target < 0) || (target >= m_targetCount) || (m_targets[target].bOutput == bOutput))
+		return;
+
+	m_targets[target].bOutput = bOutput;
+	m_bDirty = true;
+}
+
+/***********************************************************
+ *  Compile()
+ ***********************************************************/
+void FrameGraph::Compile()
+{
+	if (m_bDirty == false)
+		return;
+	m_bDirty = false;
+
+	unsigned int keptPasses = CullPasses();
+	if (OrderPasses(keptPasses) == false)
+	{
+		// a cycle cannot be ordered, so fall back to the
+		// order the passes were added in
+		std::cout << "ERROR: Frame graph passes depend on each other in a cycle" << std::endl;
+		m_executedCount = 0;
+		for (int pass = 0; pass < m_passCount; pass++)
+		{
+			if ((keptPasses & (1u << pass)) != 0)
+				m_executed[m_executedCount++] = pass;
+		}
+	}
+
+	for (int target = 0; target < m_targetCount; target++)
+	{
+		m_targets[target].firstWriter = -1;
+		for (int i = 0; i < m_executedCount; i++)
+		{
+			if ((m_passes[m_executed[i]].writes & (1u << target)) != 0)
+			{
+				m_targets[target].firstWriter = m_executed[i];
+				break;
+			}
+		}
+	}
+
+	AliasTargets();
+
+	std::cout << "INFO: Frame graph runs";
+	for (int i = 0; i < m_executedCount; i++)
+	{
+		std::cout << ((i == 0) ? " " : ", ") << m_passes[m_executed[i]].name;
+	}
+	std::cout << " (" << m_executedCount << " of " << m_passCount << " passes)" << std::endl;
+}
+
+/***********************************************************
+ *  CullPasses()
+ *
+ *  This method is used to find the passes that contribute
+ *  to an output. The passes writing an output are kept,
+ *  then every pass writing a target a kept pass reads,
+ *  until no more are added.
+ ***********************************************************/
+unsigned int FrameGraph::CullPasses() const
+{
+	unsigned int neededTargets = 0;
+	for (int target = 0; target < m_targetCount; target++)
+	{
+		if (m_targets[target].bOutput == true)
+			neededTargets |= (1u << target);
+	}
+
+	unsigned int keptPasses = 0;
+	bool bChanged = true;
+	while (bChanged == true)
+	{
+		bChanged = false;
+		for (int pass = 0; pass < m_passCount; pass++)
+		{
+			const PASS& candidate = m_passes[pass];
+			if ((candidate.bEnabled == false) || ((keptPasses & (1u << pass)) != 0))
+				continue;
+			if ((candidate.writes & neededTargets) == 0)
+				continue;
+
+			keptPasses |= (1u << pass);
+			neededTargets |= candidate.reads;
+			bChanged = true;
+		}
+	}
+
+	return(keptPasses);
+}
+
+/***********************************************************
+ *  OrderPasses()
+ *
+ *  This method is used to sort the kept passes by their
+ *  dependencies. A pass that only reads a target runs after
+ *  every pass writing it, and passes writing the same
+ *  target, including those that also read it, run in the
+ *  order they were added. Among the passes that are ready,
+ *  the one added first goes next.
+ ***********************************************************/
+bool FrameGraph::OrderPasses(unsigned int keptPasses)
+{
+	unsigned int predecessors[MAX_PASSES];
+	for (int pass = 0; pass < m_passCount; pass++)
+	{
+		predecessors[pass] = 0;
+		if ((keptPasses & (1u << pass)) == 0)
+			continue;
+
+		const PASS& current = m_passes[pass];
+		for (int other = 0; other < m_passCount; other++)
+		{
+			if ((other == pass) || ((keptPasses & (1u << other)) == 0))
+				continue;
+
+			unsigned int otherWrites = m_passes[other].writes;
+			unsigned int readOnly = current.reads & ~current.writes;
+			if ((otherWrites & readOnly) != 0)
+				predecessors[pass] |= (1u << other);
+			if ((other < pass) && ((otherWrites & current.writes) != 0))
+				predecessors[pass] |= (1u << other);
+		}
+	}
+
+	m_executedCount = 0;
+	unsigned int done = 0;
+	while (done != keptPasses)
+	{
+		int next = -1;
+		for (int pass = 0; pass < m_passCount; pass++)
+		{
+			if (((keptPasses & ~done) & (1u << pass)) == 0)
+				continue;
+			if ((predecessors[pass] & ~done) == 0)
+			{
+				next = pass;
+				break;
+			}
+		}
+		if (next < 0)
+			return false;
+
+		m_executed[m_executedCount++] = next;
+		done |= (1u << next);
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  AliasTargets()
+ *
+ *  This method is used to place the transient targets in
+ *  shared textures. Going through the targets in the order
+ *  they are first used, each takes a texture of the same
+ *  format and scale whose earlier targets are no longer
+ *  used, and only gets a new one when all are busy. The
+ *  textures keep their GL objects between compiles.
+ ***********************************************************/
+void FrameGraph::AliasTargets()
+{
+	int firstUse[MAX_TARGETS];
+	int lastUse[MAX_TARGETS];
+	for (int target = 0; target < m_targetCount; target++)
+	{
+		firstUse[target] = -1;
+		lastUse[target] = -1;
+		m_targets[target].physicalTarget = -1;
+		for (int i = 0; i < m_executedCount; i++)
+		{
+			const PASS& pass = m_passes[m_executed[i]];
+			if (((pass.reads | pass.writes) & (1u << target)) == 0)
+				continue;
+			if (firstUse[target] < 0)
+				firstUse[target] = i;
+			lastUse[target] = i;
+		}
+	}
+
+	for (int i = 0; i < m_physicalTargetCount; i++)
+	{
+		m_physicalTargets[i].lastUse = -1;
+	}
+	bool bUsed[MAX_TARGETS] = {};
+
+	for (int i = 0; i < m_executedCount; i++)
+	{
+		for (int target = 0; target < m_targetCount; target++)
+		{
+			TARGET& current = m_targets[target];
+			if ((current.bImported == true) || (firstUse[target] != i))
+				continue;
+
+			// a texture of the same kind that is free by now,
+			// or one no target has taken this compile
+			int physical = -1;
+			for (int p = 0; (p < m_physicalTargetCount) && (physical < 0); p++)
+			{
+				const PHYSICAL_TARGET& candidate = m_physicalTargets[p];
+				if ((candidate.internalFormat == current.internalFormat) &&
+					(candidate.scale == current.scale) &&
+					(candidate.lastUse < i))
+					physical = p;
+			}
+			for (int p = 0; (p < m_physicalTargetCount) && (physical < 0); p++)
+			{
+				if (bUsed[p] == false)
+				{
+					physical = p;
+					if (m_physicalTargets[p].textureID != 0)
+					{
+						glDeleteTextures(1, &m_physicalTargets[p].textureID);
+						m_physicalTargets[p].textureID = 0;
+					}
+				}
+			}
+			if (physical < 0)
+			{
+				physical = m_physicalTargetCount++;
+				m_physicalTargets[physical].internalFormat = GL_NONE;
+				m_physicalTargets[physical].scale = 0.0f;
+				m_physicalTargets[physical].textureID = 0;
+				m_physicalTargets[physical].width = 0;
+				m_physicalTargets[physical].height = 0;
+			}
+
+			PHYSICAL_TARGET& shared = m_physicalTargets[physical];
+			if ((shared.internalFormat != current.internalFormat) || (shared.scale != current.scale))
+			{
+				if (shared.textureID != 0)
+				{
+					glDeleteTextures(1, &shared.textureID);
+					shared.textureID = 0;
+				}
+				shared.internalFormat = current.internalFormat;
+				shared.scale = current.scale;
+				shared.width = 0;
+				shared.height = 0;
+			}
+			shared.lastUse = lastUse[target];
+			bUsed[physical] = true;
+			current.physicalTarget = physical;
+		}
+	}
+
+	// textures no target needs any more are freed
+	for (int p = 0; p < m_physicalTargetCount; p++)
+	{
+		if ((bUsed[p] == false) && (m_physicalTargets[p].textureID != 0))
+		{
+			glDeleteTextures(1, &m_physicalTargets[p].textureID);
+			m_physicalTargets[p].textureID = 0;
+		}
+	}
+	TrackTargetMemory();
+}
+
+/***********************************************************
+ *  IsPassExecuted()
+ ***********************************************************/
+bool FrameGraph::IsPassExecuted(int pass) const
+{
+	for (int i = 0; i < m_executedCount; i++)
+	{
+		if (m_executed[i] == pass)
+			return true;
+	}
+	return false;
+}
+
+/***********************************************************
+ *  IsFirstWrite()
+ ***********************************************************/
+bool FrameGraph::IsFirstWrite(int pass, int target) const
+{
+	if ((target < 0) || (target >= m_targetCount))
+		return false;
+
+	return (m_targets[target].firstWriter == pass);
+}
+
+/***********************************************************
+ *  GetTexture()
+ ***********************************************************/
+GLuint FrameGraph::GetTexture(int target, int width, int height)
+{
+	if ((target < 0) || (target >= m_targetCount) || (m_targets[target].physicalTarget < 0))
+		return 0;
+
+	PHYSICAL_TARGET& shared = m_physicalTargets[m_targets[target].physicalTarget];
+	int targetWidth = (int)(width * shared.scale + 0.5f);
+	int targetHeight = (int)(height * shared.scale + 0.5f);
+	if (targetWidth < 1)
+		targetWidth = 1;
+	if (targetHeight < 1)
+		targetHeight = 1;
+
+	if ((shared.textureID == 0) || (shared.width != targetWidth) || (shared.height != targetHeight))
+	{
+		if (shared.textureID == 0)
+		{
+			glGenTextures(1, &shared.textureID);
+		}
+		bool bDepth = (shared.internalFormat == GL_DEPTH_COMPONENT24) ||
+			(shared.internalFormat == GL_DEPTH_COMPONENT32F) ||
+			(shared.internalFormat == GL_DEPTH24_STENCIL8);
+		GLenum format = GL_RGBA;
+		if (shared.internalFormat == GL_DEPTH24_STENCIL8)
+			format = GL_DEPTH_STENCIL;
+		else if (bDepth == true)
+			format = GL_DEPTH_COMPONENT;
+		GLenum type = (shared.internalFormat == GL_DEPTH24_STENCIL8) ? GL_UNSIGNED_INT_24_8 : GL_FLOAT;
+
+		glBindTexture(GL_TEXTURE_2D, shared.textureID);
+		glTexImage2D(GL_TEXTURE_2D, 0, shared.internalFormat, targetWidth, targetHeight, 0, format, type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		shared.width = targetWidth;
+		shared.height = targetHeight;
+		TrackTargetMemory();
+	}
+
+	return(shared.textureID);
+}
+
+/***********************************************************
+ *  GetTexelBytes()
+ ***********************************************************/
+int FrameGraph::GetTexelBytes(GLenum internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_RGBA16F:
+		return 8;
+	case GL_RGBA32F:
+		return 16;
+	default:
+		// RGBA8, R11F_G11F_B10F and the 32 bit depth formats
+		return 4;
+	}
+}
+
+/***********************************************************
+ *  TrackTargetMemory()
+ ***********************************************************/
+void FrameGraph::TrackTargetMemory() const
+{
+	unsigned long long bytes = 0;
+	for (int p = 0; p < m_physicalTargetCount; p++)
+	{
+		const PHYSICAL_TARGET& shared = m_physicalTargets[p];
+		if (shared.textureID != 0)
+		{
+			bytes += (unsigned long long)shared.width * shared.height *
+				GetTexelBytes(shared.internalFormat);
+		}
+	}
+
+	if (bytes > 0)
+		ResourceAccounting::Track(ResourceAccounting::CATEGORY_RENDER_TARGET, g_TargetTag, bytes, 0);
+	else
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_RENDER_TARGET, g_TargetTag);
+}
+
+/***********************************************************
+ *  FramePasses()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FramePasses::FramePasses(DRAW_SOURCE* pSource, DepthPrePass* pDepthPrePass, SceneGeometry* pSceneGeometry)
+{
+	m_pSource = pSource;
+	m_pDepthPrePass = pDepthPrePass;
+	m_pSceneGeometry = pSceneGeometry;
+	m_litOpaqueEnd = 0;
+	m_opaqueEnd = 0;
+	m_indirectBufferID = 0;
+	m_indirectBufferBytes = 0;
+}
+
+/***********************************************************
+ *  ~FramePasses()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FramePasses::~FramePasses()
+{
+	Destroy();
+	m_pSource = NULL;
+	m_pDepthPrePass = NULL;
+	m_pSceneGeometry = NULL;
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void FramePasses::Destroy()
+{
+	if (m_indirectBufferID != 0)
+	{
+		glDeleteBuffers(1, &m_indirectBufferID);
+		m_indirectBufferID = 0;
+		m_indirectBufferBytes = 0;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, g_IndirectTag);
+	}
+	m_frameGraph.Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to declare the passes of the frame
+ *  and the targets each reads and writes. The passes are
+ *  added in FRAME_PASS order, so a pass index is its enum
+ *  value, and the targets in FRAME_TARGET order. All of
+ *  them draw into the frame's framebuffer, which is cleared
+ *  before the scene is rendered, so no pass clears it.
+ ***********************************************************/
+void FramePasses::Initialize()
+{
+	m_frameGraph.AddImportedTarget("scene color");
+	m_frameGraph.AddImportedTarget("scene depth");
+	m_frameGraph.AddImportedTarget("occlusion results");
+	m_frameGraph.SetOutput(TARGET_COLOR, true);
+
+	m_frameGraph.AddPass("depth pre-pass");
+	m_frameGraph.Write(PASS_DEPTH_PREPASS, TARGET_DEPTH);
+
+	m_frameGraph.AddPass("overdraw view");
+	m_frameGraph.Write(PASS_OVERDRAW, TARGET_COLOR);
+
+	// the pre-pass depth, when there is one, is read and
+	// then written by the opaque surfaces
+	m_frameGraph.AddPass("opaque");
+	m_frameGraph.Read(PASS_OPAQUE, TARGET_DEPTH);
+	m_frameGraph.Write(PASS_OPAQUE, TARGET_COLOR);
+	m_frameGraph.Write(PASS_OPAQUE, TARGET_DEPTH);
+
+	m_frameGraph.AddPass("unlit");
+	m_frameGraph.Read(PASS_UNLIT, TARGET_DEPTH);
+	m_frameGraph.Write(PASS_UNLIT, TARGET_COLOR);
+	m_frameGraph.Write(PASS_UNLIT, TARGET_DEPTH);
+
+	// the billboards and translucent draws are tested against
+	// the finished opaque depth
+	m_frameGraph.AddPass("impostors");
+	m_frameGraph.Read(PASS_IMPOSTORS, TARGET_DEPTH);
+	m_frameGraph.Write(PASS_IMPOSTORS, TARGET_COLOR);
+
+	m_frameGraph.AddPass("blended");
+	m_frameGraph.Read(PASS_BLENDED, TARGET_DEPTH);
+	m_frameGraph.Write(PASS_BLENDED, TARGET_COLOR);
+
+	m_frameGraph.AddPass("occlusion queries");
+	m_frameGraph.Read(PASS_OCCLUSION, TARGET_DEPTH);
+	m_frameGraph.Write(PASS_OCCLUSION, TARGET_OCCLUSION);
+
+	if (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+	{
+		glGenBuffers(1, &m_indirectBufferID);
+	}
+}
+
+/***********************************************************
+ *  SetPassEnabled()
+ ***********************************************************/
+void FramePasses::SetPassEnabled(FRAME_PASS pass, bool bEnabled)
+{
+	m_frameGraph.SetPassEnabled(pass, bEnabled);
+}
+
+/***********************************************************
+ *  SetOutput()
+ ***********************************************************/
+void FramePasses::SetOutput(FRAME_TARGET target, bool bOutput)
+{
+	m_frameGraph.SetOutput(target, bOutput);
+}
+
+/***********************************************************
+ *  Execute()
+ *
+ *  This method is used to compile the frame graph and run
+ *  the passes it keeps, in its order. While the overdraw is
+ *  reported, the samples the shading passes write are
+ *  counted as the shaded fragments; in the overdraw view
+ *  that is every layer it draws.
+ ***********************************************************/
+void FramePasses::Execute(int litOpaqueEnd, int opaqueEnd, int viewportWidth, int viewportHeight)
+{
+	m_litOpaqueEnd = litOpaqueEnd;
+	m_opaqueEnd = opaqueEnd;
+	m_frameGraph.Compile();
+
+	bool bShadingQuery = false;
+	for (int i = 0; i < m_frameGraph.GetExecutedCount(); i++)
+	{
+		int pass = m_frameGraph.GetExecutedPass(i);
+		bool bShadingPass = (m_pDepthPrePass->IsReportEnabled() == true) &&
+			((pass == PASS_OVERDRAW) || (pass == PASS_OPAQUE) || (pass == PASS_UNLIT) ||
+			(pass == PASS_IMPOSTORS) || (pass == PASS_BLENDED));
+		if ((bShadingPass == true) && (bShadingQuery == false))
+		{
+			m_pDepthPrePass->BeginShadingQuery();
+			bShadingQuery = true;
+		}
+		else if ((bShadingPass == false) && (bShadingQuery == true))
+		{
+			m_pDepthPrePass->EndShadingQuery(viewportWidth, viewportHeight);
+			bShadingQuery = false;
+		}
+		ExecutePass((FRAME_PASS)pass);
+	}
+	if (bShadingQuery == true)
+	{
+		m_pDepthPrePass->EndShadingQuery(viewportWidth, viewportHeight);
+	}
+}
+
+/***********************************************************
+ *  ExecutePass()
+ *
+ *  This method is used to run one pass of the compiled
+ *  frame graph. Each pass sets up and restores its own
+ *  depth and program state, so any order the graph picks
+ *  works.
+ ***********************************************************/
+void FramePasses::ExecutePass(FRAME_PASS pass)
+{
+	bool bDepthPrePass = m_frameGraph.IsPassExecuted(PASS_DEPTH_PREPASS);
+
+	switch (pass)
+	{
+	case PASS_DEPTH_PREPASS:
+		// nearest surfaces first, so later draws fail early z
+		m_pSource->SortDrawOrder(0, m_litOpaqueEnd, SORT_FRONT_TO_BACK);
+		m_pSource->SortDrawOrder(m_litOpaqueEnd, m_opaqueEnd, SORT_FRONT_TO_BACK);
+
+		m_pDepthPrePass->BeginDepthPass(m_pSource->GetViewMatrix(), m_pSource->GetProjectionMatrix());
+		for (int i = 0; i < m_opaqueEnd; i++)
+		{
+			int draw = m_pSource->GetOrderedDraw(i);
+			m_pSource->BeginObjectDraw(draw);
+			m_pDepthPrePass->SetModel(m_pSource->GetDrawModel(draw));
+			m_pSource->DrawRecordedMesh(draw);
+		}
+		m_pSource->EndObjectDraw();
+		m_pDepthPrePass->EndDepthPass();
+		m_pSource->RestoreSceneProgram();
+		break;
+
+	case PASS_OVERDRAW:
+		// layer counts instead of the lit scene
+		m_pDepthPrePass->BeginOverdrawView(m_pSource->GetViewMatrix(), m_pSource->GetProjectionMatrix());
+		for (int i = 0; i < m_pSource->GetDrawOrderSize(); i++)
+		{
+			int draw = m_pSource->GetOrderedDraw(i);
+			m_pSource->BeginObjectDraw(draw);
+			m_pDepthPrePass->SetModel(m_pSource->GetDrawModel(draw));
+			m_pSource->DrawRecordedMesh(draw);
+		}
+		m_pSource->EndObjectDraw();
+		m_pDepthPrePass->EndOverdrawView();
+		m_pSource->RestoreSceneProgram();
+		break;
+
+	case PASS_OPAQUE:
+	case PASS_UNLIT:
+	{
+		int begin = (pass == PASS_OPAQUE) ? 0 : m_litOpaqueEnd;
+		int end = (pass == PASS_OPAQUE) ? m_litOpaqueEnd : m_opaqueEnd;
+		if (bDepthPrePass == true)
+		{
+			// shading order no longer affects overdraw, so
+			// group draws by program, texture and material
+			m_pSource->SortDrawOrder(begin, end, SORT_SHADER_STATE);
+			m_pDepthPrePass->BeginLightingPass();
+		}
+		else if (m_pSource->IsShaderPermutationsEnabled() == true)
+		{
+			// bucket draws by permutation, keeping the
+			// authoring order inside each bucket, and by
+			// texture too when each run becomes one multi-draw
+			m_pSource->SortDrawOrder(begin, end,
+				(m_pSource->IsMultiDrawActive() == true) ? SORT_PERMUTATION_TEXTURE : SORT_PERMUTATION);
+		}
+		SubmitPassDraws(begin, end);
+		if (bDepthPrePass == true)
+		{
+			m_pDepthPrePass->EndLightingPass();
+		}
+		break;
+	}
+
+	case PASS_IMPOSTORS:
+	{
+		int viewPasses = GetViewPassCount();
+		for (int view = 0; view < viewPasses; view++)
+		{
+			if (viewPasses > 1)
+				m_pSource->SelectView(view);
+			m_pSource->DrawImpostors();
+		}
+		if (viewPasses > 1)
+			m_pSource->SelectView(0);
+		break;
+	}
+
+	case PASS_BLENDED:
+		SubmitPassDraws(m_opaqueEnd, m_pSource->GetDrawOrderSize());
+		break;
+
+	case PASS_OCCLUSION:
+		m_pSource->IssueOcclusionQueries();
+		break;
+
+	default:
+		break;
+	}
+}
+
+/***********************************************************
+ *  GetViewPassCount()
+ *
+ *  This method is used to get how many times a pass has to
+ *  be submitted, once for each view unless every view is
+ *  drawn by one instanced pass.
+ ***********************************************************/
+int FramePasses::GetViewPassCount() const
+{
+	int viewCount = m_pSource->GetViewCount();
+	return ((viewCount == 1) || (m_pSource->IsSinglePassViews() == true)) ? 1 : viewCount;
+}
+
+/***********************************************************
+ *  SubmitPassDraws()
+ *
+ *  This method is used to submit a range of the sorted draw
+ *  order with the lighting programs, to every view.
+ ***********************************************************/
+void FramePasses::SubmitPassDraws(int begin, int end)
+{
+	if (begin >= end)
+		return;
+
+	int viewPasses = GetViewPassCount();
+	for (int view = 0; view < viewPasses; view++)
+	{
+		if (viewPasses > 1)
+			m_pSource->SelectView(view);
+
+		if (m_pSource->IsMultiDrawActive() == true)
+		{
+			SubmitMultiDraw(begin, end);
+			continue;
+		}
+
+		for (int i = begin; i < end; i++)
+		{
+			int draw = m_pSource->GetOrderedDraw(i);
+			m_pSource->BeginObjectDraw(draw);
+			m_pSource->ApplyDrawState(draw);
+			m_pSource->DrawRecordedMesh(draw);
+		}
+		m_pSource->EndObjectDraw();
+	}
+	if (viewPasses > 1)
+		m_pSource->SelectView(0);
+}
+
+/***********************************************************
+ *  SubmitMultiDraw()
+ *
+ *  This method is used to draw a range of the draw order
+ *  from the shared geometry. Each draw becomes an indirect
+ *  command whose base instance selects its per-draw data,
+ *  and each run of draws with the same program and texture
+ *  is submitted with a single multi-draw call. The number of calls
+ *  depends on the programs and textures in use, not on the
+ *  number of objects.
+ ***********************************************************/
+void FramePasses::SubmitMultiDraw(int begin, int end)
+{
+	m_indirectCommands.clear();
+	m_multiDrawBatches.clear();
+
+	bool bSinglePassViews = m_pSource->IsSinglePassViews();
+	int viewCount = m_pSource->GetViewCount();
+	int batchKey = -1;
+	int batchTexture = -1;
+	BATCH_DRAW batchDraw;
+	for (int i = begin; i < end; i++)
+	{
+		int draw = m_pSource->GetOrderedDraw(i);
+
+		// draws without a per-draw data slot go the regular way
+		if (m_pSource->GetBatchDraw(draw, batchDraw) == false)
+		{
+			MULTI_DRAW_BATCH batch = { draw, 0, 0 };
+			m_multiDrawBatches.push_back(batch);
+			batchKey = -1;
+			continue;
+		}
+
+		if ((batchDraw.permutationKey != batchKey) || (batchDraw.textureUnit != batchTexture))
+		{
+			MULTI_DRAW_BATCH batch = { draw, (int)m_indirectCommands.size(), 0 };
+			m_multiDrawBatches.push_back(batch);
+			batchKey = batchDraw.permutationKey;
+			batchTexture = batchDraw.textureUnit;
+		}
+
+		const SceneGeometry::MESH_RANGE& range = m_pSceneGeometry->GetRange(batchDraw.mesh);
+		DRAW_ELEMENTS_INDIRECT_COMMAND indirect;
+		indirect.count = range.indexCount;
+		indirect.instanceCount = bSinglePassViews ? (GLuint)viewCount : 1;
+		indirect.firstIndex = range.firstIndex;
+		indirect.baseVertex = range.baseVertex;
+		indirect.baseInstance = (GLuint)batchDraw.drawDataIndex;
+		m_indirectCommands.push_back(indirect);
+		m_multiDrawBatches.back().drawCount++;
+	}
+
+	if (m_multiDrawBatches.empty())
+		return;
+
+	// one upload for the whole range, orphaning its last use
+	GLsizeiptr indirectBytes = sizeof(DRAW_ELEMENTS_INDIRECT_COMMAND) * m_indirectCommands.size();
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBufferID);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, indirectBytes,
+		m_indirectCommands.data(), GL_STREAM_DRAW);
+	if (indirectBytes > m_indirectBufferBytes)
+	{
+		m_indirectBufferBytes = indirectBytes;
+		ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, g_IndirectTag,
+			(unsigned long long)indirectBytes, 0);
+	}
+
+	for (const MULTI_DRAW_BATCH& batch : m_multiDrawBatches)
+	{
+		m_pSource->ApplyDrawState(batch.draw);
+		if (batch.drawCount == 0)
+		{
+			m_pSource->DrawRecordedMesh(batch.draw);
+
+			// a regular draw reaches one view at a time
+			if (bSinglePassViews == true)
+			{
+				for (int view = 1; view < viewCount; view++)
+				{
+					m_pSource->SelectView(view);
+					m_pSource->DrawRecordedMesh(batch.draw);
+				}
+				m_pSource->SelectView(0);
+			}
+			continue;
+		}
+
+		m_pSceneGeometry->Bind();
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+			(const void*)(sizeof(DRAW_ELEMENTS_INDIRECT_COMMAND) * batch.firstIndirect),
+			batch.drawCount, 0);
+		glBindVertexArray(0);
+	}
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,337 @@
+///////////////////////////////////////////////////////////////////////////////
+// framegraph.h
+// ============
+// render passes ordered and culled by the targets they read and write, and
+// the scene passes run from them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include "SceneGeometry.h"
+
+#include <vector>
+
+class DepthPrePass;
+
+/***********************************************************
+ *  FrameGraph
+ *
+ *  This class holds the passes of a frame and the targets
+ *  each one reads and writes. Targets are either imported,
+ *  like the framebuffer the frame is drawn into, or
+ *  transient, living only between their first and last use
+ *  in a frame. Compiling the graph:
+ *
+ *  - culls passes whose writes nothing needs, starting
+ *    from the targets marked as frame outputs
+ *  - orders the remaining passes so every reader runs after
+ *    all writers of a target; passes writing the same target
+ *    keep the order they were added in
+ *  - notes the first pass writing each transient target,
+ *    which is the only one that has to clear it
+ *  - lets transient targets whose uses do not overlap share
+ *    one texture, so a new pass only adds target memory
+ *    when its targets are alive at the same time as others
+ *
+ *  Passes and targets live in fixed tables and the graph is
+ *  only compiled again after it changed, so running it
+ *  every frame does not allocate.
+ ***********************************************************/
+class FrameGraph
+{
+public:
+	// constructor
+	FrameGraph();
+	// destructor
+	~FrameGraph();
+
+	static const int MAX_PASSES = 16;
+	static const int MAX_TARGETS = 16;
+
+	// add a target owned outside the graph
+	int AddImportedTarget(const char* name);
+	// add a target the graph allocates, at a scale of the
+	// size given to GetTexture()
+	int AddTransientTarget(const char* name, GLenum internalFormat, float scale);
+	// add a pass, returning its index in the order added
+	int AddPass(const char* name);
+	// declare what a pass reads and writes
+	void Read(int pass, int target);
+	void Write(int pass, int target);
+
+	// include or leave out a pass for the following frames
+	void SetPassEnabled(int pass, bool bEnabled);
+	// mark a target as needed after the frame, which keeps
+	// the passes writing it
+	void SetOutput(int target, bool bOutput);
+
+	// cull and order the passes and place the transient
+	// targets, if anything changed since the last compile
+	void Compile();
+
+	// passes to run this frame, in order
+	int GetExecutedCount() const { return m_executedCount; }
+	int GetExecutedPass(int index) const { return m_executed[index]; }
+	bool IsPassExecuted(int pass) const;
+	// whether a pass is the first this frame to write a
+	// target, and so has to clear it
+	bool IsFirstWrite(int pass, int target) const;
+	// texture of a transient target for a frame of the given
+	// size, created or resized when needed
+	GLuint GetTexture(int target, int width, int height);
+
+	// free the transient textures
+	void Destroy();
+
+private:
+	struct TARGET
+	{
+		const char* name;
+		bool bImported;
+		bool bOutput;
+		GLenum internalFormat;
+		float scale;
+		// first pass writing it, and the texture it shares
+		// with other transient targets
+		int firstWriter;
+		int physicalTarget;
+	};
+
+	struct PASS
+	{
+		const char* name;
+		bool bEnabled;
+		// targets as bit masks, one bit per target index
+		unsigned int reads;
+		unsigned int writes;
+	};
+
+	// a texture shared by transient targets
+	struct PHYSICAL_TARGET
+	{
+		GLenum internalFormat;
+		float scale;
+		// executed pass index of the last use by the targets
+		// placed in it so far, while compiling
+		int lastUse;
+		GLuint textureID;
+		int width;
+		int height;
+	};
+
+	TARGET m_targets[MAX_TARGETS];
+	int m_targetCount;
+	PASS m_passes[MAX_PASSES];
+	int m_passCount;
+	PHYSICAL_TARGET m_physicalTargets[MAX_TARGETS];
+	int m_physicalTargetCount;
+
+	// compiled pass order
+	int m_executed[MAX_PASSES];
+	int m_executedCount;
+	bool m_bDirty;
+
+	// cull the passes nothing needs, as a pass bit mask
+	unsigned int CullPasses() const;
+	// order the kept passes, returning false on a cycle
+	bool OrderPasses(unsigned int keptPasses);
+	// place the transient targets in shared textures
+	void AliasTargets();
+	// size of one texel of a target format
+	static int GetTexelBytes(GLenum internalFormat);
+	// total memory of the shared textures for the resource table
+	void TrackTargetMemory() const;
+};
+
+/***********************************************************
+ *  FramePasses
+ *
+ *  This class runs the passes of the scene's frame graph.
+ *  It declares the passes and the targets they use, and
+ *  each frame runs the compiled passes in order over the
+ *  sorted draw order: the depth pre-pass or overdraw view,
+ *  the opaque, unlit and blended ranges of the draws, the
+ *  impostor billboards and the occlusion queries. Lit draws
+ *  are batched into one multi-draw indirect call per
+ *  program and texture when the scene allows it.
+ *
+ *  The recorded draws, their order and the program state
+ *  stay with the scene, which the passes reach through the
+ *  DRAW_SOURCE interface.
+ ***********************************************************/
+class FramePasses
+{
+public:
+	// passes of the frame, in the order they are added to
+	// the frame graph
+	enum FRAME_PASS
+	{
+		PASS_DEPTH_PREPASS,
+		PASS_OVERDRAW,
+		PASS_OPAQUE,
+		PASS_UNLIT,
+		PASS_IMPOSTORS,
+		PASS_BLENDED,
+		PASS_OCCLUSION,
+		PASS_COUNT
+	};
+	// targets the passes read and write, in the same way
+	enum FRAME_TARGET
+	{
+		TARGET_COLOR,
+		TARGET_DEPTH,
+		TARGET_OCCLUSION,
+		TARGET_COUNT
+	};
+
+	// orders a range of the draw order can be sorted into
+	enum DRAW_SORT
+	{
+		// opaque lit draws first in recorded order, then
+		// opaque unlit draws, then translucent draws back to
+		// front
+		SORT_TRANSLUCENT_LAST,
+		// nearest draws first
+		SORT_FRONT_TO_BACK,
+		// grouped by program, texture and material
+		SORT_SHADER_STATE,
+		// grouped by program
+		SORT_PERMUTATION,
+		// grouped by program, then texture
+		SORT_PERMUTATION_TEXTURE
+	};
+
+	// what a draw is batched by in a multi-draw, and where
+	// its geometry and per-draw data are
+	struct BATCH_DRAW
+	{
+		int permutationKey;
+		int textureUnit;
+		SceneGeometry::GEOMETRY_MESH mesh;
+		int drawDataIndex;
+	};
+
+	// the scene the passes draw; draws are passed around as
+	// indices of the scene's recorded draws
+	class DRAW_SOURCE
+	{
+	public:
+		virtual ~DRAW_SOURCE() {}
+
+		// draws to submit this frame, in their current order
+		virtual int GetDrawOrderSize() const = 0;
+		virtual int GetOrderedDraw(int position) const = 0;
+		// sort part of the draw order, keeping the current
+		// order of draws with the same value
+		virtual void SortDrawOrder(int begin, int end, DRAW_SORT sort) = 0;
+		virtual const glm::mat4& GetDrawModel(int draw) const = 0;
+		// batching of a draw, or false when it has no per-draw
+		// data and is drawn the regular way
+		virtual bool GetBatchDraw(int draw, BATCH_DRAW& batchDraw) = 0;
+
+		// camera of the first view
+		virtual const glm::mat4& GetViewMatrix() const = 0;
+		virtual const glm::mat4& GetProjectionMatrix() const = 0;
+		// views of the frame, and whether every view is drawn
+		// by one instanced pass
+		virtual int GetViewCount() const = 0;
+		virtual bool IsSinglePassViews() const = 0;
+		// direct the following draws to one view
+		virtual void SelectView(int view) = 0;
+
+		// whether the lit draws are bucketed by permutation,
+		// and whether they go through multi-draw indirect
+		virtual bool IsShaderPermutationsEnabled() const = 0;
+		virtual bool IsMultiDrawActive() const = 0;
+
+		// open the conditional render for a draw's object, and
+		// close any open conditional render
+		virtual void BeginObjectDraw(int draw) = 0;
+		virtual void EndObjectDraw() = 0;
+		// send the state of a draw to the shader
+		virtual void ApplyDrawState(int draw) = 0;
+		// issue the mesh draw call for a draw
+		virtual void DrawRecordedMesh(int draw) = 0;
+		// rebind the scene program after another was used
+		virtual void RestoreSceneProgram() = 0;
+		// draw the billboards of the faded in props
+		virtual void DrawImpostors() = 0;
+		// query every object's bounds against the finished frame
+		virtual void IssueOcclusionQueries() = 0;
+	};
+
+	// constructor
+	FramePasses(DRAW_SOURCE* pSource, DepthPrePass* pDepthPrePass, SceneGeometry* pSceneGeometry);
+	// destructor
+	~FramePasses();
+
+	// declare the passes and their targets, and create the
+	// indirect command buffer when multi-draw is supported
+	void Initialize();
+	// whether lit draws can be submitted with multi-draw indirect
+	bool IsMultiDrawAvailable() const { return m_indirectBufferID != 0; }
+
+	// include or leave out a pass for the following frames
+	void SetPassEnabled(FRAME_PASS pass, bool bEnabled);
+	// mark a target as needed after the frame
+	void SetOutput(FRAME_TARGET target, bool bOutput);
+
+	// run the passes over the sorted draw order, in which the
+	// lit opaque draws end at litOpaqueEnd and all opaque
+	// draws at opaqueEnd; the shaded fragments are counted
+	// over a viewport of the given size while the overdraw
+	// is reported
+	void Execute(int litOpaqueEnd, int opaqueEnd, int viewportWidth, int viewportHeight);
+
+	// free the indirect command buffer and the graph targets
+	void Destroy();
+
+private:
+	// layout of one draw in the indirect command buffer
+	struct DRAW_ELEMENTS_INDIRECT_COMMAND
+	{
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+	// consecutive indirect draws that share program and
+	// texture, or a single draw submitted the regular way
+	// when drawCount is 0
+	struct MULTI_DRAW_BATCH
+	{
+		int draw;
+		int firstIndirect;
+		int drawCount;
+	};
+
+	DRAW_SOURCE* m_pSource;
+	DepthPrePass* m_pDepthPrePass;
+	SceneGeometry* m_pSceneGeometry;
+	FrameGraph m_frameGraph;
+	// ends of the lit opaque and all opaque draws in the
+	// sorted draw order this frame
+	int m_litOpaqueEnd;
+	int m_opaqueEnd;
+	GLuint m_indirectBufferID;
+	// largest size the indirect buffer has been given
+	GLsizeiptr m_indirectBufferBytes;
+	std::vector<DRAW_ELEMENTS_INDIRECT_COMMAND> m_indirectCommands;
+	std::vector<MULTI_DRAW_BATCH> m_multiDrawBatches;
+
+	// run one pass of the compiled frame graph
+	void ExecutePass(FRAME_PASS pass);
+	// times a pass is submitted for the views of the frame
+	int GetViewPassCount() const;
+	// submit a range of the draw order to every view
+	void SubmitPassDraws(int begin, int end);
+	// submit a range of the draw order with multi-draw indirect
+	void SubmitMultiDraw(int begin, int end);
+};
@@ -0,0 +1,362 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.cpp
+// ============
+// presentation modes, frame rate limiting and input latency measurement
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FramePacer.h"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+// declaration of global variables
+namespace
+{
+	// seconds between frame statistics reports on the console
+	const double g_ReportInterval = 2.0;
+
+	// the limiter sleeps until this close to the deadline and
+	// spins the rest, since sleeps can overshoot by a tick
+	const double g_SpinMargin = 0.002;
+
+	// limiter rate when the display refresh rate is unknown
+	const double g_DefaultFrameRate = 60.0;
+}
+
+/***********************************************************
+ *  FramePacer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FramePacer::FramePacer()
+{
+	m_presentMode = PRESENT_VSYNC;
+	m_bOnDemand = false;
+	m_bAdaptiveSupported = false;
+	m_framePeriod = 1.0 / g_DefaultFrameRate;
+	m_nextFrameTime = 0.0;
+
+	m_lastSwapTime = 0.0;
+	m_frameTimeTotal = 0.0;
+	m_frameTimeWorst = 0.0;
+	m_frameCount = 0;
+	m_lastReportTime = 0.0;
+
+	m_bLatencyProbe = false;
+	m_firstLatencySample = 0;
+	m_latencySampleCount = 0;
+	m_latencyTotal = 0.0;
+	m_latencyWorst = 0.0;
+	m_latencyCount = 0;
+}
+
+/***********************************************************
+ *  ~FramePacer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FramePacer::~FramePacer()
+{
+	SetLatencyProbe(false);
+
+#ifdef _WIN32
+	timeEndPeriod(1);
+#endif
+}
+
+/***********************************************************
+ *  Initialize()
+ ***********************************************************/
+void FramePacer::Initialize()
+{
+#ifdef _WIN32
+	// millisecond sleep granularity for the limiter
+	timeBeginPeriod(1);
+#endif
+
+	// adaptive sync uses a negative swap interval
+	m_bAdaptiveSupported =
+		glfwExtensionSupported("WGL_EXT_swap_control_tear") ||
+		glfwExtensionSupported("GLX_EXT_swap_control_tear");
+
+	// limit to the display refresh rate by default
+	const GLFWvidmode* pVideoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	if ((pVideoMode != NULL) && (pVideoMode->refreshRate > 0))
+	{
+		SetTargetFrameRate(pVideoMode->refreshRate);
+	}
+
+	m_lastSwapTime = glfwGetTime();
+	m_lastReportTime = m_lastSwapTime;
+	m_nextFrameTime = m_lastSwapTime;
+
+	SetPresentMode(m_presentMode);
+}
+
+/***********************************************************
+ *  GetModeName()
+ ***********************************************************/
+const char* FramePacer::GetModeName(PRESENT_MODE mode)
+{
+	switch (mode)
+	{
+	case PRESENT_VSYNC:
+		return "vsync";
+	case PRESENT_ADAPTIVE_VSYNC:
+		return "adaptive vsync";
+	case PRESENT_LIMITED:
+		return "frame limiter";
+	default:
+		return "uncapped";
+	}
+}
+
+/***********************************************************
+ *  SetPresentMode()
+ *
+ *  This method is used to set the swap interval for a
+ *  presentation mode. The limiter does its own waiting, so
+ *  it swaps without sync like the uncapped mode.
+ ***********************************************************/
+void FramePacer::SetPresentMode(PRESENT_MODE mode)
+{
+	m_presentMode = mode;
+
+	switch (mode)
+	{
+	case PRESENT_VSYNC:
+		glfwSwapInterval(1);
+		break;
+	case PRESENT_ADAPTIVE_VSYNC:
+		if (m_bAdaptiveSupported == true)
+		{
+			glfwSwapInterval(-1);
+		}
+		else
+		{
+			std::cout << "INFO: Adaptive vsync not supported, using vsync" << std::endl;
+			glfwSwapInterval(1);
+		}
+		break;
+	default:
+		glfwSwapInterval(0);
+		break;
+	}
+
+	m_nextFrameTime = glfwGetTime();
+
+	std::cout << "INFO: Presentation mode: " << GetModeName(mode);
+	if (mode == PRESENT_LIMITED)
+	{
+		std::cout << " at " << (1.0 / m_framePeriod) << " fps";
+	}
+	std::cout << std::endl;
+}
+
+/***********************************************************
+ *  CyclePresentMode()
+ ***********************************************************/
+void FramePacer::CyclePresentMode()
+{
+	SetPresentMode((PRESENT_MODE)((m_presentMode + 1) % PRESENT_MODE_COUNT));
+}
+
+/***********************************************************
+ *  SetTargetFrameRate()
+ ***********************************************************/
+void FramePacer::SetTargetFrameRate(double framesPerSecond)
+{
+	if (framesPerSecond > 0.0)
+	{
+		m_framePeriod = 1.0 / framesPerSecond;
+	}
+}
+
+/***********************************************************
+ *  SetOnDemand()
+ ***********************************************************/
+void FramePacer::SetOnDemand(bool bEnabled)
+{
+	m_bOnDemand = bEnabled;
+	std::cout << "INFO: On-demand rendering " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  ResumeAfterIdle()
+ *
+ *  This method is used after the loop waited for events, so
+ *  the wait is not counted as a long frame and the limiter
+ *  does not try to catch up on it.
+ ***********************************************************/
+void FramePacer::ResumeAfterIdle()
+{
+	double now = glfwGetTime();
+	m_lastSwapTime = now;
+	m_nextFrameTime = now;
+}
+
+/***********************************************************
+ *  SetLatencyProbe()
+ ***********************************************************/
+void FramePacer::SetLatencyProbe(bool bEnabled)
+{
+	m_bLatencyProbe = bEnabled;
+
+	while (m_latencySampleCount > 0)
+	{
+		DropOldestLatencySample();
+	}
+	m_latencyTotal = 0.0;
+	m_latencyWorst = 0.0;
+	m_latencyCount = 0;
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used to record a swapped frame. With the
+ *  probe on, a fence placed after the swap signals once the
+ *  GPU has finished the frame, which is taken as the time
+ *  it reaches the display. Fences are polled, never waited
+ *  on, so the probe does not change the timing it measures.
+ ***********************************************************/
+void FramePacer::EndFrame(double inputTime)
+{
+	double now = glfwGetTime();
+	double frameTime = now - m_lastSwapTime;
+	m_lastSwapTime = now;
+
+	m_frameTimeTotal += frameTime;
+	if (frameTime > m_frameTimeWorst)
+		m_frameTimeWorst = frameTime;
+	m_frameCount++;
+
+	if (m_bLatencyProbe == true)
+	{
+		CollectLatencySamples(now);
+
+		if (inputTime >= 0.0)
+		{
+			if (m_latencySampleCount >= MAX_LATENCY_SAMPLES)
+			{
+				DropOldestLatencySample();
+			}
+			LATENCY_SAMPLE& sample = m_latencySamples[
+				(m_firstLatencySample + m_latencySampleCount) % MAX_LATENCY_SAMPLES];
+			sample.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			sample.inputTime = inputTime;
+			m_latencySampleCount++;
+		}
+	}
+
+	if (now - m_lastReportTime >= g_ReportInterval)
+	{
+		Report(now);
+	}
+}
+
+/***********************************************************
+ *  CollectLatencySamples()
+ ***********************************************************/
+void FramePacer::CollectLatencySamples(double now)
+{
+	while (m_latencySampleCount > 0)
+	{
+		LATENCY_SAMPLE& sample = m_latencySamples[m_firstLatencySample];
+		GLenum result = glClientWaitSync(sample.fence, 0, 0);
+		if ((result != GL_ALREADY_SIGNALED) && (result != GL_CONDITION_SATISFIED))
+			break;
+
+		double latency = now - sample.inputTime;
+		m_latencyTotal += latency;
+		if (latency > m_latencyWorst)
+			m_latencyWorst = latency;
+		m_latencyCount++;
+
+		DropOldestLatencySample();
+	}
+}
+
+/***********************************************************
+ *  DropOldestLatencySample()
+ ***********************************************************/
+void FramePacer::DropOldestLatencySample()
+{
+	glDeleteSync(m_latencySamples[m_firstLatencySample].fence);
+	m_latencySamples[m_firstLatencySample].fence = 0;
+	m_firstLatencySample = (m_firstLatencySample + 1) % MAX_LATENCY_SAMPLES;
+	m_latencySampleCount--;
+}
+
+/***********************************************************
+ *  Report()
+ ***********************************************************/
+void FramePacer::Report(double now)
+{
+	if (m_frameCount > 0)
+	{
+		std::cout << "INFO: " << GetModeName(m_presentMode) << ": "
+			<< m_frameCount / (now - m_lastReportTime) << " fps, frame time avg "
+			<< (m_frameTimeTotal / m_frameCount) * 1000.0 << " ms, worst "
+			<< m_frameTimeWorst * 1000.0 << " ms" << std::endl;
+	}
+	if (m_latencyCount > 0)
+	{
+		std::cout << "INFO: Input latency avg "
+			<< (m_latencyTotal / m_latencyCount) * 1000.0 << " ms, worst "
+			<< m_latencyWorst * 1000.0 << " ms over " << m_latencyCount
+			<< " inputs" << std::endl;
+	}
+
+	m_frameTimeTotal = 0.0;
+	m_frameTimeWorst = 0.0;
+	m_frameCount = 0;
+	m_latencyTotal = 0.0;
+	m_latencyWorst = 0.0;
+	m_latencyCount = 0;
+	m_lastReportTime = now;
+}
+
+/***********************************************************
+ *  WaitForNextFrame()
+ *
+ *  This method is used to hold the next frame back until
+ *  its start time when the limiter is on. Waiting before
+ *  the events are polled keeps the input the frame uses as
+ *  fresh as possible. A frame that starts late moves the
+ *  schedule instead of rushing the frames after it.
+ ***********************************************************/
+void FramePacer::WaitForNextFrame()
+{
+	if (m_presentMode != PRESENT_LIMITED)
+		return;
+
+	double now = glfwGetTime();
+	if (now >= m_nextFrameTime)
+	{
+		m_nextFrameTime = now + m_framePeriod;
+		return;
+	}
+
+	double remaining = m_nextFrameTime - now;
+	if (remaining > g_SpinMargin)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double>(remaining - g_SpinMargin));
+	}
+	while (glfwGetTime() < m_nextFrameTime)
+	{
+		std::this_thread::yield();
+	}
+
+	m_nextFrameTime += m_framePeriod;
+}
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// framepacer.h
+// ============
+// presentation modes, frame rate limiting and input latency measurement
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include "GLFW/glfw3.h"
+
+/***********************************************************
+ *  FramePacer
+ *
+ *  This class controls how finished frames are presented:
+ *  synced to the display, adaptive sync that tears instead
+ *  of waiting when a frame is late, a sleep-then-spin frame
+ *  rate limiter, or uncapped. It also reports frame times
+ *  and, with the latency probe on, the time from an input
+ *  event until the GPU has finished the first frame that
+ *  shows it.
+ ***********************************************************/
+class FramePacer
+{
+public:
+	// constructor
+	FramePacer();
+	// destructor
+	~FramePacer();
+
+	enum PRESENT_MODE
+	{
+		PRESENT_VSYNC,
+		PRESENT_ADAPTIVE_VSYNC,
+		PRESENT_LIMITED,
+		PRESENT_UNCAPPED,
+		PRESENT_MODE_COUNT
+	};
+
+	// read the display refresh rate and apply the default
+	// mode, once the OpenGL context is current
+	void Initialize();
+
+	// change how frames are presented
+	void SetPresentMode(PRESENT_MODE mode);
+	PRESENT_MODE GetPresentMode() const { return m_presentMode; }
+	// switch to the next presentation mode
+	void CyclePresentMode();
+	// frame rate used by the limiter
+	void SetTargetFrameRate(double framesPerSecond);
+
+	// enable or disable rendering only when something changed
+	void SetOnDemand(bool bEnabled);
+	bool IsOnDemand() const { return m_bOnDemand; }
+	// restart frame timing after the loop slept while idle
+	void ResumeAfterIdle();
+
+	// enable or disable the input latency probe
+	void SetLatencyProbe(bool bEnabled);
+	bool IsLatencyProbeEnabled() const { return m_bLatencyProbe; }
+
+	// record the frame just swapped, with the time of the
+	// earliest input it shows, or a negative time for none
+	void EndFrame(double inputTime);
+	// wait until the limiter lets the next frame start
+	void WaitForNextFrame();
+
+private:
+	// a swapped frame whose GPU completion is being watched
+	struct LATENCY_SAMPLE
+	{
+		GLsync fence;
+		double inputTime;
+	};
+
+	// frames whose latency can be pending before the oldest
+	// is dropped
+	static const int MAX_LATENCY_SAMPLES = 8;
+
+	PRESENT_MODE m_presentMode;
+	bool m_bOnDemand;
+	bool m_bAdaptiveSupported;
+	// limiter frame period and start time of the next frame
+	double m_framePeriod;
+	double m_nextFrameTime;
+
+	// frame time statistics since the last report
+	double m_lastSwapTime;
+	double m_frameTimeTotal;
+	double m_frameTimeWorst;
+	int m_frameCount;
+	double m_lastReportTime;
+
+	// latency probe state and statistics since the last report
+	bool m_bLatencyProbe;
+	// pending samples in a fixed ring, oldest first
+	LATENCY_SAMPLE m_latencySamples[MAX_LATENCY_SAMPLES];
+	int m_firstLatencySample;
+	int m_latencySampleCount;
+	double m_latencyTotal;
+	double m_latencyWorst;
+	int m_latencyCount;
+
+	// collect the latency of frames the GPU has finished
+	void CollectLatencySamples(double now);
+	// delete the fence of the oldest pending sample and drop it
+	void DropOldestLatencySample();
+	// print and reset the statistics
+	void Report(double now);
+	// name of a presentation mode for the console
+	static const char* GetModeName(PRESENT_MODE mode);
+};
@@ -0,0 +1,898 @@
+///////////////////////////////////////////////////////////////////////////////
+// glcalltrace.cpp
+// ============
+// interception of OpenGL calls for per-frame call statistics and traces
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GLCallTrace.h"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#include "GLFW/glfw3.h"
+
+// declaration of global variables
+namespace
+{
+	// intercepted functions, in the order of the trace's
+	// function table
+	enum TRACE_FUNCTION
+	{
+		FUNC_USE_PROGRAM,
+		FUNC_UNIFORM_1I,
+		FUNC_UNIFORM_1F,
+		FUNC_UNIFORM_2F,
+		FUNC_UNIFORM_2FV,
+		FUNC_UNIFORM_3F,
+		FUNC_UNIFORM_3FV,
+		FUNC_UNIFORM_4F,
+		FUNC_UNIFORM_4FV,
+		FUNC_UNIFORM_MATRIX_4FV,
+		FUNC_PROGRAM_UNIFORM_1I,
+		FUNC_PROGRAM_UNIFORM_1F,
+		FUNC_PROGRAM_UNIFORM_2FV,
+		FUNC_PROGRAM_UNIFORM_3FV,
+		FUNC_PROGRAM_UNIFORM_4FV,
+		FUNC_PROGRAM_UNIFORM_MATRIX_4FV,
+		FUNC_ACTIVE_TEXTURE,
+		FUNC_BIND_BUFFER,
+		FUNC_BIND_BUFFER_BASE,
+		FUNC_BIND_BUFFER_RANGE,
+		FUNC_BUFFER_DATA,
+		FUNC_BUFFER_SUB_DATA,
+		FUNC_BIND_VERTEX_ARRAY,
+		FUNC_VERTEX_ATTRIB_I1I,
+		FUNC_BIND_FRAMEBUFFER,
+		FUNC_BLIT_FRAMEBUFFER,
+		FUNC_DRAW_ELEMENTS_BASE_VERTEX,
+		FUNC_DRAW_ELEMENTS_INSTANCED,
+		FUNC_MULTI_DRAW_ELEMENTS_INDIRECT,
+		FUNC_BEGIN_QUERY,
+		FUNC_END_QUERY,
+		FUNC_BEGIN_CONDITIONAL_RENDER,
+		FUNC_END_CONDITIONAL_RENDER,
+		FUNC_FENCE_SYNC,
+		FUNC_CLIENT_WAIT_SYNC,
+		FUNC_COUNT
+	};
+
+	struct FUNCTION_INFO
+	{
+		const char* name;
+		GLCallTrace::CALL_TYPE type;
+	};
+
+	const FUNCTION_INFO g_FunctionInfo[FUNC_COUNT] = {
+		{ "glUseProgram", GLCallTrace::CALL_PROGRAM },
+		{ "glUniform1i", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform1f", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform2f", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform2fv", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform3f", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform3fv", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform4f", GLCallTrace::CALL_UNIFORM },
+		{ "glUniform4fv", GLCallTrace::CALL_UNIFORM },
+		{ "glUniformMatrix4fv", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniform1i", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniform1f", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniform2fv", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniform3fv", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniform4fv", GLCallTrace::CALL_UNIFORM },
+		{ "glProgramUniformMatrix4fv", GLCallTrace::CALL_UNIFORM },
+		{ "glActiveTexture", GLCallTrace::CALL_TEXTURE },
+		{ "glBindBuffer", GLCallTrace::CALL_BUFFER },
+		{ "glBindBufferBase", GLCallTrace::CALL_BUFFER },
+		{ "glBindBufferRange", GLCallTrace::CALL_BUFFER },
+		{ "glBufferData", GLCallTrace::CALL_BUFFER },
+		{ "glBufferSubData", GLCallTrace::CALL_BUFFER },
+		{ "glBindVertexArray", GLCallTrace::CALL_VERTEX_ARRAY },
+		{ "glVertexAttribI1i", GLCallTrace::CALL_VERTEX_ARRAY },
+		{ "glBindFramebuffer", GLCallTrace::CALL_FRAMEBUFFER },
+		{ "glBlitFramebuffer", GLCallTrace::CALL_FRAMEBUFFER },
+		{ "glDrawElementsBaseVertex", GLCallTrace::CALL_DRAW },
+		{ "glDrawElementsInstanced", GLCallTrace::CALL_DRAW },
+		{ "glMultiDrawElementsIndirect", GLCallTrace::CALL_DRAW },
+		{ "glBeginQuery", GLCallTrace::CALL_QUERY },
+		{ "glEndQuery", GLCallTrace::CALL_QUERY },
+		{ "glBeginConditionalRender", GLCallTrace::CALL_QUERY },
+		{ "glEndConditionalRender", GLCallTrace::CALL_QUERY },
+		{ "glFenceSync", GLCallTrace::CALL_SYNC },
+		{ "glClientWaitSync", GLCallTrace::CALL_SYNC } };
+
+	const char* g_CallTypeNames[GLCallTrace::CALL_TYPE_COUNT] = {
+		"program", "uniform", "texture", "buffer", "vertex array",
+		"framebuffer", "draw", "query", "sync" };
+
+	// trace file layout: the magic and version, the number of
+	// functions and their names, then one byte per call with
+	// the function index, the high bit marking a redundant
+	// call, and g_TraceFrameEnd after each frame
+	const char g_TraceMagic[4] = { 'G', 'L', 'T', 'R' };
+	const unsigned char g_TraceVersion = 1;
+	const unsigned char g_TraceFrameEnd = 0x7F;
+	const unsigned char g_TraceRedundantFlag = 0x80;
+
+	// binding value before the first intercepted bind
+	const GLuint g_UnknownBinding = 0xFFFFFFFF;
+
+	// seconds between call statistics reports on the console
+	const double g_ReportInterval = 2.0;
+
+	// trace the wrappers report to while installed
+	GLCallTrace* g_pTrace = NULL;
+
+	// the GLEW function pointers the wrappers replaced
+	struct ORIGINAL_FUNCTIONS
+	{
+		PFNGLUSEPROGRAMPROC UseProgram;
+		PFNGLUNIFORM1IPROC Uniform1i;
+		PFNGLUNIFORM1FPROC Uniform1f;
+		PFNGLUNIFORM2FPROC Uniform2f;
+		PFNGLUNIFORM2FVPROC Uniform2fv;
+		PFNGLUNIFORM3FPROC Uniform3f;
+		PFNGLUNIFORM3FVPROC Uniform3fv;
+		PFNGLUNIFORM4FPROC Uniform4f;
+		PFNGLUNIFORM4FVPROC Uniform4fv;
+		PFNGLUNIFORMMATRIX4FVPROC UniformMatrix4fv;
+		PFNGLPROGRAMUNIFORM1IPROC ProgramUniform1i;
+		PFNGLPROGRAMUNIFORM1FPROC ProgramUniform1f;
+		PFNGLPROGRAMUNIFORM2FVPROC ProgramUniform2fv;
+		PFNGLPROGRAMUNIFORM3FVPROC ProgramUniform3fv;
+		PFNGLPROGRAMUNIFORM4FVPROC ProgramUniform4fv;
+		PFNGLPROGRAMUNIFORMMATRIX4FVPROC ProgramUniformMatrix4fv;
+		PFNGLACTIVETEXTUREPROC ActiveTexture;
+		PFNGLBINDBUFFERPROC BindBuffer;
+		PFNGLBINDBUFFERBASEPROC BindBufferBase;
+		PFNGLBINDBUFFERRANGEPROC BindBufferRange;
+		PFNGLBUFFERDATAPROC BufferData;
+		PFNGLBUFFERSUBDATAPROC BufferSubData;
+		PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+		PFNGLVERTEXATTRIBI1IPROC VertexAttribI1i;
+		PFNGLBINDFRAMEBUFFERPROC BindFramebuffer;
+		PFNGLBLITFRAMEBUFFERPROC BlitFramebuffer;
+		PFNGLDRAWELEMENTSBASEVERTEXPROC DrawElementsBaseVertex;
+		PFNGLDRAWELEMENTSINSTANCEDPROC DrawElementsInstanced;
+		PFNGLMULTIDRAWELEMENTSINDIRECTPROC MultiDrawElementsIndirect;
+		PFNGLBEGINQUERYPROC BeginQuery;
+		PFNGLENDQUERYPROC EndQuery;
+		PFNGLBEGINCONDITIONALRENDERPROC BeginConditionalRender;
+		PFNGLENDCONDITIONALRENDERPROC EndConditionalRender;
+		PFNGLFENCESYNCPROC FenceSync;
+		PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+	};
+	ORIGINAL_FUNCTIONS g_Original = {};
+
+	/***********************************************************
+	 *  GetBufferBinding()
+	 *
+	 *  This function is used to map a buffer target to its
+	 *  tracked binding, or BINDING_COUNT when not tracked. The
+	 *  element array binding belongs to the vertex array, so
+	 *  it is not tracked on its own.
+	 ***********************************************************/
+	GLCallTrace::BINDING GetBufferBinding(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			return GLCallTrace::BINDING_ARRAY_BUFFER;
+		case GL_DRAW_INDIRECT_BUFFER:
+			return GLCallTrace::BINDING_INDIRECT_BUFFER;
+		case GL_SHADER_STORAGE_BUFFER:
+			return GLCallTrace::BINDING_STORAGE_BUFFER;
+		case GL_UNIFORM_BUFFER:
+			return GLCallTrace::BINDING_UNIFORM_BUFFER;
+		default:
+			return GLCallTrace::BINDING_COUNT;
+		}
+	}
+
+	// ---------------------------
+	// wrappers
+	// ---------------------------
+	void GLAPIENTRY Trace_UseProgram(GLuint program)
+	{
+		g_pTrace->RecordCall(FUNC_USE_PROGRAM, g_pTrace->SetBinding(GLCallTrace::BINDING_PROGRAM, program));
+		g_Original.UseProgram(program);
+	}
+
+	void GLAPIENTRY Trace_Uniform1i(GLint location, GLint v0)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_1I,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, &v0, sizeof(v0)));
+		g_Original.Uniform1i(location, v0);
+	}
+
+	void GLAPIENTRY Trace_Uniform1f(GLint location, GLfloat v0)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_1F,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, &v0, sizeof(v0)));
+		g_Original.Uniform1f(location, v0);
+	}
+
+	void GLAPIENTRY Trace_Uniform2f(GLint location, GLfloat v0, GLfloat v1)
+	{
+		GLfloat value[2] = { v0, v1 };
+		g_pTrace->RecordCall(FUNC_UNIFORM_2F,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(value)));
+		g_Original.Uniform2f(location, v0, v1);
+	}
+
+	void GLAPIENTRY Trace_Uniform2fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_2FV,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(GLfloat) * 2 * count));
+		g_Original.Uniform2fv(location, count, value);
+	}
+
+	void GLAPIENTRY Trace_Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+	{
+		GLfloat value[3] = { v0, v1, v2 };
+		g_pTrace->RecordCall(FUNC_UNIFORM_3F,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(value)));
+		g_Original.Uniform3f(location, v0, v1, v2);
+	}
+
+	void GLAPIENTRY Trace_Uniform3fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_3FV,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(GLfloat) * 3 * count));
+		g_Original.Uniform3fv(location, count, value);
+	}
+
+	void GLAPIENTRY Trace_Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+	{
+		GLfloat value[4] = { v0, v1, v2, v3 };
+		g_pTrace->RecordCall(FUNC_UNIFORM_4F,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(value)));
+		g_Original.Uniform4f(location, v0, v1, v2, v3);
+	}
+
+	void GLAPIENTRY Trace_Uniform4fv(GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_4FV,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(GLfloat) * 4 * count));
+		g_Original.Uniform4fv(location, count, value);
+	}
+
+	void GLAPIENTRY Trace_UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_UNIFORM_MATRIX_4FV,
+			g_pTrace->SetUniform(g_pTrace->GetCurrentProgram(), location, value, sizeof(GLfloat) * 16 * count));
+		g_Original.UniformMatrix4fv(location, count, transpose, value);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniform1i(GLuint program, GLint location, GLint v0)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_1I,
+			g_pTrace->SetUniform(program, location, &v0, sizeof(v0)));
+		g_Original.ProgramUniform1i(program, location, v0);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniform1f(GLuint program, GLint location, GLfloat v0)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_1F,
+			g_pTrace->SetUniform(program, location, &v0, sizeof(v0)));
+		g_Original.ProgramUniform1f(program, location, v0);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_2FV,
+			g_pTrace->SetUniform(program, location, value, sizeof(GLfloat) * 2 * count));
+		g_Original.ProgramUniform2fv(program, location, count, value);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_3FV,
+			g_pTrace->SetUniform(program, location, value, sizeof(GLfloat) * 3 * count));
+		g_Original.ProgramUniform3fv(program, location, count, value);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_4FV,
+			g_pTrace->SetUniform(program, location, value, sizeof(GLfloat) * 4 * count));
+		g_Original.ProgramUniform4fv(program, location, count, value);
+	}
+
+	void GLAPIENTRY Trace_ProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+	{
+		g_pTrace->RecordCall(FUNC_PROGRAM_UNIFORM_MATRIX_4FV,
+			g_pTrace->SetUniform(program, location, value, sizeof(GLfloat) * 16 * count));
+		g_Original.ProgramUniformMatrix4fv(program, location, count, transpose, value);
+	}
+
+	void GLAPIENTRY Trace_ActiveTexture(GLenum texture)
+	{
+		g_pTrace->RecordCall(FUNC_ACTIVE_TEXTURE, g_pTrace->SetBinding(GLCallTrace::BINDING_ACTIVE_TEXTURE, texture));
+		g_Original.ActiveTexture(texture);
+	}
+
+	void GLAPIENTRY Trace_BindBuffer(GLenum target, GLuint buffer)
+	{
+		GLCallTrace::BINDING binding = GetBufferBinding(target);
+		bool bRedundant = (binding != GLCallTrace::BINDING_COUNT) && g_pTrace->SetBinding(binding, buffer);
+		g_pTrace->RecordCall(FUNC_BIND_BUFFER, bRedundant);
+		g_Original.BindBuffer(target, buffer);
+	}
+
+	void GLAPIENTRY Trace_BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+	{
+		// also binds the buffer to the target's generic binding
+		GLCallTrace::BINDING binding = GetBufferBinding(target);
+		if (binding != GLCallTrace::BINDING_COUNT)
+			g_pTrace->SetBinding(binding, buffer);
+		g_pTrace->RecordCall(FUNC_BIND_BUFFER_BASE, false);
+		g_Original.BindBufferBase(target, index, buffer);
+	}
+
+	void GLAPIENTRY Trace_BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+	{
+		GLCallTrace::BINDING binding = GetBufferBinding(target);
+		if (binding != GLCallTrace::BINDING_COUNT)
+			g_pTrace->SetBinding(binding, buffer);
+		g_pTrace->RecordCall(FUNC_BIND_BUFFER_RANGE, false);
+		g_Original.BindBufferRange(target, index, buffer, offset, size);
+	}
+
+	void GLAPIENTRY Trace_BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+	{
+		g_pTrace->RecordCall(FUNC_BUFFER_DATA, false);
+		g_Original.BufferData(target, size, data, usage);
+	}
+
+	void GLAPIENTRY Trace_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+	{
+		g_pTrace->RecordCall(FUNC_BUFFER_SUB_DATA, false);
+		g_Original.BufferSubData(target, offset, size, data);
+	}
+
+	void GLAPIENTRY Trace_BindVertexArray(GLuint array)
+	{
+		g_pTrace->RecordCall(FUNC_BIND_VERTEX_ARRAY, g_pTrace->SetBinding(GLCallTrace::BINDING_VERTEX_ARRAY, array));
+		g_Original.BindVertexArray(array);
+	}
+
+	void GLAPIENTRY Trace_VertexAttribI1i(GLuint index, GLint x)
+	{
+		g_pTrace->RecordCall(FUNC_VERTEX_ATTRIB_I1I, false);
+		g_Original.VertexAttribI1i(index, x);
+	}
+
+	void GLAPIENTRY Trace_BindFramebuffer(GLenum target, GLuint framebuffer)
+	{
+		bool bRedundant = false;
+		if (target == GL_READ_FRAMEBUFFER)
+		{
+			bRedundant = g_pTrace->SetBinding(GLCallTrace::BINDING_READ_FRAMEBUFFER, framebuffer);
+		}
+		else if (target == GL_DRAW_FRAMEBUFFER)
+		{
+			bRedundant = g_pTrace->SetBinding(GLCallTrace::BINDING_DRAW_FRAMEBUFFER, framebuffer);
+		}
+		else
+		{
+			bool bReadBound = g_pTrace->SetBinding(GLCallTrace::BINDING_READ_FRAMEBUFFER, framebuffer);
+			bool bDrawBound = g_pTrace->SetBinding(GLCallTrace::BINDING_DRAW_FRAMEBUFFER, framebuffer);
+			bRedundant = bReadBound && bDrawBound;
+		}
+		g_pTrace->RecordCall(FUNC_BIND_FRAMEBUFFER, bRedundant);
+		g_Original.BindFramebuffer(target, framebuffer);
+	}
+
+	void GLAPIENTRY Trace_BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1,
+		GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+	{
+		g_pTrace->RecordCall(FUNC_BLIT_FRAMEBUFFER, false);
+		g_Original.BlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+	}
+
+	void GLAPIENTRY Trace_DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+	{
+		g_pTrace->RecordCall(FUNC_DRAW_ELEMENTS_BASE_VERTEX, false);
+		g_Original.DrawElementsBaseVertex(mode, count, type, indices, basevertex);
+	}
+
+	void GLAPIENTRY Trace_DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount)
+	{
+		g_pTrace->RecordCall(FUNC_DRAW_ELEMENTS_INSTANCED, false);
+		g_Original.DrawElementsInstanced(mode, count, type, indices, instancecount);
+	}
+
+	void GLAPIENTRY Trace_MultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride)
+	{
+		g_pTrace->RecordCall(FUNC_MULTI_DRAW_ELEMENTS_INDIRECT, false);
+		g_Original.MultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+	}
+
+	void GLAPIENTRY Trace_BeginQuery(GLenum target, GLuint id)
+	{
+		g_pTrace->RecordCall(FUNC_BEGIN_QUERY, false);
+		g_Original.BeginQuery(target, id);
+	}
+
+	void GLAPIENTRY Trace_EndQuery(GLenum target)
+	{
+		g_pTrace->RecordCall(FUNC_END_QUERY, false);
+		g_Original.EndQuery(target);
+	}
+
+	void GLAPIENTRY Trace_BeginConditionalRender(GLuint id, GLenum mode)
+	{
+		g_pTrace->RecordCall(FUNC_BEGIN_CONDITIONAL_RENDER, false);
+		g_Original.BeginConditionalRender(id, mode);
+	}
+
+	void GLAPIENTRY Trace_EndConditionalRender()
+	{
+		g_pTrace->RecordCall(FUNC_END_CONDITIONAL_RENDER, false);
+		g_Original.EndConditionalRender();
+	}
+
+	GLsync GLAPIENTRY Trace_FenceSync(GLenum condition, GLbitfield flags)
+	{
+		g_pTrace->RecordCall(FUNC_FENCE_SYNC, false);
+		return g_Original.FenceSync(condition, flags);
+	}
+
+	GLenum GLAPIENTRY Trace_ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout)
+	{
+		g_pTrace->RecordCall(FUNC_CLIENT_WAIT_SYNC, false);
+		return g_Original.ClientWaitSync(sync, flags, timeout);
+	}
+}
+
+// swap one GLEW function pointer for its wrapper, skipping
+// functions the context does not have
+#define TRACE_HOOK(name) \
+	if (__glew##name != NULL) \
+	{ \
+		g_Original.name = __glew##name; \
+		__glew##name = Trace_##name; \
+	}
+
+// put one original GLEW function pointer back
+#define TRACE_UNHOOK(name) \
+	if (g_Original.name != NULL) \
+	{ \
+		__glew##name = g_Original.name; \
+		g_Original.name = NULL; \
+	}
+
+/***********************************************************
+ *  GLCallTrace()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GLCallTrace::GLCallTrace()
+{
+	m_bInstalled = false;
+	for (int i = 0; i < BINDING_COUNT; i++)
+	{
+		m_bindings[i] = g_UnknownBinding;
+	}
+	for (int i = 0; i < MAX_FUNCTIONS; i++)
+	{
+		m_callCounts[i] = 0;
+		m_redundantCounts[i] = 0;
+	}
+	m_frameCount = 0;
+	m_lastReportTime = 0.0;
+}
+
+/***********************************************************
+ *  ~GLCallTrace()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GLCallTrace::~GLCallTrace()
+{
+	StopTrace();
+	Uninstall();
+}
+
+/***********************************************************
+ *  Install()
+ *
+ *  This method is used to put the wrappers in place. The
+ *  state bound before this is unknown, so the first bind
+ *  of each kind is never counted as redundant.
+ ***********************************************************/
+void GLCallTrace::Install()
+{
+	if ((m_bInstalled == true) || (g_pTrace != NULL))
+		return;
+
+	g_pTrace = this;
+	for (int i = 0; i < BINDING_COUNT; i++)
+	{
+		m_bindings[i] = g_UnknownBinding;
+	}
+	m_uniformValues.clear();
+
+	TRACE_HOOK(UseProgram);
+	TRACE_HOOK(Uniform1i);
+	TRACE_HOOK(Uniform1f);
+	TRACE_HOOK(Uniform2f);
+	TRACE_HOOK(Uniform2fv);
+	TRACE_HOOK(Uniform3f);
+	TRACE_HOOK(Uniform3fv);
+	TRACE_HOOK(Uniform4f);
+	TRACE_HOOK(Uniform4fv);
+	TRACE_HOOK(UniformMatrix4fv);
+	TRACE_HOOK(ProgramUniform1i);
+	TRACE_HOOK(ProgramUniform1f);
+	TRACE_HOOK(ProgramUniform2fv);
+	TRACE_HOOK(ProgramUniform3fv);
+	TRACE_HOOK(ProgramUniform4fv);
+	TRACE_HOOK(ProgramUniformMatrix4fv);
+	TRACE_HOOK(ActiveTexture);
+	TRACE_HOOK(BindBuffer);
+	TRACE_HOOK(BindBufferBase);
+	TRACE_HOOK(BindBufferRange);
+	TRACE_HOOK(BufferData);
+	TRACE_HOOK(BufferSubData);
+	TRACE_HOOK(BindVertexArray);
+	TRACE_HOOK(VertexAttribI1i);
+	TRACE_HOOK(BindFramebuffer);
+	TRACE_HOOK(BlitFramebuffer);
+	TRACE_HOOK(DrawElementsBaseVertex);
+	TRACE_HOOK(DrawElementsInstanced);
+	TRACE_HOOK(MultiDrawElementsIndirect);
+	TRACE_HOOK(BeginQuery);
+	TRACE_HOOK(EndQuery);
+	TRACE_HOOK(BeginConditionalRender);
+	TRACE_HOOK(EndConditionalRender);
+	TRACE_HOOK(FenceSync);
+	TRACE_HOOK(ClientWaitSync);
+
+	m_bInstalled = true;
+	m_frameCount = 0;
+	m_lastReportTime = glfwGetTime();
+	std::cout << "INFO: GL call statistics enabled" << std::endl;
+}
+
+/***********************************************************
+ *  Uninstall()
+ ***********************************************************/
+void GLCallTrace::Uninstall()
+{
+	if (m_bInstalled == false)
+		return;
+
+	TRACE_UNHOOK(UseProgram);
+	TRACE_UNHOOK(Uniform1i);
+	TRACE_UNHOOK(Uniform1f);
+	TRACE_UNHOOK(Uniform2f);
+	TRACE_UNHOOK(Uniform2fv);
+	TRACE_UNHOOK(Uniform3f);
+	TRACE_UNHOOK(Uniform3fv);
+	TRACE_UNHOOK(Uniform4f);
+	TRACE_UNHOOK(Uniform4fv);
+	TRACE_UNHOOK(UniformMatrix4fv);
+	TRACE_UNHOOK(ProgramUniform1i);
+	TRACE_UNHOOK(ProgramUniform1f);
+	TRACE_UNHOOK(ProgramUniform2fv);
+	TRACE_UNHOOK(ProgramUniform3fv);
+	TRACE_UNHOOK(ProgramUniform4fv);
+	TRACE_UNHOOK(ProgramUniformMatrix4fv);
+	TRACE_UNHOOK(ActiveTexture);
+	TRACE_UNHOOK(BindBuffer);
+	TRACE_UNHOOK(BindBufferBase);
+	TRACE_UNHOOK(BindBufferRange);
+	TRACE_UNHOOK(BufferData);
+	TRACE_UNHOOK(BufferSubData);
+	TRACE_UNHOOK(BindVertexArray);
+	TRACE_UNHOOK(VertexAttribI1i);
+	TRACE_UNHOOK(BindFramebuffer);
+	TRACE_UNHOOK(BlitFramebuffer);
+	TRACE_UNHOOK(DrawElementsBaseVertex);
+	TRACE_UNHOOK(DrawElementsInstanced);
+	TRACE_UNHOOK(MultiDrawElementsIndirect);
+	TRACE_UNHOOK(BeginQuery);
+	TRACE_UNHOOK(EndQuery);
+	TRACE_UNHOOK(BeginConditionalRender);
+	TRACE_UNHOOK(EndConditionalRender);
+	TRACE_UNHOOK(FenceSync);
+	TRACE_UNHOOK(ClientWaitSync);
+
+	g_pTrace = NULL;
+	m_bInstalled = false;
+	std::cout << "INFO: GL call statistics disabled" << std::endl;
+}
+
+/***********************************************************
+ *  StartTrace()
+ *
+ *  This method is used to open a trace file and write the
+ *  function table, installing the wrappers if needed.
+ ***********************************************************/
+bool GLCallTrace::StartTrace(const char* filename)
+{
+	StopTrace();
+
+	m_traceFile.open(filename, std::ios::binary | std::ios::trunc);
+	if (!m_traceFile)
+	{
+		std::cout << "ERROR: Could not open GL trace file " << filename << std::endl;
+		return false;
+	}
+
+	m_traceBuffer.clear();
+	m_traceBuffer.insert(m_traceBuffer.end(), g_TraceMagic, g_TraceMagic + sizeof(g_TraceMagic));
+	m_traceBuffer.push_back(g_TraceVersion);
+	m_traceBuffer.push_back((unsigned char)FUNC_COUNT);
+	for (int i = 0; i < FUNC_COUNT; i++)
+	{
+		size_t length = strlen(g_FunctionInfo[i].name);
+		m_traceBuffer.push_back((unsigned char)length);
+		m_traceBuffer.insert(m_traceBuffer.end(), g_FunctionInfo[i].name, g_FunctionInfo[i].name + length);
+	}
+
+	Install();
+	std::cout << "INFO: Writing GL trace to " << filename << std::endl;
+	return true;
+}
+
+/***********************************************************
+ *  StopTrace()
+ ***********************************************************/
+void GLCallTrace::StopTrace()
+{
+	if (m_traceFile.is_open() == false)
+		return;
+
+	m_traceFile.write((const char*)m_traceBuffer.data(), m_traceBuffer.size());
+	m_traceFile.close();
+	m_traceBuffer.clear();
+}
+
+/***********************************************************
+ *  RecordCall()
+ ***********************************************************/
+void GLCallTrace::RecordCall(int function, bool bRedundant)
+{
+	m_callCounts[function]++;
+	if (bRedundant == true)
+		m_redundantCounts[function]++;
+
+	if (m_traceFile.is_open() == true)
+	{
+		m_traceBuffer.push_back((unsigned char)function |
+			((bRedundant == true) ? g_TraceRedundantFlag : 0));
+	}
+}
+
+/***********************************************************
+ *  SetBinding()
+ ***********************************************************/
+bool GLCallTrace::SetBinding(BINDING binding, GLuint value)
+{
+	bool bRedundant = (m_bindings[binding] == value);
+	m_bindings[binding] = value;
+	return bRedundant;
+}
+
+/***********************************************************
+ *  SetUniform()
+ *
+ *  This method is used to compare a uniform value with the
+ *  last value set on the same program and location, kept
+ *  as a 64-bit FNV-1a hash of its bytes.
+ ***********************************************************/
+bool GLCallTrace::SetUniform(GLuint programID, GLint location, const void* pValue, size_t size)
+{
+	if ((location < 0) || (pValue == NULL))
+		return false;
+
+	unsigned long long hash = 14695981039346656037ull;
+	const unsigned char* pBytes = (const unsigned char*)pValue;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= pBytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	unsigned long long key = ((unsigned long long)programID << 32) | (unsigned int)location;
+	std::unordered_map<unsigned long long, unsigned long long>::iterator it = m_uniformValues.find(key);
+	if (it == m_uniformValues.end())
+	{
+		m_uniformValues[key] = hash;
+		return false;
+	}
+
+	bool bRedundant = (it->second == hash);
+	it->second = hash;
+	return bRedundant;
+}
+
+/***********************************************************
+ *  EndFrame()
+ ***********************************************************/
+void GLCallTrace::EndFrame()
+{
+	if (m_bInstalled == false)
+		return;
+
+	m_frameCount++;
+	if (m_traceFile.is_open() == true)
+	{
+		m_traceBuffer.push_back(g_TraceFrameEnd);
+		m_traceFile.write((const char*)m_traceBuffer.data(), m_traceBuffer.size());
+		m_traceBuffer.clear();
+	}
+
+	double now = glfwGetTime();
+	if (now - m_lastReportTime >= g_ReportInterval)
+	{
+		Report(now);
+	}
+}
+
+/***********************************************************
+ *  Report()
+ ***********************************************************/
+void GLCallTrace::Report(double now)
+{
+	if (m_frameCount > 0)
+	{
+		unsigned long long typeCalls[CALL_TYPE_COUNT] = {};
+		unsigned long long typeRedundant[CALL_TYPE_COUNT] = {};
+		unsigned long long totalCalls = 0;
+		unsigned long long totalRedundant = 0;
+		for (int i = 0; i < FUNC_COUNT; i++)
+		{
+			typeCalls[g_FunctionInfo[i].type] += m_callCounts[i];
+			typeRedundant[g_FunctionInfo[i].type] += m_redundantCounts[i];
+			totalCalls += m_callCounts[i];
+			totalRedundant += m_redundantCounts[i];
+		}
+
+		std::cout << "INFO: GL calls per frame " << (double)totalCalls / m_frameCount
+			<< ", redundant " << (double)totalRedundant / m_frameCount << std::endl;
+		for (int type = 0; type < CALL_TYPE_COUNT; type++)
+		{
+			if (typeCalls[type] == 0)
+				continue;
+			std::cout << "INFO:   " << g_CallTypeNames[type] << " "
+				<< (double)typeCalls[type] / m_frameCount << ", redundant "
+				<< (double)typeRedundant[type] / m_frameCount << std::endl;
+		}
+	}
+
+	for (int i = 0; i < MAX_FUNCTIONS; i++)
+	{
+		m_callCounts[i] = 0;
+		m_redundantCounts[i] = 0;
+	}
+	m_frameCount = 0;
+	m_lastReportTime = now;
+}
+
+/***********************************************************
+ *  ReadTrace()
+ ***********************************************************/
+bool GLCallTrace::ReadTrace(const char* filename, TRACE_SUMMARY& summary)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "ERROR: Could not open GL trace file " << filename << std::endl;
+		return false;
+	}
+
+	char magic[4] = {};
+	file.read(magic, sizeof(magic));
+	int version = file.get();
+	int functionCount = file.get();
+	if (!file || (memcmp(magic, g_TraceMagic, sizeof(magic)) != 0) ||
+		(version != g_TraceVersion) || (functionCount >= g_TraceFrameEnd))
+	{
+		std::cout << "ERROR: " << filename << " is not a GL trace" << std::endl;
+		return false;
+	}
+
+	summary.names.clear();
+	for (int i = 0; i < functionCount; i++)
+	{
+		int length = file.get();
+		std::string name(length > 0 ? length : 0, ' ');
+		file.read(&name[0], name.size());
+		summary.names.push_back(name);
+	}
+	summary.calls.assign(functionCount, 0);
+	summary.redundant.assign(functionCount, 0);
+	summary.frames = 0;
+
+	int value = 0;
+	while ((value = file.get()) != EOF)
+	{
+		if (value == g_TraceFrameEnd)
+		{
+			summary.frames++;
+			continue;
+		}
+		int function = value & ~g_TraceRedundantFlag;
+		if (function >= functionCount)
+			continue;
+		summary.calls[function]++;
+		if (value & g_TraceRedundantFlag)
+			summary.redundant[function]++;
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  Summarize()
+ *
+ *  This method is used to print the calls per frame of each
+ *  function in a trace. Given a second trace, for example
+ *  from another build, functions are matched by name and
+ *  printed side by side with the change.
+ ***********************************************************/
+bool GLCallTrace::Summarize(const char* filename, const char* compareFilename)
+{
+	TRACE_SUMMARY summary;
+	if (ReadTrace(filename, summary) == false)
+		return false;
+	double frames = (summary.frames > 0) ? (double)summary.frames : 1.0;
+
+	if (compareFilename == NULL)
+	{
+		std::cout << filename << ": " << summary.frames << " frames" << std::endl;
+		for (size_t i = 0; i < summary.names.size(); i++)
+		{
+			if (summary.calls[i] == 0)
+				continue;
+			std::cout << "  " << summary.names[i] << ": " << summary.calls[i] / frames
+				<< " per frame, " << summary.redundant[i] / frames << " redundant" << std::endl;
+		}
+		return true;
+	}
+
+	TRACE_SUMMARY other;
+	if (ReadTrace(compareFilename, other) == false)
+		return false;
+	double otherFrames = (other.frames > 0) ? (double)other.frames : 1.0;
+
+	std::cout << filename << " (" << summary.frames << " frames) -> "
+		<< compareFilename << " (" << other.frames << " frames), calls per frame" << std::endl;
+
+	// functions of the first trace, then any only in the second
+	std::vector<std::string> names = summary.names;
+	for (const std::string& name : other.names)
+	{
+		if (std::find(names.begin(), names.end(), name) == names.end())
+			names.push_back(name);
+	}
+
+	for (const std::string& name : names)
+	{
+		double before = 0.0;
+		double after = 0.0;
+		for (size_t i = 0; i < summary.names.size(); i++)
+		{
+			if (summary.names[i] == name)
+				before = summary.calls[i] / frames;
+		}
+		for (size_t i = 0; i < other.names.size(); i++)
+		{
+			if (other.names[i] == name)
+				after = other.calls[i] / otherFrames;
+		}
+		if ((before == 0.0) && (after == 0.0))
+			continue;
+
+		std::cout << "  " << name << ": " << before << " -> " << after
+			<< " (" << ((after >= before) ? "+" : "") << after - before << ")" << std::endl;
+	}
+
+	return true;
+}
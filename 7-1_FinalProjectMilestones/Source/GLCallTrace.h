@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+// glcalltrace.h
+// ============
+// interception of OpenGL calls for per-frame call statistics and traces
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************
+ *  GLCallTrace
+ *
+ *  This class swaps the GLEW function pointers of the GL
+ *  entry points the engine uses for wrappers that count
+ *  each call before passing it on. Binds of what is already
+ *  bound and uniform values that are already set are
+ *  flagged as redundant. The counts are reported per frame
+ *  on the console, and every call can also be written to a
+ *  compact binary trace, one byte per call, that
+ *  Summarize() turns into per-frame totals or a comparison
+ *  of two traces.
+ ***********************************************************/
+class GLCallTrace
+{
+public:
+	// constructor
+	GLCallTrace();
+	// destructor
+	~GLCallTrace();
+
+	// kinds of calls the statistics are grouped by
+	enum CALL_TYPE
+	{
+		CALL_PROGRAM,
+		CALL_UNIFORM,
+		CALL_TEXTURE,
+		CALL_BUFFER,
+		CALL_VERTEX_ARRAY,
+		CALL_FRAMEBUFFER,
+		CALL_DRAW,
+		CALL_QUERY,
+		CALL_SYNC,
+		CALL_TYPE_COUNT
+	};
+
+	// bindings tracked for redundant call detection
+	enum BINDING
+	{
+		BINDING_PROGRAM,
+		BINDING_VERTEX_ARRAY,
+		BINDING_ARRAY_BUFFER,
+		BINDING_INDIRECT_BUFFER,
+		BINDING_STORAGE_BUFFER,
+		BINDING_UNIFORM_BUFFER,
+		BINDING_READ_FRAMEBUFFER,
+		BINDING_DRAW_FRAMEBUFFER,
+		BINDING_ACTIVE_TEXTURE,
+		BINDING_COUNT
+	};
+
+	// most intercepted functions a trace can describe
+	static const int MAX_FUNCTIONS = 64;
+
+	// swap in the wrappers, once GLEW is initialized
+	void Install();
+	// put the original function pointers back
+	void Uninstall();
+	bool IsInstalled() const { return m_bInstalled; }
+
+	// write every intercepted call to a trace file
+	bool StartTrace(const char* filename);
+	void StopTrace();
+
+	// close the frame's counts and write its end to the trace
+	void EndFrame();
+
+	// print per-frame totals of a trace, or compare it to a
+	// second trace when one is given
+	static bool Summarize(const char* filename, const char* compareFilename);
+
+	// used by the wrappers: count a call, which is redundant
+	// when it changes nothing
+	void RecordCall(int function, bool bRedundant);
+	// used by the wrappers: set a tracked binding, returning
+	// whether it already had the value
+	bool SetBinding(BINDING binding, GLuint value);
+	// used by the wrappers: set a uniform of a program,
+	// returning whether it already had the value
+	bool SetUniform(GLuint programID, GLint location, const void* pValue, size_t size);
+	GLuint GetCurrentProgram() const { return m_bindings[BINDING_PROGRAM]; }
+
+private:
+	// per-function counts read back from a trace file
+	struct TRACE_SUMMARY
+	{
+		std::vector<std::string> names;
+		std::vector<unsigned long long> calls;
+		std::vector<unsigned long long> redundant;
+		unsigned long long frames;
+	};
+
+	bool m_bInstalled;
+	GLuint m_bindings[BINDING_COUNT];
+	// hash of the last value of each program and location
+	std::unordered_map<unsigned long long, unsigned long long> m_uniformValues;
+
+	// calls since the last report
+	unsigned long long m_callCounts[MAX_FUNCTIONS];
+	unsigned long long m_redundantCounts[MAX_FUNCTIONS];
+	int m_frameCount;
+	double m_lastReportTime;
+
+	// trace file and the calls of the frame not written yet
+	std::ofstream m_traceFile;
+	std::vector<unsigned char> m_traceBuffer;
+
+	// print and reset the per-frame statistics
+	void Report(double now);
+	static bool ReadTrace(const char* filename, TRACE_SUMMARY& summary);
+};
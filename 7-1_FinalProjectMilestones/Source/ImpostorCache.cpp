@@ -0,0 +1,467 @@
+///////////////////////////////////////////////////////////////////////////////
+// impostorcache.cpp
+// ============
+// multi-angle billboard impostors for distant compound props
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ImpostorCache.h"
+#include "ResourceAccounting.h"
+#include "ResourceCache.h"
+
+#include <iostream>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// declaration of global variables
+namespace
+{
+	// the quad is generated from the vertex index, so no
+	// vertex buffer is needed
+	const char* g_BillboardVertexShader =
+		"#version 330 core\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 projection;\n"
+		"uniform vec3 center;\n"
+		"uniform vec3 right;\n"
+		"uniform vec3 up;\n"
+		"uniform vec4 cellRect;\n"
+		"out vec2 atlasCoordinate;\n"
+		"void main()\n"
+		"{\n"
+		"	vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));\n"
+		"	atlasCoordinate = cellRect.xy + corner * cellRect.zw;\n"
+		"	vec3 position = center + right * (corner.x * 2.0 - 1.0) + up * (corner.y * 2.0 - 1.0);\n"
+		"	gl_Position = projection * view * vec4(position, 1.0);\n"
+		"}\n";
+
+	// the atlas holds premultiplied color, so fading scales
+	// every channel
+	const char* g_BillboardFragmentShader =
+		"#version 330 core\n"
+		"uniform sampler2D impostorTexture;\n"
+		"uniform float fade;\n"
+		"in vec2 atlasCoordinate;\n"
+		"out vec4 outFragmentColor;\n"
+		"void main()\n"
+		"{\n"
+		"	vec4 color = texture(impostorTexture, atlasCoordinate) * fade;\n"
+		"	if (color.a < 0.01)\n"
+		"		discard;\n"
+		"	outFragmentColor = color;\n"
+		"}\n";
+
+	// default fade band, in prop radii from the camera
+	const float g_DefaultFadeStart = 12.0f;
+	const float g_DefaultFadeEnd = 16.0f;
+
+	// highest capture direction above the horizon, in degrees
+	const float g_MaxElevation = 60.0f;
+
+	// room around the bounding sphere in each captured view
+	const float g_CaptureMargin = 1.05f;
+}
+
+/***********************************************************
+ *  ImpostorCache()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ImpostorCache::ImpostorCache()
+{
+	m_fadeStart = g_DefaultFadeStart;
+	m_fadeEnd = g_DefaultFadeEnd;
+
+	m_programID = 0;
+	m_vertexArrayID = 0;
+	m_viewLocation = -1;
+	m_projectionLocation = -1;
+	m_centerLocation = -1;
+	m_rightLocation = -1;
+	m_upLocation = -1;
+	m_cellRectLocation = -1;
+	m_fadeLocation = -1;
+	m_textureLocation = -1;
+
+	m_framebufferID = 0;
+	m_depthRenderbufferID = 0;
+}
+
+/***********************************************************
+ *  ~ImpostorCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ImpostorCache::~ImpostorCache()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to build the billboard program and
+ *  the framebuffer the atlases are captured through.
+ ***********************************************************/
+bool ImpostorCache::Initialize(ShaderProgramCache* pProgramCache)
+{
+	if (pProgramCache == NULL)
+		return false;
+
+	m_programID = pProgramCache->BuildProgram(g_BillboardVertexShader, g_BillboardFragmentShader, "");
+	if (m_programID == 0)
+		return false;
+
+	m_viewLocation = glGetUniformLocation(m_programID, "view");
+	m_projectionLocation = glGetUniformLocation(m_programID, "projection");
+	m_centerLocation = glGetUniformLocation(m_programID, "center");
+	m_rightLocation = glGetUniformLocation(m_programID, "right");
+	m_upLocation = glGetUniformLocation(m_programID, "up");
+	m_cellRectLocation = glGetUniformLocation(m_programID, "cellRect");
+	m_fadeLocation = glGetUniformLocation(m_programID, "fade");
+	m_textureLocation = glGetUniformLocation(m_programID, "impostorTexture");
+
+	glGenVertexArrays(1, &m_vertexArrayID);
+
+	glGenRenderbuffers(1, &m_depthRenderbufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, GetAtlasWidth(), GetAtlasHeight());
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &m_framebufferID);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbufferID);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	// the depth is only needed while capturing
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_RENDER_TARGET, "impostor capture",
+		(unsigned long long)GetAtlasWidth() * GetAtlasHeight() * 4, 0);
+
+	return true;
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void ImpostorCache::Destroy()
+{
+	for (IMPOSTOR_PROP& prop : m_props)
+	{
+		if (prop.textureID != 0)
+		{
+			glDeleteTextures(1, &prop.textureID);
+			prop.textureID = 0;
+			ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_TEXTURE, "impostor " + prop.name);
+		}
+		prop.bCaptured = false;
+	}
+	if (m_programID != 0)
+	{
+		ResourceCache::ReleaseProgram(m_programID);
+		m_programID = 0;
+	}
+	if (m_vertexArrayID != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArrayID);
+		m_vertexArrayID = 0;
+	}
+	if (m_framebufferID != 0)
+	{
+		glDeleteFramebuffers(1, &m_framebufferID);
+		m_framebufferID = 0;
+	}
+	if (m_depthRenderbufferID != 0)
+	{
+		glDeleteRenderbuffers(1, &m_depthRenderbufferID);
+		m_depthRenderbufferID = 0;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_RENDER_TARGET, "impostor capture");
+	}
+}
+
+/***********************************************************
+ *  AddProp()
+ ***********************************************************/
+int ImpostorCache::AddProp(const char* name)
+{
+	IMPOSTOR_PROP prop;
+	prop.name = name;
+	prop.textureID = 0;
+	prop.key = 0;
+	prop.bCaptured = false;
+	prop.center = glm::vec3(0.0f);
+	prop.radius = 0.0f;
+	prop.fade = 0.0f;
+	prop.bVisible = false;
+	m_props.push_back(prop);
+	return (int)m_props.size() - 1;
+}
+
+/***********************************************************
+ *  FindProp()
+ ***********************************************************/
+int ImpostorCache::FindProp(const char* name) const
+{
+	for (int prop = 0; prop < (int)m_props.size(); prop++)
+	{
+		if (m_props[prop].name.compare(name) == 0)
+			return(prop);
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  SetFadeRange()
+ ***********************************************************/
+void ImpostorCache::SetFadeRange(float start, float end)
+{
+	if ((start > 1.0f) && (end > start))
+	{
+		m_fadeStart = start;
+		m_fadeEnd = end;
+	}
+}
+
+/***********************************************************
+ *  UpdateProp()
+ *
+ *  This method is used to fit the prop's bounding sphere
+ *  and fade the quad in between the start and end of the
+ *  band, both relative to the sphere's radius so larger
+ *  props switch further away.
+ ***********************************************************/
+void ImpostorCache::UpdateProp(int prop, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+	const glm::vec3& cameraPosition)
+{
+	IMPOSTOR_PROP& impostor = m_props[prop];
+	impostor.center = (boundsMin + boundsMax) * 0.5f;
+	impostor.radius = glm::length(boundsMax - boundsMin) * 0.5f;
+	impostor.bVisible = false;
+	impostor.fade = 0.0f;
+	if (impostor.radius <= 0.0f)
+		return;
+
+	float distance = glm::length(cameraPosition - impostor.center);
+	float fade = (distance - m_fadeStart * impostor.radius) /
+		((m_fadeEnd - m_fadeStart) * impostor.radius);
+	impostor.fade = glm::clamp(fade, 0.0f, 1.0f);
+}
+
+/***********************************************************
+ *  HideProp()
+ ***********************************************************/
+void ImpostorCache::HideProp(int prop)
+{
+	m_props[prop].fade = 0.0f;
+	m_props[prop].bVisible = false;
+}
+
+/***********************************************************
+ *  NeedsCapture()
+ ***********************************************************/
+bool ImpostorCache::NeedsCapture(int prop, unsigned long long key) const
+{
+	return (m_props[prop].bCaptured == false) || (m_props[prop].key != key);
+}
+
+/***********************************************************
+ *  BeginCapture()
+ *
+ *  This method is used to attach the prop's atlas to the
+ *  capture framebuffer and clear it to transparent black.
+ *  Color is blended in premultiplied, so the transparent
+ *  texels stay black and the mipmaps do not darken edges.
+ ***********************************************************/
+void ImpostorCache::BeginCapture(int prop)
+{
+	IMPOSTOR_PROP& impostor = m_props[prop];
+	if (impostor.textureID == 0)
+	{
+		glGenTextures(1, &impostor.textureID);
+		glBindTexture(GL_TEXTURE_2D, impostor.textureID);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, GetAtlasWidth(), GetAtlasHeight(), 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		ResourceAccounting::Track(ResourceAccounting::CATEGORY_TEXTURE, "impostor " + impostor.name,
+			ResourceAccounting::GetTextureBytes(GetAtlasWidth(), GetAtlasHeight(), 4,
+				ResourceAccounting::FULL_MIP_CHAIN), 0);
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebufferID);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, impostor.textureID, 0);
+	glViewport(0, 0, GetAtlasWidth(), GetAtlasHeight());
+	const GLfloat transparent[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	glClearBufferfv(GL_COLOR, 0, transparent);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+/***********************************************************
+ *  GetCaptureView()
+ *
+ *  The camera is orthographic and fitted to the bounding
+ *  sphere, so every cell shows the prop at the same size
+ *  and the quad can be sized from the radius alone.
+ ***********************************************************/
+CameraBuffer::CAMERA_VIEW ImpostorCache::GetCaptureView(int prop, int cell) const
+{
+	const IMPOSTOR_PROP& impostor = m_props[prop];
+	glm::vec3 direction = GetCellDirection(cell);
+	float extent = impostor.radius * g_CaptureMargin;
+
+	CameraBuffer::CAMERA_VIEW view;
+	view.position = impostor.center + direction * (impostor.radius * 2.0f);
+	view.view = glm::lookAt(view.position, impostor.center, glm::vec3(0.0f, 1.0f, 0.0f));
+	view.projection = glm::ortho(-extent, extent, -extent, extent,
+		impostor.radius * 0.5f, impostor.radius * 3.5f);
+	view.viewport = GetCellRect(cell);
+	return(view);
+}
+
+/***********************************************************
+ *  EndCapture()
+ ***********************************************************/
+void ImpostorCache::EndCapture(int prop, unsigned long long key)
+{
+	IMPOSTOR_PROP& impostor = m_props[prop];
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glBindTexture(GL_TEXTURE_2D, impostor.textureID);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	impostor.key = key;
+	impostor.bCaptured = true;
+	std::cout << "INFO: Captured impostor " << impostor.name << " (" << CELL_COUNT << " views)" << std::endl;
+}
+
+/***********************************************************
+ *  Draw()
+ *
+ *  This method is used to draw each faded in prop as a quad
+ *  facing the camera. The quad is moved to the front of the
+ *  bounding sphere, so surfaces passing through the prop do
+ *  not cut it, and shrunk to keep its size on screen.
+ ***********************************************************/
+bool ImpostorCache::Draw(const glm::mat4& view, const glm::mat4& projection,
+	const glm::vec3& cameraPosition, int textureUnit)
+{
+	if ((m_programID == 0) || (textureUnit < 0))
+		return false;
+
+	bool bDrawn = false;
+	for (const IMPOSTOR_PROP& impostor : m_props)
+	{
+		if ((impostor.bCaptured == false) || (impostor.bVisible == false) || (impostor.fade <= 0.0f))
+			continue;
+
+		glm::vec3 toCamera = cameraPosition - impostor.center;
+		float distance = glm::length(toCamera);
+		if (distance <= impostor.radius)
+			continue;
+		glm::vec3 direction = toCamera / distance;
+
+		if (bDrawn == false)
+		{
+			glUseProgram(m_programID);
+			glUniformMatrix4fv(m_viewLocation, 1, GL_FALSE, glm::value_ptr(view));
+			glUniformMatrix4fv(m_projectionLocation, 1, GL_FALSE, glm::value_ptr(projection));
+			glUniform1i(m_textureLocation, textureUnit);
+			glBindVertexArray(m_vertexArrayID);
+			glActiveTexture(GL_TEXTURE0 + textureUnit);
+			glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			bDrawn = true;
+		}
+
+		glm::vec3 right;
+		glm::vec3 up;
+		GetFacingAxes(direction, right, up);
+		float halfSize = impostor.radius * g_CaptureMargin * (distance - impostor.radius) / distance;
+
+		glBindTexture(GL_TEXTURE_2D, impostor.textureID);
+		glUniform3fv(m_centerLocation, 1, glm::value_ptr(impostor.center + direction * impostor.radius));
+		glUniform3fv(m_rightLocation, 1, glm::value_ptr(right * halfSize));
+		glUniform3fv(m_upLocation, 1, glm::value_ptr(up * halfSize));
+		glUniform4fv(m_cellRectLocation, 1, glm::value_ptr(GetCellRect(FindCell(direction))));
+		glUniform1f(m_fadeLocation, impostor.fade);
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	}
+
+	if (bDrawn == true)
+	{
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glActiveTexture(GL_TEXTURE0);
+		glBindVertexArray(0);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	return(bDrawn);
+}
+
+/***********************************************************
+ *  GetCellDirection()
+ ***********************************************************/
+glm::vec3 ImpostorCache::GetCellDirection(int cell)
+{
+	float azimuth = glm::radians(360.0f * (cell % AZIMUTH_COUNT) / AZIMUTH_COUNT);
+	float elevation = glm::radians(g_MaxElevation * (cell / AZIMUTH_COUNT) / (ELEVATION_COUNT - 1));
+	return glm::vec3(
+		std::cos(elevation) * std::sin(azimuth),
+		std::sin(elevation),
+		std::cos(elevation) * std::cos(azimuth));
+}
+
+/***********************************************************
+ *  FindCell()
+ ***********************************************************/
+int ImpostorCache::FindCell(const glm::vec3& direction)
+{
+	float azimuthStep = 360.0f / AZIMUTH_COUNT;
+	float azimuth = glm::degrees(std::atan2(direction.x, direction.z));
+	int column = (int)std::floor(azimuth / azimuthStep + 0.5f);
+	column = ((column % AZIMUTH_COUNT) + AZIMUTH_COUNT) % AZIMUTH_COUNT;
+
+	float elevationStep = g_MaxElevation / (ELEVATION_COUNT - 1);
+	float elevation = glm::degrees(std::asin(glm::clamp(direction.y, -1.0f, 1.0f)));
+	int row = (int)std::floor(elevation / elevationStep + 0.5f);
+	row = glm::clamp(row, 0, ELEVATION_COUNT - 1);
+
+	return row * AZIMUTH_COUNT + column;
+}
+
+/***********************************************************
+ *  GetCellRect()
+ ***********************************************************/
+glm::vec4 ImpostorCache::GetCellRect(int cell)
+{
+	return glm::vec4(
+		(float)(cell % AZIMUTH_COUNT) / AZIMUTH_COUNT,
+		(float)(cell / AZIMUTH_COUNT) / ELEVATION_COUNT,
+		1.0f / AZIMUTH_COUNT,
+		1.0f / ELEVATION_COUNT);
+}
+
+/***********************************************************
+ *  GetFacingAxes()
+ *
+ *  This method is used to match the camera orientation of
+ *  glm::lookAt() with the world up vector, falling back to
+ *  the x axis when looking straight down.
+ ***********************************************************/
+void ImpostorCache::GetFacingAxes(const glm::vec3& direction, glm::vec3& right, glm::vec3& up)
+{
+	right = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), direction);
+	if (glm::length(right) < 0.0001f)
+		right = glm::vec3(1.0f, 0.0f, 0.0f);
+	right = glm::normalize(right);
+	up = glm::cross(direction, right);
+}
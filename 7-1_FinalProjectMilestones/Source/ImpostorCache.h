@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+// impostorcache.h
+// ============
+// multi-angle billboard impostors for distant compound props
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+#include "ShaderProgramCache.h"
+#include "CameraBuffer.h"
+
+/***********************************************************
+ *  ImpostorCache
+ *
+ *  This class replaces props made of many draws with one
+ *  camera facing quad once they are far enough away. Each
+ *  prop is captured into an atlas of views from a ring of
+ *  directions at a few heights, and the quad shows the view
+ *  closest to the camera's direction. Over a band of
+ *  distances the quad fades in over the full geometry,
+ *  which is dropped once the quad is opaque.
+ *
+ *  A capture is kept until the key of the prop's draws
+ *  changes, so props are only captured again after they
+ *  are moved, retextured or relit.
+ ***********************************************************/
+class ImpostorCache
+{
+public:
+	// constructor
+	ImpostorCache();
+	// destructor
+	~ImpostorCache();
+
+	// directions captured around the prop and heights above it
+	static const int AZIMUTH_COUNT = 8;
+	static const int ELEVATION_COUNT = 3;
+	static const int CELL_COUNT = AZIMUTH_COUNT * ELEVATION_COUNT;
+	// texels along each side of one captured view
+	static const int CELL_SIZE = 128;
+
+	// build the billboard program
+	bool Initialize(ShaderProgramCache* pProgramCache);
+	// free the program and every captured atlas
+	void Destroy();
+	bool IsAvailable() const { return m_programID != 0; }
+
+	// register a compound prop, returning its index
+	int AddProp(const char* name);
+	int GetPropCount() const { return (int)m_props.size(); }
+	// index of the prop with a name, or -1 if there is none
+	int FindProp(const char* name) const;
+
+	// distances, in prop radii, over which the quad fades in
+	void SetFadeRange(float start, float end);
+
+	// place a prop for this frame and update its fade from the
+	// camera distance, hiding it until it is marked visible
+	void UpdateProp(int prop, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+		const glm::vec3& cameraPosition);
+	// keep a prop on its full geometry this frame
+	void HideProp(int prop);
+	void SetVisible(int prop) { m_props[prop].bVisible = true; }
+	// share of the quad over the geometry, 1 once the
+	// geometry is no longer drawn
+	float GetFade(int prop) const { return m_props[prop].fade; }
+	// whether the prop has no capture for its draws' key
+	bool NeedsCapture(int prop, unsigned long long key) const;
+
+	// bind and clear the prop's atlas for capturing
+	void BeginCapture(int prop);
+	// camera looking at the prop from one cell's direction,
+	// with the cell's area of the atlas as its viewport
+	CameraBuffer::CAMERA_VIEW GetCaptureView(int prop, int cell) const;
+	// size of an atlas, for placing the capture viewports
+	int GetAtlasWidth() const { return AZIMUTH_COUNT * CELL_SIZE; }
+	int GetAtlasHeight() const { return ELEVATION_COUNT * CELL_SIZE; }
+	// finish the atlas and remember the key it was captured for
+	void EndCapture(int prop, unsigned long long key);
+
+	// draw the quad of every visible prop that has faded in,
+	// returning whether anything was drawn
+	bool Draw(const glm::mat4& view, const glm::mat4& projection,
+		const glm::vec3& cameraPosition, int textureUnit);
+
+private:
+	struct IMPOSTOR_PROP
+	{
+		std::string name;
+		// atlas of captured views and the key it shows
+		GLuint textureID;
+		unsigned long long key;
+		bool bCaptured;
+		// bounding sphere for this frame
+		glm::vec3 center;
+		float radius;
+		float fade;
+		bool bVisible;
+	};
+
+	std::vector<IMPOSTOR_PROP> m_props;
+	// fade band in prop radii
+	float m_fadeStart;
+	float m_fadeEnd;
+
+	// billboard program and the empty vertex array its quad
+	// is generated from
+	GLuint m_programID;
+	GLuint m_vertexArrayID;
+	GLint m_viewLocation;
+	GLint m_projectionLocation;
+	GLint m_centerLocation;
+	GLint m_rightLocation;
+	GLint m_upLocation;
+	GLint m_cellRectLocation;
+	GLint m_fadeLocation;
+	GLint m_textureLocation;
+
+	// framebuffer the atlases are captured through
+	GLuint m_framebufferID;
+	GLuint m_depthRenderbufferID;
+
+	// direction from the prop toward a cell's camera
+	static glm::vec3 GetCellDirection(int cell);
+	// cell whose direction is closest to a direction
+	static int FindCell(const glm::vec3& direction);
+	// corner and size of a cell in atlas coordinates
+	static glm::vec4 GetCellRect(int cell);
+	// sides of a quad facing along a direction, the same way
+	// the capture cameras are oriented
+	static void GetFacingAxes(const glm::vec3& direction, glm::vec3& right, glm::vec3& up);
+};
@@ -0,0 +1,400 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightbaker.cpp
+// ============
+// ambient and diffuse lighting of static surfaces baked into a lightmap
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "LightBaker.h"
+#include "ResourceAccounting.h"
+
+#include <iostream>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+// declaration of global variables
+namespace
+{
+	// identifies a lightmap cache file
+	const uint32_t g_CacheFileMagic = 0x50414D4C;	// "LMAP"
+	// changes whenever the baked result would change for the
+	// same surfaces and lights
+	const uint32_t g_BakeVersion = 1;
+
+	// how far outside a triangle, in texture coordinates, a
+	// texel on its edge may fall because of rounding
+	const float g_EdgeTolerance = 0.0001f;
+
+	/***********************************************************
+	 *  HashBytes()
+	 *
+	 *  This function is used to add bytes to a 64 bit FNV-1a
+	 *  hash.
+	 ***********************************************************/
+	unsigned long long HashBytes(unsigned long long hash, const void* pData, size_t size)
+	{
+		const unsigned char* pBytes = (const unsigned char*)pData;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pBytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return(hash);
+	}
+
+	/***********************************************************
+	 *  HashInputs()
+	 ***********************************************************/
+	unsigned long long HashInputs(const std::vector<LightBaker::BAKE_SURFACE>& surfaces,
+		const SCENE_LIGHT* pLights, int lightCount)
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+		int tileSize = LightBaker::TILE_SIZE;
+		hash = HashBytes(hash, &g_BakeVersion, sizeof(g_BakeVersion));
+		hash = HashBytes(hash, &tileSize, sizeof(tileSize));
+		for (const LightBaker::BAKE_SURFACE& surface : surfaces)
+		{
+			hash = HashBytes(hash, &surface.objectID, sizeof(surface.objectID));
+			hash = HashBytes(hash, &surface.mesh, sizeof(surface.mesh));
+			hash = HashBytes(hash, &surface.model[0][0], sizeof(float) * 16);
+		}
+		// the specular color is not baked
+		for (int i = 0; i < lightCount; i++)
+		{
+			hash = HashBytes(hash, &pLights[i].type, sizeof(pLights[i].type));
+			hash = HashBytes(hash, &pLights[i].vector[0], sizeof(float) * 3);
+			hash = HashBytes(hash, &pLights[i].ambient[0], sizeof(float) * 3);
+			hash = HashBytes(hash, &pLights[i].diffuse[0], sizeof(float) * 3);
+		}
+		return(hash);
+	}
+}
+
+/***********************************************************
+ *  LightBaker()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+LightBaker::LightBaker()
+{
+	m_textureID = 0;
+	m_pageSize = 0;
+}
+
+/***********************************************************
+ *  ~LightBaker()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+LightBaker::~LightBaker()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  CanBake()
+ *
+ *  Cylinder caps reuse the texture coordinates of its side
+ *  and the sphere's poles squeeze whole rows into a point,
+ *  so only the flat meshes are baked.
+ ***********************************************************/
+bool LightBaker::CanBake(SceneGeometry::GEOMETRY_MESH mesh)
+{
+	return (mesh >= SceneGeometry::GEOMETRY_PLANE) && (mesh <= SceneGeometry::GEOMETRY_BOX_BOTTOM);
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void LightBaker::Destroy()
+{
+	if (m_textureID != 0)
+	{
+		glDeleteTextures(1, &m_textureID);
+		m_textureID = 0;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_TEXTURE, "lightmap");
+	}
+	m_pageSize = 0;
+	m_tiles.clear();
+	m_tileLookup.clear();
+}
+
+/***********************************************************
+ *  Bake()
+ ***********************************************************/
+bool LightBaker::Bake(const std::vector<BAKE_SURFACE>& surfaces,
+	const SCENE_LIGHT* pLights, int lightCount, const char* cacheFilename)
+{
+	Destroy();
+	if (surfaces.empty())
+		return false;
+
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	PlaceTiles(surfaces);
+
+	unsigned long long key = HashInputs(surfaces, pLights, lightCount);
+	std::vector<glm::vec3> texels;
+	bool bCacheHit = LoadCache(cacheFilename, key, texels);
+	int threadCount = 0;
+	if (bCacheHit == false)
+	{
+		SceneGeometry geometry;
+		geometry.BuildMeshes();
+
+		texels.assign((size_t)m_pageSize * m_pageSize, glm::vec3(0.0f));
+
+		// every tile writes its own texels, so the threads
+		// only share the counter handing out the tiles
+		std::atomic<int> nextTile(0);
+		threadCount = (int)std::thread::hardware_concurrency();
+		if (threadCount < 1)
+			threadCount = 1;
+		if (threadCount > (int)m_tiles.size())
+			threadCount = (int)m_tiles.size();
+
+		std::vector<std::thread> threads;
+		for (int i = 0; i < threadCount; i++)
+		{
+			threads.push_back(std::thread([&]()
+			{
+				for (int tile = nextTile++; tile < (int)m_tiles.size(); tile = nextTile++)
+				{
+					BakeTile(tile, geometry, pLights, lightCount, texels);
+				}
+			}));
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		SaveCache(cacheFilename, key, texels);
+	}
+
+	Upload(texels);
+
+	double milliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "INFO: Lighting of " << m_tiles.size() << " static surfaces ";
+	if (bCacheHit == true)
+		std::cout << "loaded from " << cacheFilename;
+	else
+		std::cout << "baked on " << threadCount << " thread(s)";
+	std::cout << " in " << milliseconds << " ms (" << m_pageSize << "x" << m_pageSize
+		<< " lightmap)" << std::endl;
+
+	return(m_textureID != 0);
+}
+
+/***********************************************************
+ *  PlaceTiles()
+ *
+ *  This method is used to lay the tiles out in a square
+ *  grid. Each tile's rectangle runs between the centers of
+ *  its edge texels, so filtering never reaches a neighbor
+ *  and no guard band is needed.
+ ***********************************************************/
+void LightBaker::PlaceTiles(const std::vector<BAKE_SURFACE>& surfaces)
+{
+	int tilesPerRow = 1;
+	while (tilesPerRow * tilesPerRow < (int)surfaces.size())
+	{
+		tilesPerRow++;
+	}
+	m_pageSize = 1;
+	while (m_pageSize < tilesPerRow * TILE_SIZE)
+	{
+		m_pageSize *= 2;
+	}
+	tilesPerRow = m_pageSize / TILE_SIZE;
+
+	int maxObjectID = -1;
+	for (int i = 0; i < (int)surfaces.size(); i++)
+	{
+		LIGHTMAP_TILE tile;
+		tile.surface = surfaces[i];
+		float cornerX = (float)((i % tilesPerRow) * TILE_SIZE);
+		float cornerY = (float)((i / tilesPerRow) * TILE_SIZE);
+		tile.rect = glm::vec4(
+			(cornerX + 0.5f) / m_pageSize,
+			(cornerY + 0.5f) / m_pageSize,
+			(float)(TILE_SIZE - 1) / m_pageSize,
+			(float)(TILE_SIZE - 1) / m_pageSize);
+		m_tiles.push_back(tile);
+
+		if (surfaces[i].objectID > maxObjectID)
+			maxObjectID = surfaces[i].objectID;
+	}
+
+	m_tileLookup.assign((size_t)(maxObjectID + 1) * SceneGeometry::GEOMETRY_COUNT, -1);
+	for (int i = 0; i < (int)m_tiles.size(); i++)
+	{
+		const BAKE_SURFACE& surface = m_tiles[i].surface;
+		if (surface.objectID >= 0)
+		{
+			m_tileLookup[surface.objectID * SceneGeometry::GEOMETRY_COUNT + surface.mesh] = i;
+		}
+	}
+}
+
+/***********************************************************
+ *  BakeTile()
+ *
+ *  This method is used to light each texel of a tile. The
+ *  texel's texture coordinate is found in one of the mesh's
+ *  triangles, whose corners give the position and normal
+ *  there. The sum matches the ambient and diffuse terms of
+ *  the scene shader, before the material color is applied.
+ ***********************************************************/
+void LightBaker::BakeTile(int tile, const SceneGeometry& geometry,
+	const SCENE_LIGHT* pLights, int lightCount, std::vector<glm::vec3>& texels) const
+{
+	const BAKE_SURFACE& surface = m_tiles[tile].surface;
+	const SceneGeometry::MESH_RANGE& range = geometry.GetRange(surface.mesh);
+	const std::vector<SceneGeometry::VERTEX>& vertices = geometry.GetVertices();
+	const std::vector<GLuint>& indices = geometry.GetIndices();
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(surface.model)));
+
+	int tilesPerRow = m_pageSize / TILE_SIZE;
+	int cornerX = (tile % tilesPerRow) * TILE_SIZE;
+	int cornerY = (tile / tilesPerRow) * TILE_SIZE;
+
+	for (int ty = 0; ty < TILE_SIZE; ty++)
+	{
+		for (int tx = 0; tx < TILE_SIZE; tx++)
+		{
+			glm::vec2 uv((float)tx / (TILE_SIZE - 1), (float)ty / (TILE_SIZE - 1));
+
+			bool bFound = false;
+			glm::vec3 position(0.0f);
+			glm::vec3 normal(0.0f);
+			for (GLuint i = 0; (i + 2 < range.indexCount) && (bFound == false); i += 3)
+			{
+				const SceneGeometry::VERTEX& a = vertices[range.baseVertex + indices[range.firstIndex + i]];
+				const SceneGeometry::VERTEX& b = vertices[range.baseVertex + indices[range.firstIndex + i + 1]];
+				const SceneGeometry::VERTEX& c = vertices[range.baseVertex + indices[range.firstIndex + i + 2]];
+
+				glm::vec2 ab = b.uv - a.uv;
+				glm::vec2 ac = c.uv - a.uv;
+				glm::vec2 ap = uv - a.uv;
+				float denominator = ab.x * ac.y - ac.x * ab.y;
+				if (std::fabs(denominator) < 1e-12f)
+					continue;
+				float s = (ap.x * ac.y - ac.x * ap.y) / denominator;
+				float t = (ab.x * ap.y - ap.x * ab.y) / denominator;
+				float r = 1.0f - s - t;
+				if ((s < -g_EdgeTolerance) || (t < -g_EdgeTolerance) || (r < -g_EdgeTolerance))
+					continue;
+
+				position = a.position * r + b.position * s + c.position * t;
+				normal = a.normal * r + b.normal * s + c.normal * t;
+				bFound = true;
+			}
+			if (bFound == false)
+				continue;
+
+			glm::vec3 worldPosition = glm::vec3(surface.model * glm::vec4(position, 1.0f));
+			glm::vec3 worldNormal = glm::normalize(normalMatrix * normal);
+
+			glm::vec3 light(0.0f);
+			for (int i = 0; i < lightCount; i++)
+			{
+				glm::vec3 lightDirection = (pLights[i].type == SCENE_LIGHT_DIRECTIONAL) ?
+					glm::normalize(-pLights[i].vector) :
+					glm::normalize(pLights[i].vector - worldPosition);
+				float diffuseImpact = std::max(glm::dot(worldNormal, lightDirection), 0.0f);
+				light += pLights[i].ambient + pLights[i].diffuse * diffuseImpact;
+			}
+
+			texels[(size_t)(cornerY + ty) * m_pageSize + cornerX + tx] = light;
+		}
+	}
+}
+
+/***********************************************************
+ *  Upload()
+ *
+ *  Light sums can exceed one, so the lightmap is kept in
+ *  half floats.
+ ***********************************************************/
+void LightBaker::Upload(const std::vector<glm::vec3>& texels)
+{
+	glGenTextures(1, &m_textureID);
+	glBindTexture(GL_TEXTURE_2D, m_textureID);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, m_pageSize, m_pageSize, 0,
+		GL_RGB, GL_FLOAT, texels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// drivers keep three half floats as four
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_TEXTURE, "lightmap",
+		(unsigned long long)m_pageSize * m_pageSize * 8, 0);
+}
+
+/***********************************************************
+ *  FindTile()
+ ***********************************************************/
+int LightBaker::FindTile(int objectID, SceneGeometry::GEOMETRY_MESH mesh, const glm::mat4& model) const
+{
+	if (objectID < 0)
+		return -1;
+
+	size_t lookup = (size_t)objectID * SceneGeometry::GEOMETRY_COUNT + mesh;
+	if (lookup >= m_tileLookup.size())
+		return -1;
+
+	int tile = m_tileLookup[lookup];
+	if ((tile < 0) || (m_tiles[tile].surface.model != model))
+		return -1;
+	return(tile);
+}
+
+/***********************************************************
+ *  LoadCache()
+ ***********************************************************/
+bool LightBaker::LoadCache(const char* filename, unsigned long long key, std::vector<glm::vec3>& texels) const
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	uint32_t magic = 0;
+	uint64_t fileKey = 0;
+	int32_t pageSize = 0;
+	file.read((char*)&magic, sizeof(magic));
+	file.read((char*)&fileKey, sizeof(fileKey));
+	file.read((char*)&pageSize, sizeof(pageSize));
+	if (file.fail() || (magic != g_CacheFileMagic) || (fileKey != key) || (pageSize != m_pageSize))
+		return false;
+
+	texels.resize((size_t)m_pageSize * m_pageSize);
+	file.read((char*)texels.data(), sizeof(glm::vec3) * texels.size());
+	return !file.fail();
+}
+
+/***********************************************************
+ *  SaveCache()
+ ***********************************************************/
+void LightBaker::SaveCache(const char* filename, unsigned long long key, const std::vector<glm::vec3>& texels) const
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return;
+
+	uint64_t fileKey = key;
+	int32_t pageSize = m_pageSize;
+	file.write((const char*)&g_CacheFileMagic, sizeof(g_CacheFileMagic));
+	file.write((const char*)&fileKey, sizeof(fileKey));
+	file.write((const char*)&pageSize, sizeof(pageSize));
+	file.write((const char*)texels.data(), sizeof(glm::vec3) * texels.size());
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+// lightbaker.h
+// ============
+// ambient and diffuse lighting of static surfaces baked into a lightmap
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "SceneGeometry.h"
+#include "SceneFile.h"
+
+/***********************************************************
+ *  LightBaker
+ *
+ *  This class computes the ambient and diffuse terms of the
+ *  scene lights for static flat surfaces, the plane and box
+ *  sides, whose texture coordinates cover each face once.
+ *  Every surface gets a tile of one lightmap texture, baked
+ *  on the CPU by several threads and saved to a cache file,
+ *  so a later run with the same surfaces and lights only
+ *  loads it. The shader then samples the tile and adds the
+ *  view dependent specular term itself.
+ *
+ *  A tile belongs to an object, mesh and model matrix. A
+ *  draw whose object has moved since the bake no longer
+ *  matches its tile and is lit in full instead.
+ ***********************************************************/
+class LightBaker
+{
+public:
+	// constructor
+	LightBaker();
+	// destructor
+	~LightBaker();
+
+	// texels along each side of a surface's tile
+	static const int TILE_SIZE = 32;
+
+	// a static surface to bake
+	struct BAKE_SURFACE
+	{
+		int objectID;
+		SceneGeometry::GEOMETRY_MESH mesh;
+		glm::mat4 model;
+	};
+
+	// whether a mesh has texture coordinates a tile can use
+	static bool CanBake(SceneGeometry::GEOMETRY_MESH mesh);
+
+	// bake the lighting of the surfaces, or load it from the
+	// cache file when it holds the same surfaces and lights,
+	// which are given as the shader receives them
+	bool Bake(const std::vector<BAKE_SURFACE>& surfaces,
+		const SCENE_LIGHT* pLights, int lightCount, const char* cacheFilename);
+	// free the lightmap and forget every tile
+	void Destroy();
+	bool IsAvailable() const { return m_textureID != 0; }
+	GLuint GetTexture() const { return m_textureID; }
+
+	// tile of a surface, or -1 if it was not baked or has
+	// moved since
+	int FindTile(int objectID, SceneGeometry::GEOMETRY_MESH mesh, const glm::mat4& model) const;
+	// corner and size of a tile in lightmap coordinates, to
+	// which the surface's texture coordinates are scaled
+	const glm::vec4& GetTileRect(int tile) const { return m_tiles[tile].rect; }
+
+private:
+	struct LIGHTMAP_TILE
+	{
+		BAKE_SURFACE surface;
+		glm::vec4 rect;
+	};
+
+	GLuint m_textureID;
+	int m_pageSize;
+	std::vector<LIGHTMAP_TILE> m_tiles;
+	// tile of each object and mesh, or -1
+	std::vector<int> m_tileLookup;
+
+	// place the tiles on the smallest page that holds them
+	void PlaceTiles(const std::vector<BAKE_SURFACE>& surfaces);
+	// bake one tile's texels into the page
+	void BakeTile(int tile, const SceneGeometry& geometry,
+		const SCENE_LIGHT* pLights, int lightCount, std::vector<glm::vec3>& texels) const;
+	// create the lightmap texture from the page texels
+	void Upload(const std::vector<glm::vec3>& texels);
+
+	bool LoadCache(const char* filename, unsigned long long key, std::vector<glm::vec3>& texels) const;
+	void SaveCache(const char* filename, unsigned long long key, const std::vector<glm::vec3>& texels) const;
+};
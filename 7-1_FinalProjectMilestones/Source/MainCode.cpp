@@ -9,6 +9,7 @@
 
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <cstring>          // strcmp
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -22,6 +23,13 @@
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
 #include "ShaderManager.h"
+#include "ShaderProgramCache.h"
+#include "FramePacer.h"
+#include "DynamicResolution.h"
+#include "FrameCapture.h"
+#include "AllocationCounter.h"
+#include "GLCallTrace.h"
+#include "ResourceAccounting.h"
 
 // Namespace for declaring global variables
 namespace
@@ -38,6 +46,36 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+	// cache of linked shader program binaries
+	ShaderProgramCache* g_ShaderProgramCache = nullptr;
+	// presentation mode and frame rate control
+	FramePacer* g_FramePacer = nullptr;
+	// offscreen scene rendering at a scaled resolution
+	DynamicResolution* g_DynamicResolution = nullptr;
+	// optional GL call statistics and trace capture
+	GLCallTrace* g_CallTrace = nullptr;
+	// recording of the frames shown in the window
+	FrameCapture* g_FrameCapture = nullptr;
+
+	// GLSL source files for the main shader program
+	const char* const VERTEX_SHADER_FILE = "../../Utilities/shaders/vertexShader.glsl";
+	const char* const FRAGMENT_SHADER_FILE = "../../Utilities/shaders/fragmentShader.glsl";
+
+	// frames still rendered after the last change in on-demand
+	// mode, so results that lag a frame, like occlusion queries,
+	// settle before the loop goes idle
+	const int g_SettleFrameCount = 2;
+	// longest wait for events while idle, so scene file edits
+	// are still picked up
+	const double g_IdleWaitTimeout = 0.5;
+
+	// frames rendered after start-up or a scene or setting
+	// change before frames are expected to stop allocating,
+	// covering shader programs and buffers built on first use
+	const int g_AllocationWarmupFrames = 60;
+	// steady frames checked by --allocation-test when no count
+	// is given after it
+	const int g_AllocationTestFrames = 300;
 }
 
 // Function declarations - all functions that are called manually
@@ -54,6 +92,48 @@ bool InitializeGLEW();
  ***********************************************************/
 int main(int argc, char* argv[])
 {
+	// summarize or compare GL traces without opening a window
+	if ((argc >= 3) && (strcmp(argv[1], "--gl-trace-summary") == 0))
+	{
+		bool bSummarized = GLCallTrace::Summarize(argv[2], (argc >= 4) ? argv[3] : NULL);
+		return(bSummarized ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// time the object hierarchy on generated scenes, also
+	// without a window
+	if ((argc >= 2) && (strcmp(argv[1], "--bvh-benchmark") == 0))
+	{
+		return(SceneBVH::RunBenchmark() ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// check the built-in scene transforms computed when
+	// compiling against the ones glm composes at run time,
+	// failing on any difference
+	if ((argc >= 2) && (strcmp(argv[1], "--verify-transforms") == 0))
+	{
+		return(StaticScene::Verify() ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// --allocation-test [frames] renders the warm-up and then a
+	// number of steady frames, and fails if any of them allocates
+	int allocationTestFrames = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--allocation-test") == 0)
+		{
+			allocationTestFrames = g_AllocationTestFrames;
+			if ((i + 1 < argc) && (atoi(argv[i + 1]) > 0))
+			{
+				allocationTestFrames = atoi(argv[i + 1]);
+			}
+		}
+	}
+	if ((allocationTestFrames > 0) && (AllocationCounter::IsEnabled() == false))
+	{
+		std::cout << "ERROR: The allocation test needs a debug build, which counts allocations" << std::endl;
+		return(EXIT_FAILURE);
+	}
+
 	// if GLFW fails initialization, then terminate the application
 	if (InitializeGLFW() == false)
 	{
@@ -75,20 +155,173 @@ int main(int argc, char* argv[])
 		return(EXIT_FAILURE);
 	}
 
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"../../Utilities/shaders/vertexShader.glsl",
-		"../../Utilities/shaders/fragmentShader.glsl");
+	// load the shader code from the external GLSL files, reusing
+	// the linked program binary from an earlier run when possible
+	double shaderStartTime = glfwGetTime();
+	g_ShaderProgramCache = new ShaderProgramCache("shadercache");
+	GLuint programID = g_ShaderProgramCache->LoadProgram(
+		VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE, "");
+	if (programID != 0)
+	{
+		g_ShaderManager->m_programID = programID;
+	}
+	else
+	{
+		g_ShaderManager->LoadShaders(VERTEX_SHADER_FILE, FRAGMENT_SHADER_FILE);
+	}
 	g_ShaderManager->use();
+	std::cout << "INFO: Shaders ready in "
+		<< (glfwGetTime() - shaderStartTime) * 1000.0 << " ms" << std::endl;
+
+	// low memory setups can cap the texture memory, which has
+	// to be known before the textures are loaded
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "--texture-budget-mb") == 0)
+		{
+			ResourceAccounting::SetTextureBudget(
+				(unsigned long long)(atof(argv[i + 1]) * 1024.0 * 1024.0));
+		}
+	}
 
 	// try to create a new scene manager object and prepare the 3D scene
 	g_SceneManager = new SceneManager(g_ShaderManager);
+	g_SceneManager->SetShaderProgramCache(g_ShaderProgramCache);
 	g_SceneManager->PrepareScene();
 
+	// the built-in scene is drawn unless a scene file is given
+	// with --scene <file>, which then replaces it
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "--scene") == 0)
+		{
+			g_SceneManager->LoadSceneFile(argv[i + 1]);
+		}
+	}
+	g_ViewManager->SetSceneManager(g_SceneManager);
+	g_SceneManager->SetViewLatch(g_ViewManager);
+
+	// the overdraw can be printed without the overdraw view
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--overdraw-stats") == 0)
+		{
+			g_SceneManager->SetOverdrawStats(true);
+		}
+	}
+
+	// present in sync with the display unless changed with F7
+	g_FramePacer = new FramePacer();
+	g_FramePacer->Initialize();
+	g_ViewManager->SetFramePacer(g_FramePacer);
+
+	// GL call statistics are toggled with F11
+	g_CallTrace = new GLCallTrace();
+	g_ViewManager->SetCallTrace(g_CallTrace);
+
+	// dashboard and kiosk setups can start rendering on demand,
+	// and a trace of every GL call can be captured from the start
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--on-demand") == 0)
+		{
+			g_FramePacer->SetOnDemand(true);
+		}
+		else if ((strcmp(argv[i], "--gl-trace") == 0) && (i + 1 < argc))
+		{
+			g_CallTrace->StartTrace(argv[++i]);
+		}
+	}
+
+	// scale the scene resolution to hold the GPU frame time
+	g_DynamicResolution = new DynamicResolution();
+	g_DynamicResolution->Initialize();
+	g_ViewManager->SetDynamicResolution(g_DynamicResolution);
+
+	// frames are recorded with F12, or from the start with
+	// --capture <prefix> for images or --capture-raw <prefix>
+	// for raw video
+	g_FrameCapture = new FrameCapture();
+	g_ViewManager->SetFrameCapture(g_FrameCapture);
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "--capture") == 0)
+		{
+			g_FrameCapture->Start(argv[i + 1], FrameCapture::FORMAT_IMAGE_SEQUENCE);
+		}
+		else if (strcmp(argv[i], "--capture-raw") == 0)
+		{
+			g_FrameCapture->Start(argv[i + 1], FrameCapture::FORMAT_RAW_VIDEO);
+		}
+	}
+
+	// time from launch until the first frame can be drawn
+	std::cout << "INFO: Startup took " << glfwGetTime() * 1000.0 << " ms ("
+		<< g_ShaderProgramCache->GetTotalBuildTime() << " ms building shaders)" << std::endl;
+
 	// loop will keep running until the application is closed 
 	// or until an error has occurred
+	int settleFrames = g_SettleFrameCount;
+	int allocationWarmupFrames = g_AllocationWarmupFrames;
+	int steadyFramesChecked = 0;
+	bool bSteadyFrameAllocated = false;
 	while (!glfwWindowShouldClose(g_Window))
 	{
+		// pick up any edits to the scene file
+		g_SceneManager->CheckSceneReload();
+
+		// convert from 3D object space to 2D view
+		g_ViewManager->PrepareSceneView();
+
+		int framebufferWidth = 0;
+		int framebufferHeight = 0;
+		glfwGetFramebufferSize(g_Window, &framebufferWidth, &framebufferHeight);
+
+		// in on-demand mode, frames are only rendered after the
+		// camera, window or scene changed
+		if (g_SceneManager->IsSceneDirty())
+		{
+			allocationWarmupFrames = g_AllocationWarmupFrames;
+		}
+		if (g_ViewManager->IsViewDirty() || g_SceneManager->IsSceneDirty())
+		{
+			settleFrames = g_SettleFrameCount;
+			g_ViewManager->ClearViewDirty();
+			g_SceneManager->ClearSceneDirty();
+		}
+		bool bRefresh = g_ViewManager->ConsumeRefreshRequest();
+		if (g_FramePacer->IsOnDemand() && (settleFrames <= 0) && (allocationTestFrames == 0))
+		{
+			// repaint a damaged window from the last frame, or
+			// render a new one if it is not available
+			if (bRefresh == true)
+			{
+				if (g_DynamicResolution->PresentLastFrame(framebufferWidth, framebufferHeight) == false)
+				{
+					settleFrames = 1;
+					continue;
+				}
+				glfwSwapBuffers(g_Window);
+			}
+
+			// sleep until something happens
+			glfwWaitEventsTimeout(g_IdleWaitTimeout);
+			g_ViewManager->ResetFrameTimer();
+			g_FramePacer->ResumeAfterIdle();
+			continue;
+		}
+		if (settleFrames > 0)
+		{
+			settleFrames--;
+		}
+
+		// debug builds check that a steady frame does not touch
+		// the heap, from the start of rendering to the blit
+		unsigned long long allocationCount = AllocationCounter::GetCount();
+
+		// render into the scaled target for the current window size
+		g_DynamicResolution->BeginFrame(framebufferWidth, framebufferHeight);
+
 		// Enable z-depth
 		glEnable(GL_DEPTH_TEST);
 
@@ -96,21 +329,64 @@ int main(int argc, char* argv[])
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
+		g_SceneManager->SetViews(
+			g_ViewManager->GetViews(),
+			g_ViewManager->GetViewCount());
 
 		// refresh the 3D scene
 		g_SceneManager->RenderScene();
 
+		// scale the rendered frame up to the window
+		g_DynamicResolution->EndFrame();
+
+		allocationCount = AllocationCounter::GetCount() - allocationCount;
+		if (allocationWarmupFrames > 0)
+		{
+			allocationWarmupFrames--;
+		}
+		else
+		{
+			if (allocationCount > 0)
+			{
+				std::cout << "ERROR: Steady frame made " << allocationCount
+					<< " heap allocations" << std::endl;
+				allocationWarmupFrames = g_AllocationWarmupFrames;
+				bSteadyFrameAllocated = true;
+			}
+			steadyFramesChecked++;
+		}
+
+		// the allocation test stops at the first steady frame
+		// that allocates, or once enough frames were checked
+		if ((allocationTestFrames > 0) &&
+			((bSteadyFrameAllocated == true) || (steadyFramesChecked >= allocationTestFrames)))
+		{
+			glfwSetWindowShouldClose(g_Window, GLFW_TRUE);
+		}
+
+		// queue the readback of the finished frame while it is
+		// still in the back buffer
+		g_FrameCapture->CaptureFrame(framebufferWidth, framebufferHeight);
 
 		// Flips the the back buffer with the front buffer every frame.
 		glfwSwapBuffers(g_Window);
+		g_FramePacer->EndFrame(g_ViewManager->GetFrameInputTime());
+		g_CallTrace->EndFrame();
+
+		// hold the next frame back when the limiter is on, before
+		// reading input so the frame starts with the newest input
+		g_FramePacer->WaitForNextFrame();
 
 		// query the latest GLFW events
 		glfwPollEvents();
 	}
 
 	// clear the allocated manager objects from memory
+	if (NULL != g_FrameCapture)
+	{
+		delete g_FrameCapture;
+		g_FrameCapture = NULL;
+	}
 	if (NULL != g_SceneManager)
 	{
 		delete g_SceneManager;
@@ -126,6 +402,39 @@ int main(int argc, char* argv[])
 		delete g_ShaderManager;
 		g_ShaderManager = NULL;
 	}
+	if (NULL != g_DynamicResolution)
+	{
+		delete g_DynamicResolution;
+		g_DynamicResolution = NULL;
+	}
+	if (NULL != g_FramePacer)
+	{
+		delete g_FramePacer;
+		g_FramePacer = NULL;
+	}
+	if (NULL != g_ShaderProgramCache)
+	{
+		delete g_ShaderProgramCache;
+		g_ShaderProgramCache = NULL;
+	}
+	if (NULL != g_CallTrace)
+	{
+		delete g_CallTrace;
+		g_CallTrace = NULL;
+	}
+
+	// the allocation test fails if a steady frame allocated or
+	// the window was closed before every frame was checked
+	if (allocationTestFrames > 0)
+	{
+		bool bPassed = (bSteadyFrameAllocated == false) && (steadyFramesChecked >= allocationTestFrames);
+		std::cout << "INFO: Allocation test " << (bPassed ? "passed" : "failed") << " after "
+			<< steadyFramesChecked << " steady frames" << std::endl;
+		if (bPassed == false)
+		{
+			exit(EXIT_FAILURE);
+		}
+	}
 
 	// Terminates the program successfully
 	exit(EXIT_SUCCESS); 
@@ -0,0 +1,261 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionculler.cpp
+// ============
+// hardware occlusion queries on object bounds with conditional rendering
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OcclusionCuller.h"
+
+#include <iostream>
+
+#include "GLFW/glfw3.h"
+#include <glm/gtx/transform.hpp>
+
+// declaration of global variables
+namespace
+{
+	// padding added around bounds so flat objects still
+	// rasterize a box with some volume
+	const float g_BoundsPadding = 0.01f;
+
+	// seconds between occlusion reports on the console
+	const double g_ReportInterval = 2.0;
+}
+
+/***********************************************************
+ *  OcclusionCuller()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+OcclusionCuller::OcclusionCuller()
+{
+	m_queryTarget = GL_ANY_SAMPLES_PASSED;
+	m_occludedCount = 0;
+	m_lastReportTime = 0.0;
+}
+
+/***********************************************************
+ *  ~OcclusionCuller()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+OcclusionCuller::~OcclusionCuller()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to pick the query target. The
+ *  conservative target lets the driver answer from coarse
+ *  depth data, which is all a bounding box test needs.
+ ***********************************************************/
+void OcclusionCuller::Initialize()
+{
+	if (GLEW_VERSION_4_3 || GLEW_ARB_ES3_compatibility)
+	{
+		m_queryTarget = GL_ANY_SAMPLES_PASSED_CONSERVATIVE;
+	}
+	else
+	{
+		m_queryTarget = GL_ANY_SAMPLES_PASSED;
+	}
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used to free all the query objects.
+ ***********************************************************/
+void OcclusionCuller::Destroy()
+{
+	for (int i = 0; i < (int)m_objects.size(); i++)
+	{
+		glDeleteQueries(1, &m_objects[i].queryID);
+	}
+	m_objects.clear();
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used to start a new frame. Results from
+ *  the previous frame's queries are counted only if they
+ *  are already available, so this never stalls.
+ ***********************************************************/
+void OcclusionCuller::BeginFrame(int objectCount)
+{
+	int occludedCount = 0;
+	bool bAllAvailable = true;
+
+	for (int i = 0; i < (int)m_objects.size(); i++)
+	{
+		if (m_objects[i].bQueryIssued == false)
+			continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv(m_objects[i].queryID, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+		{
+			bAllAvailable = false;
+			continue;
+		}
+
+		GLuint anySamples = 0;
+		glGetQueryObjectuiv(m_objects[i].queryID, GL_QUERY_RESULT, &anySamples);
+		if (anySamples == 0)
+			occludedCount++;
+	}
+
+	// keep the last complete count while results are pending
+	if (bAllAvailable == true)
+	{
+		m_occludedCount = occludedCount;
+	}
+
+	// object IDs are stable from frame to frame, so queries
+	// are only created when the scene grows
+	while ((int)m_objects.size() < objectCount)
+	{
+		OCCLUSION_OBJECT object;
+		object.queryID = 0;
+		object.bQueryIssued = false;
+		object.bHasBounds = false;
+		glGenQueries(1, &object.queryID);
+		m_objects.push_back(object);
+	}
+	while ((int)m_objects.size() > objectCount)
+	{
+		glDeleteQueries(1, &m_objects.back().queryID);
+		m_objects.pop_back();
+	}
+
+	for (int i = 0; i < (int)m_objects.size(); i++)
+	{
+		m_objects[i].bHasBounds = false;
+	}
+
+	double currentTime = glfwGetTime();
+	if (currentTime - m_lastReportTime >= g_ReportInterval)
+	{
+		std::cout << "INFO: Occluded objects: " << m_occludedCount
+			<< " of " << m_objects.size() << std::endl;
+		m_lastReportTime = currentTime;
+	}
+}
+
+/***********************************************************
+ *  AddBounds()
+ *
+ *  This method is used to grow the bounds of an object by
+ *  the world space bounds of one of its draws.
+ ***********************************************************/
+void OcclusionCuller::AddBounds(int objectID, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+	if ((objectID < 0) || (objectID >= (int)m_objects.size()))
+		return;
+
+	OCCLUSION_OBJECT& object = m_objects[objectID];
+	if (object.bHasBounds == false)
+	{
+		object.boundsMin = boundsMin;
+		object.boundsMax = boundsMax;
+		object.bHasBounds = true;
+	}
+	else
+	{
+		object.boundsMin = glm::min(object.boundsMin, boundsMin);
+		object.boundsMax = glm::max(object.boundsMax, boundsMax);
+	}
+}
+
+/***********************************************************
+ *  BeginConditionalDraw()
+ *
+ *  This method is used to start drawing an object under
+ *  conditional rendering. GL_QUERY_NO_WAIT draws the object
+ *  anyway when the result has not arrived yet. Objects the
+ *  camera is inside of are always drawn, since the near
+ *  plane clips their bounding box away.
+ ***********************************************************/
+bool OcclusionCuller::BeginConditionalDraw(int objectID, const glm::vec3& cameraPosition)
+{
+	if ((objectID < 0) || (objectID >= (int)m_objects.size()))
+		return false;
+
+	const OCCLUSION_OBJECT& object = m_objects[objectID];
+	if (object.bQueryIssued == false)
+		return false;
+
+	glm::vec3 padding(g_BoundsPadding * 10.0f);
+	glm::vec3 nearMin = object.boundsMin - padding;
+	glm::vec3 nearMax = object.boundsMax + padding;
+	if ((cameraPosition.x >= nearMin.x) && (cameraPosition.x <= nearMax.x) &&
+		(cameraPosition.y >= nearMin.y) && (cameraPosition.y <= nearMax.y) &&
+		(cameraPosition.z >= nearMin.z) && (cameraPosition.z <= nearMax.z))
+	{
+		return false;
+	}
+
+	glBeginConditionalRender(object.queryID, GL_QUERY_NO_WAIT);
+	return true;
+}
+
+/***********************************************************
+ *  EndConditionalDraw()
+ ***********************************************************/
+void OcclusionCuller::EndConditionalDraw()
+{
+	glEndConditionalRender();
+}
+
+/***********************************************************
+ *  BeginBoundsQuery()
+ *
+ *  This method is used to start the query for an object,
+ *  before its bounding box is drawn.
+ ***********************************************************/
+bool OcclusionCuller::BeginBoundsQuery(int objectID)
+{
+	if ((objectID < 0) || (objectID >= (int)m_objects.size()))
+		return false;
+
+	OCCLUSION_OBJECT& object = m_objects[objectID];
+	if (object.bHasBounds == false)
+	{
+		object.bQueryIssued = false;
+		return false;
+	}
+
+	glBeginQuery(m_queryTarget, object.queryID);
+	object.bQueryIssued = true;
+	return true;
+}
+
+/***********************************************************
+ *  EndBoundsQuery()
+ ***********************************************************/
+void OcclusionCuller::EndBoundsQuery()
+{
+	glEndQuery(m_queryTarget);
+}
+
+/***********************************************************
+ *  GetBoundsTransform()
+ *
+ *  This method is used to get the model matrix that maps
+ *  the unit box mesh onto the padded bounds of an object.
+ ***********************************************************/
+glm::mat4 OcclusionCuller::GetBoundsTransform(int objectID) const
+{
+	const OCCLUSION_OBJECT& object = m_objects[objectID];
+
+	glm::vec3 center = (object.boundsMin + object.boundsMax) * 0.5f;
+	glm::vec3 size = (object.boundsMax - object.boundsMin) + glm::vec3(g_BoundsPadding * 2.0f);
+
+	return(glm::translate(center) * glm::scale(size));
+}
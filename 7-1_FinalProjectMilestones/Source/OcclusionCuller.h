@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// occlusionculler.h
+// ============
+// hardware occlusion queries on object bounds with conditional rendering
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  OcclusionCuller
+ *
+ *  This class keeps one occlusion query per scene object.
+ *  Each frame the object bounds are tested against the
+ *  finished depth buffer, and the next frame draws the
+ *  object under conditional rendering on that result, so
+ *  the CPU never waits for a query to complete.
+ ***********************************************************/
+class OcclusionCuller
+{
+public:
+	// constructor
+	OcclusionCuller();
+	// destructor
+	~OcclusionCuller();
+
+	struct OCCLUSION_OBJECT
+	{
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		GLuint queryID;
+		bool bQueryIssued;
+		bool bHasBounds;
+	};
+
+	// pick the query target supported by the context
+	void Initialize();
+	// free all the query objects
+	void Destroy();
+
+	// start a frame with the given number of scene objects,
+	// collecting any results that are already available
+	void BeginFrame(int objectCount);
+	// grow the bounds of an object by a world space box
+	void AddBounds(int objectID, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+	// draw an object only if its last query saw samples pass
+	bool BeginConditionalDraw(int objectID, const glm::vec3& cameraPosition);
+	void EndConditionalDraw();
+
+	// test an object's bounds against the current depth buffer
+	bool BeginBoundsQuery(int objectID);
+	void EndBoundsQuery();
+	// model matrix that maps the unit box onto an object's bounds
+	glm::mat4 GetBoundsTransform(int objectID) const;
+
+	int GetObjectCount() const { return (int)m_objects.size(); }
+	// objects whose latest completed query found them hidden
+	int GetOccludedCount() const { return m_occludedCount; }
+
+private:
+	// query target, conservative when the context supports it
+	GLenum m_queryTarget;
+	// per-object query state, indexed by object ID
+	std::vector<OCCLUSION_OBJECT> m_objects;
+	// occluded objects counted from the latest results
+	int m_occludedCount;
+	// time the occluded count was last reported
+	double m_lastReportTime;
+};
@@ -0,0 +1,378 @@
+///////////////////////////////////////////////////////////////////////////////
+// resourceaccounting.cpp
+// ============
+// estimated GPU and CPU memory of every texture, buffer and program by tag
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ResourceAccounting.h"
+
+#include <fstream>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// every tracked resource, in the order it was first seen
+	std::vector<ResourceAccounting::RESOURCE> g_Resources;
+
+	// texture budget in bytes, 0 when textures are not limited
+	unsigned long long g_TextureBudget = 0;
+
+	// glBufferData while a capture is running, and the bytes
+	// passed to it since the capture began
+	PFNGLBUFFERDATAPROC g_OriginalBufferData = NULL;
+	unsigned long long g_CapturedBytes = 0;
+
+	const char* const g_CategoryNames[ResourceAccounting::CATEGORY_COUNT] = {
+		"texture", "buffer", "program", "render target" };
+
+	const double g_BytesPerMegabyte = 1024.0 * 1024.0;
+
+	/***********************************************************
+	 *  Capture_BufferData()
+	 ***********************************************************/
+	void GLAPIENTRY Capture_BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+	{
+		g_CapturedBytes += (unsigned long long)size;
+		g_OriginalBufferData(target, size, data, usage);
+	}
+
+	/***********************************************************
+	 *  FindResource()
+	 ***********************************************************/
+	int FindResource(ResourceAccounting::CATEGORY category, const std::string& tag)
+	{
+		for (int i = 0; i < (int)g_Resources.size(); i++)
+		{
+			if ((g_Resources[i].category == category) && (g_Resources[i].tag == tag))
+				return i;
+		}
+		return -1;
+	}
+
+	/***********************************************************
+	 *  WriteJSONString()
+	 *
+	 *  This function is used to write a string with quotes,
+	 *  backslashes and control characters escaped.
+	 ***********************************************************/
+	void WriteJSONString(std::ofstream& file, const std::string& text)
+	{
+		file << '"';
+		for (char c : text)
+		{
+			if ((c == '"') || (c == '\\'))
+				file << '\\' << c;
+			else if ((unsigned char)c < 0x20)
+				file << ' ';
+			else
+				file << c;
+		}
+		file << '"';
+	}
+}
+
+/***********************************************************
+ *  Track()
+ ***********************************************************/
+void ResourceAccounting::Track(CATEGORY category, const std::string& tag,
+	unsigned long long gpuBytes, unsigned long long cpuBytes)
+{
+	int index = FindResource(category, tag);
+	if (index < 0)
+	{
+		RESOURCE resource;
+		resource.category = category;
+		resource.tag = tag;
+		g_Resources.push_back(resource);
+		index = (int)g_Resources.size() - 1;
+	}
+	g_Resources[index].gpuBytes = gpuBytes;
+	g_Resources[index].cpuBytes = cpuBytes;
+}
+
+/***********************************************************
+ *  Untrack()
+ ***********************************************************/
+void ResourceAccounting::Untrack(CATEGORY category, const std::string& tag)
+{
+	int index = FindResource(category, tag);
+	if (index >= 0)
+	{
+		g_Resources.erase(g_Resources.begin() + index);
+	}
+}
+
+/***********************************************************
+ *  TrackProgram()
+ *
+ *  This method is used to record a linked program at the
+ *  size of its binary, the closest the driver reports to
+ *  the memory the program takes.
+ ***********************************************************/
+void ResourceAccounting::TrackProgram(GLuint programID)
+{
+	if (programID == 0)
+		return;
+
+	GLint binaryLength = 0;
+	if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+	{
+		glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	}
+	Track(CATEGORY_PROGRAM, "program " + std::to_string(programID),
+		(unsigned long long)((binaryLength > 0) ? binaryLength : 0), 0);
+}
+
+/***********************************************************
+ *  UntrackProgram()
+ ***********************************************************/
+void ResourceAccounting::UntrackProgram(GLuint programID)
+{
+	Untrack(CATEGORY_PROGRAM, "program " + std::to_string(programID));
+}
+
+/***********************************************************
+ *  GetResources()
+ ***********************************************************/
+const std::vector<ResourceAccounting::RESOURCE>& ResourceAccounting::GetResources()
+{
+	return(g_Resources);
+}
+
+/***********************************************************
+ *  GetGPUBytes()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetGPUBytes(CATEGORY category)
+{
+	unsigned long long total = 0;
+	for (const RESOURCE& resource : g_Resources)
+	{
+		if (resource.category == category)
+			total += resource.gpuBytes;
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetCPUBytes()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetCPUBytes(CATEGORY category)
+{
+	unsigned long long total = 0;
+	for (const RESOURCE& resource : g_Resources)
+	{
+		if (resource.category == category)
+			total += resource.cpuBytes;
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetTotalGPUBytes()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetTotalGPUBytes()
+{
+	unsigned long long total = 0;
+	for (const RESOURCE& resource : g_Resources)
+	{
+		total += resource.gpuBytes;
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetTotalCPUBytes()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetTotalCPUBytes()
+{
+	unsigned long long total = 0;
+	for (const RESOURCE& resource : g_Resources)
+	{
+		total += resource.cpuBytes;
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetCategoryName()
+ ***********************************************************/
+const char* ResourceAccounting::GetCategoryName(CATEGORY category)
+{
+	if ((category < 0) || (category >= CATEGORY_COUNT))
+		return "unknown";
+	return(g_CategoryNames[category]);
+}
+
+/***********************************************************
+ *  PrintSummary()
+ ***********************************************************/
+void ResourceAccounting::PrintSummary()
+{
+	for (int i = 0; i < CATEGORY_COUNT; i++)
+	{
+		CATEGORY category = (CATEGORY)i;
+		int count = 0;
+		for (const RESOURCE& resource : g_Resources)
+		{
+			if (resource.category == category)
+				count++;
+		}
+		std::cout << "INFO: " << count << " " << GetCategoryName(category) << "(s): "
+			<< GetGPUBytes(category) / g_BytesPerMegabyte << " MB GPU, "
+			<< GetCPUBytes(category) / g_BytesPerMegabyte << " MB CPU" << std::endl;
+	}
+	std::cout << "INFO: Total " << GetTotalGPUBytes() / g_BytesPerMegabyte << " MB GPU, "
+		<< GetTotalCPUBytes() / g_BytesPerMegabyte << " MB CPU";
+	if (g_TextureBudget > 0)
+	{
+		std::cout << ", texture budget " << g_TextureBudget / g_BytesPerMegabyte << " MB";
+	}
+	std::cout << std::endl;
+}
+
+/***********************************************************
+ *  WriteJSON()
+ ***********************************************************/
+bool ResourceAccounting::WriteJSON(const char* filename)
+{
+	std::ofstream file(filename, std::ios::trunc);
+	if (!file.is_open())
+	{
+		std::cout << "ERROR: Could not write the resource report " << filename << std::endl;
+		return false;
+	}
+
+	file << "{\n";
+	file << "\t\"gpuBytes\": " << GetTotalGPUBytes() << ",\n";
+	file << "\t\"cpuBytes\": " << GetTotalCPUBytes() << ",\n";
+	file << "\t\"textureBudget\": " << g_TextureBudget << ",\n";
+
+	file << "\t\"categories\": {\n";
+	for (int i = 0; i < CATEGORY_COUNT; i++)
+	{
+		CATEGORY category = (CATEGORY)i;
+		file << "\t\t";
+		WriteJSONString(file, GetCategoryName(category));
+		file << ": { \"gpuBytes\": " << GetGPUBytes(category)
+			<< ", \"cpuBytes\": " << GetCPUBytes(category) << " }"
+			<< ((i + 1 < CATEGORY_COUNT) ? ",\n" : "\n");
+	}
+	file << "\t},\n";
+
+	file << "\t\"resources\": [\n";
+	for (int i = 0; i < (int)g_Resources.size(); i++)
+	{
+		const RESOURCE& resource = g_Resources[i];
+		file << "\t\t{ \"category\": ";
+		WriteJSONString(file, GetCategoryName(resource.category));
+		file << ", \"tag\": ";
+		WriteJSONString(file, resource.tag);
+		file << ", \"gpuBytes\": " << resource.gpuBytes
+			<< ", \"cpuBytes\": " << resource.cpuBytes << " }"
+			<< ((i + 1 < (int)g_Resources.size()) ? ",\n" : "\n");
+	}
+	file << "\t]\n";
+	file << "}\n";
+
+	std::cout << "INFO: Resource report written to " << filename << std::endl;
+	return true;
+}
+
+/***********************************************************
+ *  GetTextureBytes()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetTextureBytes(int width, int height,
+	int bytesPerTexel, int mipLevels)
+{
+	if (bytesPerTexel == 3)
+		bytesPerTexel = 4;
+
+	unsigned long long total = 0;
+	for (int level = 0; (mipLevels == FULL_MIP_CHAIN) || (level < mipLevels); level++)
+	{
+		total += (unsigned long long)width * height * bytesPerTexel;
+		if ((width == 1) && (height == 1))
+			break;
+		width = (width > 1) ? width / 2 : 1;
+		height = (height > 1) ? height / 2 : 1;
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  BeginBufferCapture()
+ ***********************************************************/
+void ResourceAccounting::BeginBufferCapture()
+{
+	g_CapturedBytes = 0;
+	if ((g_OriginalBufferData == NULL) && (__glewBufferData != NULL))
+	{
+		g_OriginalBufferData = __glewBufferData;
+		__glewBufferData = Capture_BufferData;
+	}
+}
+
+/***********************************************************
+ *  EndBufferCapture()
+ ***********************************************************/
+unsigned long long ResourceAccounting::EndBufferCapture()
+{
+	if (g_OriginalBufferData != NULL)
+	{
+		__glewBufferData = g_OriginalBufferData;
+		g_OriginalBufferData = NULL;
+	}
+	return(g_CapturedBytes);
+}
+
+/***********************************************************
+ *  SetTextureBudget()
+ ***********************************************************/
+void ResourceAccounting::SetTextureBudget(unsigned long long bytes)
+{
+	g_TextureBudget = bytes;
+	std::cout << "INFO: Texture budget " << bytes / g_BytesPerMegabyte << " MB" << std::endl;
+}
+
+/***********************************************************
+ *  GetTextureBudget()
+ ***********************************************************/
+unsigned long long ResourceAccounting::GetTextureBudget()
+{
+	return(g_TextureBudget);
+}
+
+/***********************************************************
+ *  GetTextureDownscale()
+ *
+ *  This method is used to find how many times a texture
+ *  has to be halved, mip chain included, to fit in the
+ *  budget left over by the other textures. A texture that
+ *  cannot fit even at 1x1 is kept at that size.
+ ***********************************************************/
+int ResourceAccounting::GetTextureDownscale(const std::string& tag,
+	int width, int height, int bytesPerTexel)
+{
+	if (g_TextureBudget == 0)
+		return 0;
+
+	unsigned long long used = GetGPUBytes(CATEGORY_TEXTURE);
+	int index = FindResource(CATEGORY_TEXTURE, tag);
+	if (index >= 0)
+		used -= g_Resources[index].gpuBytes;
+	unsigned long long remaining = (used < g_TextureBudget) ? g_TextureBudget - used : 0;
+
+	int halvings = 0;
+	while (((width > 1) || (height > 1)) &&
+		(GetTextureBytes(width, height, bytesPerTexel, FULL_MIP_CHAIN) > remaining))
+	{
+		width = (width > 1) ? width / 2 : 1;
+		height = (height > 1) ? height / 2 : 1;
+		halvings++;
+	}
+	return(halvings);
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// resourceaccounting.h
+// ============
+// estimated GPU and CPU memory of every texture, buffer and program by tag
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  ResourceAccounting
+ *
+ *  This class keeps a table of the GPU resources the engine
+ *  creates, each with a tag, a category, its estimated GPU
+ *  memory and the CPU memory kept alongside it, such as the
+ *  image copies held for the texture atlas. The code that
+ *  creates or frees a resource reports it here. The table
+ *  can be totaled by category, printed, or written out as
+ *  JSON. It also holds the texture budget that textures
+ *  are scaled down to fit when they are loaded.
+ ***********************************************************/
+class ResourceAccounting
+{
+public:
+	enum CATEGORY
+	{
+		CATEGORY_TEXTURE,
+		CATEGORY_BUFFER,
+		CATEGORY_PROGRAM,
+		CATEGORY_RENDER_TARGET,
+		CATEGORY_COUNT
+	};
+
+	// one tracked resource
+	struct RESOURCE
+	{
+		CATEGORY category;
+		std::string tag;
+		unsigned long long gpuBytes;
+		unsigned long long cpuBytes;
+	};
+
+	// mip level count meaning the whole chain down to 1x1
+	static const int FULL_MIP_CHAIN = -1;
+
+	// record a resource, replacing the sizes of one with the
+	// same category and tag
+	static void Track(CATEGORY category, const std::string& tag,
+		unsigned long long gpuBytes, unsigned long long cpuBytes);
+	// forget a freed resource
+	static void Untrack(CATEGORY category, const std::string& tag);
+	// record or forget a linked program by its ID
+	static void TrackProgram(GLuint programID);
+	static void UntrackProgram(GLuint programID);
+
+	static const std::vector<RESOURCE>& GetResources();
+	static unsigned long long GetGPUBytes(CATEGORY category);
+	static unsigned long long GetCPUBytes(CATEGORY category);
+	static unsigned long long GetTotalGPUBytes();
+	static unsigned long long GetTotalCPUBytes();
+	static const char* GetCategoryName(CATEGORY category);
+
+	// print the totals of each category
+	static void PrintSummary();
+	// write every resource and the totals as JSON
+	static bool WriteJSON(const char* filename);
+
+	// estimated size of a texture with some or all of its mip
+	// levels; drivers keep three channel textures as four
+	static unsigned long long GetTextureBytes(int width, int height,
+		int bytesPerTexel, int mipLevels);
+
+	// measure the buffers created by code outside the engine,
+	// such as the basic meshes, by counting the bytes passed
+	// to glBufferData in between
+	static void BeginBufferCapture();
+	static unsigned long long EndBufferCapture();
+
+	// GPU memory all textures together may use, or 0 for none
+	static void SetTextureBudget(unsigned long long bytes);
+	static unsigned long long GetTextureBudget();
+	// number of times a texture has to be halved to fit in
+	// what is left of the budget, not counting a texture
+	// with the same tag that it replaces
+	static int GetTextureDownscale(const std::string& tag,
+		int width, int height, int bytesPerTexel);
+};
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// resourcecache.cpp
+// ============
+// meshes, textures and programs shared by every scene, freed with their last user
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ResourceCache.h"
+#include "ResourceAccounting.h"
+#include "ShapeMeshes.h"
+
+#include <iostream>
+#include <map>
+
+// declaration of global variables
+namespace
+{
+	// the shared basic meshes and the scenes holding them
+	ShapeMeshes* g_pShapeMeshes = NULL;
+	int g_shapeMeshRefCount = 0;
+
+	// resident textures by key
+	std::map<std::string, ResourceCache::TEXTURE_RESOURCE> g_Textures;
+
+	// a linked program and the users holding it
+	struct PROGRAM_RESOURCE
+	{
+		GLuint programID;
+		int refCount;
+	};
+	// resident programs by source hash
+	std::map<unsigned long long, PROGRAM_RESOURCE> g_Programs;
+}
+
+/***********************************************************
+ *  AcquireShapeMeshes()
+ *
+ *  This method is used to get the basic meshes, loading
+ *  them for the first scene and measuring the buffers they
+ *  create.
+ ***********************************************************/
+ShapeMeshes* ResourceCache::AcquireShapeMeshes()
+{
+	if (g_pShapeMeshes == NULL)
+	{
+		g_pShapeMeshes = new ShapeMeshes();
+		ResourceAccounting::BeginBufferCapture();
+		g_pShapeMeshes->LoadPlaneMesh();
+		g_pShapeMeshes->LoadBoxMesh();
+		g_pShapeMeshes->LoadCylinderMesh();
+		g_pShapeMeshes->LoadSphereMesh();
+		ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, "ShapeMeshes",
+			ResourceAccounting::EndBufferCapture(), 0);
+	}
+	else
+	{
+		std::cout << "INFO: Reusing the resident shape meshes" << std::endl;
+	}
+	g_shapeMeshRefCount++;
+
+	return(g_pShapeMeshes);
+}
+
+/***********************************************************
+ *  ReleaseShapeMeshes()
+ ***********************************************************/
+void ResourceCache::ReleaseShapeMeshes()
+{
+	if (g_shapeMeshRefCount <= 0)
+		return;
+
+	g_shapeMeshRefCount--;
+	if (g_shapeMeshRefCount == 0)
+	{
+		delete g_pShapeMeshes;
+		g_pShapeMeshes = NULL;
+		ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, "ShapeMeshes");
+	}
+}
+
+/***********************************************************
+ *  GetTextureKey()
+ *
+ *  This method is used to build the key of a texture. The
+ *  file time is part of it, so an image changed on disk is
+ *  loaded again while scenes still holding the old one keep
+ *  it until they release it.
+ ***********************************************************/
+std::string ResourceCache::GetTextureKey(const char* filename, long long fileTime, bool bRepeat)
+{
+	return std::string(filename) + "|" + std::to_string(fileTime) +
+		(bRepeat ? "|repeat" : "|clamp");
+}
+
+/***********************************************************
+ *  AcquireTexture()
+ ***********************************************************/
+const ResourceCache::TEXTURE_RESOURCE* ResourceCache::AcquireTexture(const std::string& key)
+{
+	std::map<std::string, TEXTURE_RESOURCE>::iterator it = g_Textures.find(key);
+	if (it == g_Textures.end())
+		return NULL;
+
+	it->second.refCount++;
+	return(&it->second);
+}
+
+/***********************************************************
+ *  AddTexture()
+ *
+ *  This method is used to hand a new texture to the cache.
+ *  It is tracked once under its key, however many scenes
+ *  use it, with the kept atlas tile as its CPU memory.
+ ***********************************************************/
+const ResourceCache::TEXTURE_RESOURCE* ResourceCache::AddTexture(const std::string& key, GLuint textureID,
+	int width, int height, int colorChannels,
+	const unsigned char* atlasPixels, int atlasWidth, int atlasHeight)
+{
+	TEXTURE_RESOURCE& texture = g_Textures[key];
+	texture.key = key;
+	texture.textureID = textureID;
+	texture.width = width;
+	texture.height = height;
+	texture.colorChannels = colorChannels;
+	texture.refCount = 1;
+	texture.atlasWidth = 0;
+	texture.atlasHeight = 0;
+	texture.atlasPixels.clear();
+	if (atlasPixels != NULL)
+	{
+		texture.atlasWidth = atlasWidth;
+		texture.atlasHeight = atlasHeight;
+		texture.atlasPixels.assign(atlasPixels, atlasPixels + (size_t)atlasWidth * atlasHeight * 4);
+	}
+
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_TEXTURE, key,
+		ResourceAccounting::GetTextureBytes(width, height, colorChannels,
+			ResourceAccounting::FULL_MIP_CHAIN),
+		(unsigned long long)texture.atlasPixels.size());
+
+	return(&texture);
+}
+
+/***********************************************************
+ *  ReleaseTexture()
+ ***********************************************************/
+void ResourceCache::ReleaseTexture(GLuint textureID)
+{
+	if (textureID == 0)
+		return;
+
+	for (std::map<std::string, TEXTURE_RESOURCE>::iterator it = g_Textures.begin();
+		it != g_Textures.end(); ++it)
+	{
+		if (it->second.textureID != textureID)
+			continue;
+
+		it->second.refCount--;
+		if (it->second.refCount <= 0)
+		{
+			glDeleteTextures(1, &it->second.textureID);
+			ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_TEXTURE, it->first);
+			g_Textures.erase(it);
+		}
+		return;
+	}
+}
+
+/***********************************************************
+ *  AcquireProgram()
+ ***********************************************************/
+GLuint ResourceCache::AcquireProgram(unsigned long long key)
+{
+	std::map<unsigned long long, PROGRAM_RESOURCE>::iterator it = g_Programs.find(key);
+	if (it == g_Programs.end())
+		return 0;
+
+	it->second.refCount++;
+	return(it->second.programID);
+}
+
+/***********************************************************
+ *  AddProgram()
+ ***********************************************************/
+void ResourceCache::AddProgram(unsigned long long key, GLuint programID)
+{
+	if (programID == 0)
+		return;
+
+	PROGRAM_RESOURCE& program = g_Programs[key];
+	program.programID = programID;
+	program.refCount = 1;
+	ResourceAccounting::TrackProgram(programID);
+}
+
+/***********************************************************
+ *  ReleaseProgram()
+ ***********************************************************/
+void ResourceCache::ReleaseProgram(GLuint programID)
+{
+	if (programID == 0)
+		return;
+
+	for (std::map<unsigned long long, PROGRAM_RESOURCE>::iterator it = g_Programs.begin();
+		it != g_Programs.end(); ++it)
+	{
+		if (it->second.programID != programID)
+			continue;
+
+		it->second.refCount--;
+		if (it->second.refCount <= 0)
+		{
+			ResourceAccounting::UntrackProgram(programID);
+			glDeleteProgram(programID);
+			g_Programs.erase(it);
+		}
+		return;
+	}
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// resourcecache.h
+// ============
+// meshes, textures and programs shared by every scene, freed with their last user
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+class ShapeMeshes;
+
+/***********************************************************
+ *  ResourceCache
+ *
+ *  This class keeps one copy of each GPU resource that the
+ *  scenes of the process load, so scenes that run side by
+ *  side, or one replacing another, share what is already
+ *  resident instead of loading it again. Textures are keyed
+ *  by the image file, its modification time and the wrap
+ *  mode, and programs by the hash of their source and
+ *  defines. Each acquire adds a reference, and a resource
+ *  is freed and stops being tracked when its last user
+ *  releases it.
+ ***********************************************************/
+class ResourceCache
+{
+public:
+	// a texture resident on the GPU
+	struct TEXTURE_RESOURCE
+	{
+		std::string key;
+		GLuint textureID;
+		// size after any budget halvings
+		int width;
+		int height;
+		int colorChannels;
+		int refCount;
+		// RGBA tile image the atlas took for the texture, if
+		// any, so scenes that reuse the texture can add it to
+		// their own atlas without decoding the file again
+		int atlasWidth;
+		int atlasHeight;
+		std::vector<unsigned char> atlasPixels;
+	};
+
+	// the basic shape meshes, loaded by the first scene that
+	// acquires them
+	static ShapeMeshes* AcquireShapeMeshes();
+	static void ReleaseShapeMeshes();
+
+	// key of an image file loaded with a wrap mode
+	static std::string GetTextureKey(const char* filename, long long fileTime, bool bRepeat);
+	// a resident texture with another reference added, or
+	// NULL if no scene holds it
+	static const TEXTURE_RESOURCE* AcquireTexture(const std::string& key);
+	// take ownership of a newly created texture, with one
+	// reference, and the atlas tile image or NULL
+	static const TEXTURE_RESOURCE* AddTexture(const std::string& key, GLuint textureID,
+		int width, int height, int colorChannels,
+		const unsigned char* atlasPixels, int atlasWidth, int atlasHeight);
+	// drop a reference, deleting the texture with the last
+	static void ReleaseTexture(GLuint textureID);
+
+	// a resident program with another reference added, or 0
+	static GLuint AcquireProgram(unsigned long long key);
+	// take ownership of a newly linked program, with one reference
+	static void AddProgram(unsigned long long key, GLuint programID);
+	// drop a reference, deleting the program with the last
+	static void ReleaseProgram(GLuint programID);
+};
@@ -0,0 +1,687 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebvh.cpp
+// ============
+// bounding volume hierarchy over scene object bounds for culling and picking
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneBVH.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+// declaration of global variables
+namespace
+{
+	// bins the centroids are sorted into along each axis when
+	// looking for the cheapest split
+	const int g_BinCount = 16;
+
+	// nodes with more objects than this are always split, even
+	// when the heuristic would keep them as one leaf
+	const int g_MaxLeafSize = 4;
+
+	// cost of visiting a child relative to testing one object
+	const float g_TraversalCost = 1.0f;
+
+	// deepest tree the query stacks can walk; median splits
+	// keep real trees far shallower than this
+	const int g_MaxStackDepth = 64;
+
+	// empty box that any union replaces
+	SceneBVH::BOUNDS EmptyBounds()
+	{
+		SceneBVH::BOUNDS bounds;
+		bounds.min = glm::vec3(FLT_MAX);
+		bounds.max = glm::vec3(-FLT_MAX);
+		return bounds;
+	}
+
+	void GrowBounds(SceneBVH::BOUNDS& bounds, const SceneBVH::BOUNDS& other)
+	{
+		bounds.min = glm::min(bounds.min, other.min);
+		bounds.max = glm::max(bounds.max, other.max);
+	}
+
+	// half the surface area of a box, which is all the
+	// heuristic needs since only ratios are compared
+	float HalfArea(const SceneBVH::BOUNDS& bounds)
+	{
+		glm::vec3 extent = bounds.max - bounds.min;
+		if ((extent.x < 0.0f) || (extent.y < 0.0f) || (extent.z < 0.0f))
+			return 0.0f;
+		return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+	}
+
+	// distance along a ray to where it enters a box, or
+	// FLT_MAX when it misses the box within the distance
+	float IntersectBounds(const SceneBVH::BOUNDS& bounds, const glm::vec3& origin,
+		const glm::vec3& inverseDirection, float maxDistance)
+	{
+		glm::vec3 t0 = (bounds.min - origin) * inverseDirection;
+		glm::vec3 t1 = (bounds.max - origin) * inverseDirection;
+		glm::vec3 tNear = glm::min(t0, t1);
+		glm::vec3 tFar = glm::max(t0, t1);
+		float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+		float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+		return (enter <= exit) ? enter : FLT_MAX;
+	}
+
+	// whether a box is at least partly in front of every plane
+	bool IsInFrustum(const SceneBVH::BOUNDS& bounds, const glm::vec4 planes[6]);
+
+	// reciprocal of a ray direction for the slab test, with
+	// axis parallel rays kept finite
+	glm::vec3 InverseDirection(const glm::vec3& direction)
+	{
+		return glm::vec3(
+			(direction.x != 0.0f) ? 1.0f / direction.x : FLT_MAX,
+			(direction.y != 0.0f) ? 1.0f / direction.y : FLT_MAX,
+			(direction.z != 0.0f) ? 1.0f / direction.z : FLT_MAX);
+	}
+
+	// which side of a plane a box is on: -1 fully behind, 1
+	// fully in front, 0 crossing it
+	int ClassifyBounds(const SceneBVH::BOUNDS& bounds, const glm::vec4& plane)
+	{
+		glm::vec3 normal(plane);
+		glm::vec3 positive(
+			(normal.x >= 0.0f) ? bounds.max.x : bounds.min.x,
+			(normal.y >= 0.0f) ? bounds.max.y : bounds.min.y,
+			(normal.z >= 0.0f) ? bounds.max.z : bounds.min.z);
+		if (glm::dot(normal, positive) + plane.w < 0.0f)
+			return -1;
+
+		glm::vec3 negative(
+			(normal.x >= 0.0f) ? bounds.min.x : bounds.max.x,
+			(normal.y >= 0.0f) ? bounds.min.y : bounds.max.y,
+			(normal.z >= 0.0f) ? bounds.min.z : bounds.max.z);
+		return (glm::dot(normal, negative) + plane.w >= 0.0f) ? 1 : 0;
+	}
+
+	bool IsInFrustum(const SceneBVH::BOUNDS& bounds, const glm::vec4 planes[6])
+	{
+		for (int p = 0; p < 6; p++)
+		{
+			if (ClassifyBounds(bounds, planes[p]) < 0)
+				return false;
+		}
+		return true;
+	}
+
+	// seconds since a start time on the high resolution clock
+	double SecondsSince(std::chrono::high_resolution_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	// object counts the benchmark builds trees over
+	const int g_BenchmarkSizes[] = { 1000, 100000, 1000000 };
+
+	// queries timed per tree; the linear scans only run a few,
+	// since they take seconds over a million objects
+	const int g_BenchmarkFrustumQueries = 100;
+	const int g_BenchmarkRayQueries = 10000;
+	const int g_BenchmarkLinearQueries = 10;
+	const int g_BenchmarkMoves = 1000;
+}
+
+/***********************************************************
+ *  SceneBVH()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneBVH::SceneBVH()
+{
+	m_nodeCount = 0;
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used to build the tree from scratch. A
+ *  tree over n objects never has more than 2n - 1 nodes, so
+ *  the node storage is sized once and children are always
+ *  placed next to each other.
+ ***********************************************************/
+void SceneBVH::Build(const BOUNDS* pBounds, int count)
+{
+	m_objectBounds.assign(pBounds, pBounds + count);
+	m_centroids.resize(count);
+	m_objectOrder.resize(count);
+	m_objectLeaf.assign(count, -1);
+	for (int i = 0; i < count; i++)
+	{
+		m_centroids[i] = (pBounds[i].min + pBounds[i].max) * 0.5f;
+		m_objectOrder[i] = i;
+	}
+
+	m_nodes.resize(std::max(2 * count - 1, 1));
+	m_nodeCount = 0;
+	if (count == 0)
+		return;
+
+	BVH_NODE& root = m_nodes[0];
+	root.leftChild = -1;
+	root.firstObject = 0;
+	root.count = count;
+	root.parent = -1;
+	root.bounds = EmptyBounds();
+	m_nodeCount = 1;
+	UpdateNodeBounds(0);
+	Subdivide(0);
+}
+
+/***********************************************************
+ *  Subdivide()
+ *
+ *  This method is used to split a node in two. Centroids are
+ *  dropped into bins along each axis, and each boundary
+ *  between bins is scored by the area of the two halves
+ *  times the objects in them. The node stays a leaf when no
+ *  split beats testing all of its objects.
+ ***********************************************************/
+void SceneBVH::Subdivide(int nodeIndex)
+{
+	BVH_NODE& node = m_nodes[nodeIndex];
+	int first = node.firstObject;
+	int count = node.count;
+
+	if (count <= 1)
+	{
+		for (int i = first; i < first + count; i++)
+			m_objectLeaf[m_objectOrder[i]] = nodeIndex;
+		return;
+	}
+
+	// bins are spread over the centroids, not the object boxes
+	BOUNDS centroidBounds = EmptyBounds();
+	for (int i = first; i < first + count; i++)
+	{
+		const glm::vec3& centroid = m_centroids[m_objectOrder[i]];
+		centroidBounds.min = glm::min(centroidBounds.min, centroid);
+		centroidBounds.max = glm::max(centroidBounds.max, centroid);
+	}
+
+	int bestAxis = -1;
+	int bestSplit = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+		if (extent <= 0.0f)
+			continue;
+
+		BOUNDS binBounds[g_BinCount];
+		int binCount[g_BinCount];
+		for (int b = 0; b < g_BinCount; b++)
+		{
+			binBounds[b] = EmptyBounds();
+			binCount[b] = 0;
+		}
+
+		float binScale = g_BinCount / extent;
+		for (int i = first; i < first + count; i++)
+		{
+			int object = m_objectOrder[i];
+			int b = std::min(g_BinCount - 1,
+				(int)((m_centroids[object][axis] - centroidBounds.min[axis]) * binScale));
+			GrowBounds(binBounds[b], m_objectBounds[object]);
+			binCount[b]++;
+		}
+
+		// sweep from both ends so every boundary is scored in
+		// one pass over the bins
+		float leftArea[g_BinCount - 1];
+		int leftCount[g_BinCount - 1];
+		BOUNDS sweep = EmptyBounds();
+		int sweepCount = 0;
+		for (int b = 0; b < g_BinCount - 1; b++)
+		{
+			GrowBounds(sweep, binBounds[b]);
+			sweepCount += binCount[b];
+			leftArea[b] = HalfArea(sweep);
+			leftCount[b] = sweepCount;
+		}
+		sweep = EmptyBounds();
+		sweepCount = 0;
+		for (int b = g_BinCount - 1; b > 0; b--)
+		{
+			GrowBounds(sweep, binBounds[b]);
+			sweepCount += binCount[b];
+			float cost = leftArea[b - 1] * leftCount[b - 1] + HalfArea(sweep) * sweepCount;
+			if ((leftCount[b - 1] > 0) && (sweepCount > 0) && (cost < bestCost))
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	// compare against keeping the node as a leaf, in the same
+	// units as the split costs
+	float nodeArea = HalfArea(node.bounds);
+	float leafCost = nodeArea * count;
+	float splitCost = g_TraversalCost * nodeArea + bestCost;
+	int mid = first;
+	if ((bestAxis >= 0) && ((splitCost < leafCost) || (count > g_MaxLeafSize)))
+	{
+		float splitPosition = centroidBounds.min[bestAxis] +
+			(centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis]) * bestSplit / g_BinCount;
+		int* pSplit = std::partition(&m_objectOrder[first], &m_objectOrder[first] + count,
+			[&](int object) { return m_centroids[object][bestAxis] < splitPosition; });
+		mid = (int)(pSplit - &m_objectOrder[0]);
+	}
+	else if ((bestAxis < 0) && (count > g_MaxLeafSize))
+	{
+		// every centroid is in the same place, so any split is
+		// as good as another
+		mid = first + count / 2;
+	}
+
+	if ((mid <= first) || (mid >= first + count))
+	{
+		if (count <= g_MaxLeafSize)
+		{
+			for (int i = first; i < first + count; i++)
+				m_objectLeaf[m_objectOrder[i]] = nodeIndex;
+			return;
+		}
+		mid = first + count / 2;
+	}
+
+	int leftIndex = m_nodeCount;
+	m_nodeCount += 2;
+	for (int side = 0; side < 2; side++)
+	{
+		BVH_NODE& child = m_nodes[leftIndex + side];
+		child.leftChild = -1;
+		child.firstObject = (side == 0) ? first : mid;
+		child.count = (side == 0) ? (mid - first) : (first + count - mid);
+		child.parent = nodeIndex;
+		child.bounds = EmptyBounds();
+		UpdateNodeBounds(leftIndex + side);
+	}
+
+	// the reference may be stale once children are written
+	m_nodes[nodeIndex].leftChild = leftIndex;
+	m_nodes[nodeIndex].count = 0;
+
+	Subdivide(leftIndex);
+	Subdivide(leftIndex + 1);
+}
+
+/***********************************************************
+ *  UpdateNodeBounds()
+ ***********************************************************/
+bool SceneBVH::UpdateNodeBounds(int nodeIndex)
+{
+	BVH_NODE& node = m_nodes[nodeIndex];
+	BOUNDS bounds = EmptyBounds();
+	if (node.count > 0)
+	{
+		for (int i = node.firstObject; i < node.firstObject + node.count; i++)
+			GrowBounds(bounds, m_objectBounds[m_objectOrder[i]]);
+	}
+	else
+	{
+		bounds = m_nodes[node.leftChild].bounds;
+		GrowBounds(bounds, m_nodes[node.leftChild + 1].bounds);
+	}
+
+	bool bChanged = (bounds.min != node.bounds.min) || (bounds.max != node.bounds.max);
+	node.bounds = bounds;
+	return bChanged;
+}
+
+/***********************************************************
+ *  UpdateBounds()
+ *
+ *  This method is used to move a single object. The boxes
+ *  are refit from its leaf up, stopping at the first box
+ *  that the move did not change. The tree shape is kept, so
+ *  it gets looser as objects wander; rebuild when that
+ *  starts to cost more than the refit saves.
+ ***********************************************************/
+void SceneBVH::UpdateBounds(int object, const BOUNDS& bounds)
+{
+	m_objectBounds[object] = bounds;
+	m_centroids[object] = (bounds.min + bounds.max) * 0.5f;
+
+	int nodeIndex = m_objectLeaf[object];
+	while ((nodeIndex >= 0) && (UpdateNodeBounds(nodeIndex) == true))
+	{
+		nodeIndex = m_nodes[nodeIndex].parent;
+	}
+}
+
+/***********************************************************
+ *  Refit()
+ *
+ *  This method is used when many objects move at once.
+ *  Children are always stored after their parent, so one
+ *  pass in reverse order refits every box bottom up.
+ ***********************************************************/
+void SceneBVH::Refit(const BOUNDS* pBounds)
+{
+	for (int i = 0; i < (int)m_objectBounds.size(); i++)
+	{
+		m_objectBounds[i] = pBounds[i];
+		m_centroids[i] = (pBounds[i].min + pBounds[i].max) * 0.5f;
+	}
+	for (int i = m_nodeCount - 1; i >= 0; i--)
+	{
+		UpdateNodeBounds(i);
+	}
+}
+
+/***********************************************************
+ *  CollectObjects()
+ ***********************************************************/
+void SceneBVH::CollectObjects(int nodeIndex, std::vector<int>& objects) const
+{
+	int stack[g_MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = nodeIndex;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		if (node.count > 0)
+		{
+			objects.insert(objects.end(), m_objectOrder.begin() + node.firstObject,
+				m_objectOrder.begin() + node.firstObject + node.count);
+		}
+		else
+		{
+			stack[stackSize++] = node.leftChild;
+			stack[stackSize++] = node.leftChild + 1;
+		}
+	}
+}
+
+/***********************************************************
+ *  QueryFrustum()
+ *
+ *  This method is used to find the objects the camera may
+ *  see. A box behind any plane is skipped with everything
+ *  under it, and a box in front of all the planes takes
+ *  everything under it without testing any further.
+ ***********************************************************/
+void SceneBVH::QueryFrustum(const glm::vec4 planes[6], std::vector<int>& objects) const
+{
+	if (m_nodeCount == 0)
+		return;
+
+	int stack[g_MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		int nodeIndex = stack[--stackSize];
+		const BVH_NODE& node = m_nodes[nodeIndex];
+
+		bool bInside = true;
+		bool bOutside = false;
+		for (int p = 0; p < 6; p++)
+		{
+			int side = ClassifyBounds(node.bounds, planes[p]);
+			if (side < 0)
+			{
+				bOutside = true;
+				break;
+			}
+			if (side == 0)
+				bInside = false;
+		}
+		if (bOutside == true)
+			continue;
+
+		if (bInside == true)
+		{
+			CollectObjects(nodeIndex, objects);
+		}
+		else if (node.count > 0)
+		{
+			for (int i = node.firstObject; i < node.firstObject + node.count; i++)
+			{
+				int object = m_objectOrder[i];
+				if (IsInFrustum(m_objectBounds[object], planes) == true)
+					objects.push_back(object);
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.leftChild;
+			stack[stackSize++] = node.leftChild + 1;
+		}
+	}
+}
+
+/***********************************************************
+ *  Raycast()
+ *
+ *  This method is used to find the first object box along a
+ *  ray. The nearer child is visited first, and boxes that
+ *  start beyond the closest hit so far are skipped.
+ ***********************************************************/
+int SceneBVH::Raycast(const glm::vec3& origin, const glm::vec3& direction,
+	float maxDistance, float& hitDistance) const
+{
+	int hitObject = -1;
+	hitDistance = maxDistance;
+	if (m_nodeCount == 0)
+		return hitObject;
+
+	glm::vec3 inverseDirection = InverseDirection(direction);
+
+	if (IntersectBounds(m_nodes[0].bounds, origin, inverseDirection, hitDistance) == FLT_MAX)
+		return hitObject;
+
+	int stack[g_MaxStackDepth];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const BVH_NODE& node = m_nodes[stack[--stackSize]];
+		if (node.count > 0)
+		{
+			for (int i = node.firstObject; i < node.firstObject + node.count; i++)
+			{
+				int object = m_objectOrder[i];
+				float distance = IntersectBounds(m_objectBounds[object], origin, inverseDirection, hitDistance);
+				if (distance < hitDistance)
+				{
+					hitDistance = distance;
+					hitObject = object;
+				}
+			}
+			continue;
+		}
+
+		int nearChild = node.leftChild;
+		int farChild = node.leftChild + 1;
+		float nearDistance = IntersectBounds(m_nodes[nearChild].bounds, origin, inverseDirection, hitDistance);
+		float farDistance = IntersectBounds(m_nodes[farChild].bounds, origin, inverseDirection, hitDistance);
+		if (farDistance < nearDistance)
+		{
+			std::swap(nearChild, farChild);
+			std::swap(nearDistance, farDistance);
+		}
+		// the near child goes on top so it is walked first
+		if (farDistance != FLT_MAX)
+			stack[stackSize++] = farChild;
+		if (nearDistance != FLT_MAX)
+			stack[stackSize++] = nearChild;
+	}
+
+	return hitObject;
+}
+
+/***********************************************************
+ *  RunBenchmark()
+ *
+ *  This method is used to time the tree against a linear
+ *  scan over random boxes, at scene sizes from a thousand
+ *  to a million objects. The boxes fill a volume that grows
+ *  with their number, so every size sees the same density.
+ *  Query results are checked against the linear scan, and
+ *  the method returns false when any of them differ.
+ ***********************************************************/
+bool SceneBVH::RunBenchmark()
+{
+	bool bMatched = true;
+	std::mt19937 random(330);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	for (int count : g_BenchmarkSizes)
+	{
+		float extent = 4.0f * std::cbrt((float)count);
+		std::vector<BOUNDS> bounds(count);
+		for (int i = 0; i < count; i++)
+		{
+			glm::vec3 center = (glm::vec3(unit(random), unit(random), unit(random)) - 0.5f) * extent;
+			glm::vec3 halfSize = glm::vec3(unit(random), unit(random), unit(random)) + 0.25f;
+			bounds[i].min = center - halfSize;
+			bounds[i].max = center + halfSize;
+		}
+
+		SceneBVH bvh;
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		bvh.Build(bounds.data(), count);
+		double buildTime = SecondsSince(start);
+
+		// nudge every box for the full refit, then move a few
+		// one at a time like a scene with some animation
+		for (BOUNDS& box : bounds)
+		{
+			glm::vec3 offset = (glm::vec3(unit(random), unit(random), unit(random)) - 0.5f) * 0.1f;
+			box.min += offset;
+			box.max += offset;
+		}
+		start = std::chrono::high_resolution_clock::now();
+		bvh.Refit(bounds.data());
+		double refitTime = SecondsSince(start);
+
+		start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < g_BenchmarkMoves; i++)
+		{
+			int object = (int)(unit(random) * (count - 1));
+			glm::vec3 offset = (glm::vec3(unit(random), unit(random), unit(random)) - 0.5f);
+			bounds[object].min += offset;
+			bounds[object].max += offset;
+			bvh.UpdateBounds(object, bounds[object]);
+		}
+		double moveTime = SecondsSince(start);
+
+		// cameras at the center looking in random directions
+		std::vector<int> objects;
+		objects.reserve(count);
+		glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, extent * 0.5f);
+		double frustumTime = 0.0;
+		double linearFrustumTime = 0.0;
+		size_t visibleTotal = 0;
+		for (int q = 0; q < g_BenchmarkFrustumQueries; q++)
+		{
+			glm::vec3 direction = glm::vec3(unit(random), unit(random), unit(random)) - 0.5f;
+			glm::mat4 viewProjection = projection *
+				glm::lookAt(glm::vec3(0.0f), direction, glm::vec3(0.0f, 1.0f, 0.0f));
+			glm::vec4 rows[4];
+			for (int i = 0; i < 4; i++)
+			{
+				rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i],
+					viewProjection[2][i], viewProjection[3][i]);
+			}
+			glm::vec4 planes[6] = {
+				rows[3] + rows[0], rows[3] - rows[0],
+				rows[3] + rows[1], rows[3] - rows[1],
+				rows[3] + rows[2], rows[3] - rows[2] };
+
+			objects.clear();
+			start = std::chrono::high_resolution_clock::now();
+			bvh.QueryFrustum(planes, objects);
+			frustumTime += SecondsSince(start);
+			visibleTotal += objects.size();
+
+			if (q < g_BenchmarkLinearQueries)
+			{
+				size_t linearVisible = 0;
+				start = std::chrono::high_resolution_clock::now();
+				for (const BOUNDS& box : bounds)
+				{
+					if (IsInFrustum(box, planes) == true)
+						linearVisible++;
+				}
+				linearFrustumTime += SecondsSince(start);
+				if (linearVisible != objects.size())
+				{
+					std::cout << "ERROR: BVH frustum query found " << objects.size()
+						<< " objects, linear scan " << linearVisible << std::endl;
+					bMatched = false;
+				}
+			}
+		}
+
+		// rays from random points toward the center
+		double rayTime = 0.0;
+		double linearRayTime = 0.0;
+		int hitCount = 0;
+		for (int q = 0; q < g_BenchmarkRayQueries; q++)
+		{
+			glm::vec3 origin = (glm::vec3(unit(random), unit(random), unit(random)) - 0.5f) * extent;
+			glm::vec3 direction = glm::normalize(-origin + glm::vec3(unit(random)));
+			float hitDistance = 0.0f;
+			start = std::chrono::high_resolution_clock::now();
+			int hit = bvh.Raycast(origin, direction, extent * 2.0f, hitDistance);
+			rayTime += SecondsSince(start);
+			if (hit >= 0)
+				hitCount++;
+
+			if (q < g_BenchmarkLinearQueries)
+			{
+				glm::vec3 inverseDirection = InverseDirection(direction);
+				float linearDistance = extent * 2.0f;
+				int linearHit = -1;
+				start = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < count; i++)
+				{
+					float distance = IntersectBounds(bounds[i], origin, inverseDirection, linearDistance);
+					if (distance < linearDistance)
+					{
+						linearDistance = distance;
+						linearHit = i;
+					}
+				}
+				linearRayTime += SecondsSince(start);
+				// boxes the ray enters at the same distance can be
+				// returned in either order
+				if ((hit < 0) != (linearHit < 0) || ((hit >= 0) && (hitDistance != linearDistance)))
+				{
+					std::cout << "ERROR: BVH ray cast hit object " << hit
+						<< ", linear scan " << linearHit << std::endl;
+					bMatched = false;
+				}
+			}
+		}
+
+		std::cout << "INFO: " << count << " objects, " << bvh.GetNodeCount() << " nodes: build "
+			<< buildTime * 1000.0 << " ms, refit " << refitTime * 1000.0 << " ms, "
+			<< g_BenchmarkMoves << " moves " << moveTime * 1000.0 << " ms" << std::endl;
+		std::cout << "INFO:   frustum query " << frustumTime * 1000.0 / g_BenchmarkFrustumQueries
+			<< " ms for " << visibleTotal / g_BenchmarkFrustumQueries << " visible (linear "
+			<< linearFrustumTime * 1000.0 / g_BenchmarkLinearQueries << " ms)" << std::endl;
+		std::cout << "INFO:   ray cast " << rayTime * 1000000.0 / g_BenchmarkRayQueries
+			<< " us, " << hitCount << " of " << g_BenchmarkRayQueries << " hit (linear "
+			<< linearRayTime * 1000000.0 / g_BenchmarkLinearQueries << " us)" << std::endl;
+	}
+
+	return(bMatched);
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebvh.h
+// ============
+// bounding volume hierarchy over scene object bounds for culling and picking
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  SceneBVH
+ *
+ *  This class keeps a binary tree of bounding boxes over
+ *  the world space bounds of the scene objects. The tree is
+ *  built top down, splitting each node where the surface
+ *  area heuristic, evaluated over a fixed number of bins,
+ *  says the split is cheapest to traverse. Objects that
+ *  move only refit the boxes above them, keeping the tree
+ *  shape. Frustum and ray queries then test a logarithmic
+ *  number of boxes instead of every object.
+ ***********************************************************/
+class SceneBVH
+{
+public:
+	// constructor
+	SceneBVH();
+
+	// axis aligned box in world space
+	struct BOUNDS
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	// build the tree over a set of object bounds; objects are
+	// referred to by their index in the set from then on
+	void Build(const BOUNDS* pBounds, int count);
+	// move one object, refitting the boxes above it
+	void UpdateBounds(int object, const BOUNDS& bounds);
+	// move every object at once, refitting the whole tree
+	void Refit(const BOUNDS* pBounds);
+
+	int GetObjectCount() const { return (int)m_objectBounds.size(); }
+	const BOUNDS& GetBounds(int object) const { return m_objectBounds[object]; }
+	int GetNodeCount() const { return m_nodeCount; }
+
+	// collect the objects whose bounds are at least partly
+	// inside the frustum described by six inward facing planes
+	void QueryFrustum(const glm::vec4 planes[6], std::vector<int>& objects) const;
+	// find the nearest object whose bounds the ray hits within
+	// the distance, returning -1 when there is none
+	int Raycast(const glm::vec3& origin, const glm::vec3& direction,
+		float maxDistance, float& hitDistance) const;
+
+	// time building, refitting and querying trees of random
+	// boxes against a linear scan, printing the results
+	static bool RunBenchmark();
+
+private:
+	// a node is a leaf holding count objects from firstObject
+	// in m_objectOrder, or an inner node with count 0 whose
+	// children are at leftChild and leftChild + 1
+	struct BVH_NODE
+	{
+		BOUNDS bounds;
+		int leftChild;
+		int firstObject;
+		int count;
+		int parent;
+	};
+
+	std::vector<BVH_NODE> m_nodes;
+	int m_nodeCount;
+	// bounds and centroid of every object
+	std::vector<BOUNDS> m_objectBounds;
+	std::vector<glm::vec3> m_centroids;
+	// object indices, grouped by leaf
+	std::vector<int> m_objectOrder;
+	// leaf holding each object
+	std::vector<int> m_objectLeaf;
+
+	// split a node while the surface area heuristic favors it
+	void Subdivide(int nodeIndex);
+	// recompute a node's box from its objects or children,
+	// returning whether it changed
+	bool UpdateNodeBounds(int nodeIndex);
+	// add every object under a node to the results
+	void CollectObjects(int nodeIndex, std::vector<int>& objects) const;
+};
@@ -0,0 +1,517 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.cpp
+// ============
+// load scene descriptions from text source files and compiled binary files
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneFile.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// declaration of global variables
+namespace
+{
+	// identifies a compiled scene file and its layout version
+	const uint32_t g_SceneBinaryMagic = 0x424E4353;	// "SCNB"
+	const uint32_t g_SceneBinaryVersion = 2;
+
+	/***********************************************************
+	 *  ReportParseError()
+	 ***********************************************************/
+	bool ReportParseError(const char* filename, int lineNumber, const std::string& message)
+	{
+		std::cout << "ERROR: " << filename << "(" << lineNumber << "): "
+			<< message << std::endl;
+		return false;
+	}
+
+	/***********************************************************
+	 *  ReadVec3()
+	 ***********************************************************/
+	bool ReadVec3(std::istringstream& tokens, glm::vec3& value)
+	{
+		tokens >> value.x >> value.y >> value.z;
+		return !tokens.fail();
+	}
+
+	/***********************************************************
+	 *  ParseBoxSide()
+	 ***********************************************************/
+	int ParseBoxSide(const std::string& name)
+	{
+		if (name == "front") return SCENE_SIDE_FRONT;
+		if (name == "back") return SCENE_SIDE_BACK;
+		if (name == "left") return SCENE_SIDE_LEFT;
+		if (name == "right") return SCENE_SIDE_RIGHT;
+		if (name == "top") return SCENE_SIDE_TOP;
+		if (name == "bottom") return SCENE_SIDE_BOTTOM;
+		return 0;
+	}
+
+	// binary writing helpers, values are stored in the
+	// native byte order of the machine that compiled them
+	void WriteValue(std::ofstream& file, const void* data, size_t size)
+	{
+		file.write((const char*)data, size);
+	}
+	void WriteString(std::ofstream& file, const std::string& value)
+	{
+		uint32_t length = (uint32_t)value.size();
+		WriteValue(file, &length, sizeof(length));
+		WriteValue(file, value.data(), length);
+	}
+
+	// binary reading helpers
+	bool ReadValue(std::ifstream& file, void* data, size_t size)
+	{
+		file.read((char*)data, size);
+		return !file.fail();
+	}
+	bool ReadString(std::ifstream& file, std::string& value)
+	{
+		uint32_t length = 0;
+		if (!ReadValue(file, &length, sizeof(length)) || (length > 4096))
+			return false;
+		value.resize(length);
+		return (length == 0) || ReadValue(file, &value[0], length);
+	}
+	bool ReadCount(std::ifstream& file, uint32_t& count)
+	{
+		return ReadValue(file, &count, sizeof(count)) && (count < 65536);
+	}
+}
+
+/***********************************************************
+ *  GetSceneFileTime()
+ *
+ *  This function is used to get the last modification time
+ *  of a file, which drives the binary rebuild and reload.
+ ***********************************************************/
+long long GetSceneFileTime(const char* filename)
+{
+	struct stat fileInfo;
+	if (stat(filename, &fileInfo) != 0)
+		return -1;
+
+	return (long long)fileInfo.st_mtime;
+}
+
+/***********************************************************
+ *  ParseSceneText()
+ *
+ *  This function is used to parse a scene source file. Each
+ *  line starts with a keyword, and objects are blocks of
+ *  property lines between "object <name>" and "end":
+ *
+ *    texture <tag> <filename>
+ *    material <tag> <diffuse rgb> <specular rgb> <shininess>
+ *    directional <direction xyz> <ambient> <diffuse> <specular>
+ *    point <position xyz> <ambient> <diffuse> <specular>
+ *    object <name>
+ *      mesh plane | cylinder | sphere | box [sides...]
+ *      scale / rotation / position <x y z>
+ *      color <r g b a>
+ *      texture <tag>
+ *      uvscale <u v>
+ *      material <tag>
+ *      lighting on | off
+ *      prop <name>
+ *    end
+ ***********************************************************/
+bool ParseSceneText(const char* filename, SCENE_DESCRIPTION& scene)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+	{
+		std::cout << "Could not open scene file:" << filename << std::endl;
+		return false;
+	}
+
+	scene = SCENE_DESCRIPTION();
+
+	SCENE_OBJECT object;
+	bool bInObject = false;
+	std::string line;
+	int lineNumber = 0;
+
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+
+		// strip comments
+		size_t commentStart = line.find('#');
+		if (commentStart != std::string::npos)
+			line.erase(commentStart);
+
+		std::istringstream tokens(line);
+		std::string keyword;
+		if (!(tokens >> keyword))
+			continue;
+
+		if (bInObject == false)
+		{
+			if (keyword == "texture")
+			{
+				SCENE_TEXTURE texture;
+				if (!(tokens >> texture.tag >> texture.filename))
+					return ReportParseError(filename, lineNumber, "expected texture <tag> <filename>");
+				scene.textures.push_back(texture);
+			}
+			else if (keyword == "material")
+			{
+				SCENE_MATERIAL material;
+				tokens >> material.tag;
+				if (!ReadVec3(tokens, material.diffuseColor) ||
+					!ReadVec3(tokens, material.specularColor) ||
+					!(tokens >> material.shininess))
+					return ReportParseError(filename, lineNumber, "expected material <tag> <diffuse> <specular> <shininess>");
+				scene.materials.push_back(material);
+			}
+			else if ((keyword == "directional") || (keyword == "point"))
+			{
+				SCENE_LIGHT light;
+				light.type = (keyword == "point") ? SCENE_LIGHT_POINT : SCENE_LIGHT_DIRECTIONAL;
+				if (!ReadVec3(tokens, light.vector) ||
+					!ReadVec3(tokens, light.ambient) ||
+					!ReadVec3(tokens, light.diffuse) ||
+					!ReadVec3(tokens, light.specular))
+					return ReportParseError(filename, lineNumber, "expected " + keyword + " <xyz> <ambient> <diffuse> <specular>");
+				scene.lights.push_back(light);
+			}
+			else if (keyword == "object")
+			{
+				// defaults match the initial shader state
+				object = SCENE_OBJECT();
+				object.mesh = SCENE_MESH_BOX;
+				object.boxSides = SCENE_SIDE_ALL;
+				object.scale = glm::vec3(1.0f, 1.0f, 1.0f);
+				object.rotation = glm::vec3(0.0f, 0.0f, 0.0f);
+				object.position = glm::vec3(0.0f, 0.0f, 0.0f);
+				object.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+				object.uvScale = glm::vec2(1.0f, 1.0f);
+				object.bUseLighting = true;
+				tokens >> object.name;
+				bInObject = true;
+			}
+			else
+			{
+				return ReportParseError(filename, lineNumber, "unknown keyword " + keyword);
+			}
+			continue;
+		}
+
+		if (keyword == "end")
+		{
+			scene.objects.push_back(object);
+			bInObject = false;
+		}
+		else if (keyword == "mesh")
+		{
+			std::string meshName;
+			tokens >> meshName;
+			if (meshName == "plane")
+				object.mesh = SCENE_MESH_PLANE;
+			else if (meshName == "cylinder")
+				object.mesh = SCENE_MESH_CYLINDER;
+			else if (meshName == "sphere")
+				object.mesh = SCENE_MESH_SPHERE;
+			else if (meshName == "box")
+			{
+				object.mesh = SCENE_MESH_BOX;
+
+				// no sides listed means the whole box
+				int boxSides = 0;
+				std::string sideName;
+				while (tokens >> sideName)
+				{
+					int side = ParseBoxSide(sideName);
+					if (side == 0)
+						return ReportParseError(filename, lineNumber, "unknown box side " + sideName);
+					boxSides |= side;
+				}
+				object.boxSides = (boxSides != 0) ? boxSides : (int)SCENE_SIDE_ALL;
+			}
+			else
+				return ReportParseError(filename, lineNumber, "unknown mesh " + meshName);
+		}
+		else if ((keyword == "scale") || (keyword == "rotation") || (keyword == "position"))
+		{
+			glm::vec3& value = (keyword == "scale") ? object.scale :
+				((keyword == "rotation") ? object.rotation : object.position);
+			if (!ReadVec3(tokens, value))
+				return ReportParseError(filename, lineNumber, "expected " + keyword + " <x y z>");
+		}
+		else if (keyword == "color")
+		{
+			tokens >> object.color.r >> object.color.g >> object.color.b >> object.color.a;
+			if (tokens.fail())
+				return ReportParseError(filename, lineNumber, "expected color <r g b a>");
+		}
+		else if (keyword == "texture")
+		{
+			tokens >> object.texture;
+		}
+		else if (keyword == "uvscale")
+		{
+			tokens >> object.uvScale.x >> object.uvScale.y;
+			if (tokens.fail())
+				return ReportParseError(filename, lineNumber, "expected uvscale <u v>");
+		}
+		else if (keyword == "material")
+		{
+			tokens >> object.material;
+		}
+		else if (keyword == "lighting")
+		{
+			std::string value;
+			tokens >> value;
+			object.bUseLighting = (value != "off");
+		}
+		else if (keyword == "prop")
+		{
+			tokens >> object.prop;
+		}
+		else
+		{
+			return ReportParseError(filename, lineNumber, "unknown object property " + keyword);
+		}
+	}
+
+	if (bInObject == true)
+		return ReportParseError(filename, lineNumber, "missing end for object " + object.name);
+
+	return true;
+}
+
+/***********************************************************
+ *  WriteSceneBinary()
+ *
+ *  This function is used to write the compiled form of a
+ *  scene, which loads without any text parsing.
+ ***********************************************************/
+bool WriteSceneBinary(const char* filename, const SCENE_DESCRIPTION& scene)
+{
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		std::cout << "Could not write compiled scene:" << filename << std::endl;
+		return false;
+	}
+
+	WriteValue(file, &g_SceneBinaryMagic, sizeof(g_SceneBinaryMagic));
+	WriteValue(file, &g_SceneBinaryVersion, sizeof(g_SceneBinaryVersion));
+
+	uint32_t count = (uint32_t)scene.textures.size();
+	WriteValue(file, &count, sizeof(count));
+	for (const SCENE_TEXTURE& texture : scene.textures)
+	{
+		WriteString(file, texture.tag);
+		WriteString(file, texture.filename);
+	}
+
+	count = (uint32_t)scene.materials.size();
+	WriteValue(file, &count, sizeof(count));
+	for (const SCENE_MATERIAL& material : scene.materials)
+	{
+		WriteString(file, material.tag);
+		WriteValue(file, &material.diffuseColor, sizeof(material.diffuseColor));
+		WriteValue(file, &material.specularColor, sizeof(material.specularColor));
+		WriteValue(file, &material.shininess, sizeof(material.shininess));
+	}
+
+	count = (uint32_t)scene.lights.size();
+	WriteValue(file, &count, sizeof(count));
+	for (const SCENE_LIGHT& light : scene.lights)
+	{
+		int32_t type = light.type;
+		WriteValue(file, &type, sizeof(type));
+		WriteValue(file, &light.vector, sizeof(light.vector));
+		WriteValue(file, &light.ambient, sizeof(light.ambient));
+		WriteValue(file, &light.diffuse, sizeof(light.diffuse));
+		WriteValue(file, &light.specular, sizeof(light.specular));
+	}
+
+	count = (uint32_t)scene.objects.size();
+	WriteValue(file, &count, sizeof(count));
+	for (const SCENE_OBJECT& object : scene.objects)
+	{
+		int32_t mesh = object.mesh;
+		int32_t boxSides = object.boxSides;
+		uint8_t useLighting = object.bUseLighting ? 1 : 0;
+		WriteString(file, object.name);
+		WriteValue(file, &mesh, sizeof(mesh));
+		WriteValue(file, &boxSides, sizeof(boxSides));
+		WriteValue(file, &object.scale, sizeof(object.scale));
+		WriteValue(file, &object.rotation, sizeof(object.rotation));
+		WriteValue(file, &object.position, sizeof(object.position));
+		WriteValue(file, &object.color, sizeof(object.color));
+		WriteString(file, object.texture);
+		WriteValue(file, &object.uvScale, sizeof(object.uvScale));
+		WriteString(file, object.material);
+		WriteValue(file, &useLighting, sizeof(useLighting));
+		WriteString(file, object.prop);
+	}
+
+	return !file.fail();
+}
+
+/***********************************************************
+ *  ReadSceneBinary()
+ *
+ *  This function is used to read a compiled scene file.
+ ***********************************************************/
+bool ReadSceneBinary(const char* filename, SCENE_DESCRIPTION& scene)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+		return false;
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!ReadValue(file, &magic, sizeof(magic)) || (magic != g_SceneBinaryMagic) ||
+		!ReadValue(file, &version, sizeof(version)) || (version != g_SceneBinaryVersion))
+	{
+		std::cout << "Compiled scene has the wrong format:" << filename << std::endl;
+		return false;
+	}
+
+	scene = SCENE_DESCRIPTION();
+
+	uint32_t count = 0;
+	if (!ReadCount(file, count))
+		return false;
+	scene.textures.resize(count);
+	for (SCENE_TEXTURE& texture : scene.textures)
+	{
+		if (!ReadString(file, texture.tag) || !ReadString(file, texture.filename))
+			return false;
+	}
+
+	if (!ReadCount(file, count))
+		return false;
+	scene.materials.resize(count);
+	for (SCENE_MATERIAL& material : scene.materials)
+	{
+		if (!ReadString(file, material.tag) ||
+			!ReadValue(file, &material.diffuseColor, sizeof(material.diffuseColor)) ||
+			!ReadValue(file, &material.specularColor, sizeof(material.specularColor)) ||
+			!ReadValue(file, &material.shininess, sizeof(material.shininess)))
+			return false;
+	}
+
+	if (!ReadCount(file, count))
+		return false;
+	scene.lights.resize(count);
+	for (SCENE_LIGHT& light : scene.lights)
+	{
+		int32_t type = 0;
+		if (!ReadValue(file, &type, sizeof(type)) ||
+			!ReadValue(file, &light.vector, sizeof(light.vector)) ||
+			!ReadValue(file, &light.ambient, sizeof(light.ambient)) ||
+			!ReadValue(file, &light.diffuse, sizeof(light.diffuse)) ||
+			!ReadValue(file, &light.specular, sizeof(light.specular)))
+			return false;
+		light.type = type;
+	}
+
+	if (!ReadCount(file, count))
+		return false;
+	scene.objects.resize(count);
+	for (SCENE_OBJECT& object : scene.objects)
+	{
+		int32_t mesh = 0;
+		int32_t boxSides = 0;
+		uint8_t useLighting = 0;
+		if (!ReadString(file, object.name) ||
+			!ReadValue(file, &mesh, sizeof(mesh)) ||
+			!ReadValue(file, &boxSides, sizeof(boxSides)) ||
+			!ReadValue(file, &object.scale, sizeof(object.scale)) ||
+			!ReadValue(file, &object.rotation, sizeof(object.rotation)) ||
+			!ReadValue(file, &object.position, sizeof(object.position)) ||
+			!ReadValue(file, &object.color, sizeof(object.color)) ||
+			!ReadString(file, object.texture) ||
+			!ReadValue(file, &object.uvScale, sizeof(object.uvScale)) ||
+			!ReadString(file, object.material) ||
+			!ReadValue(file, &useLighting, sizeof(useLighting)) ||
+			!ReadString(file, object.prop))
+			return false;
+		object.mesh = mesh;
+		object.boxSides = boxSides;
+		object.bUseLighting = (useLighting != 0);
+	}
+
+	return true;
+}
+
+/***********************************************************
+ *  LoadSceneDescription()
+ *
+ *  This function is used to load a scene. The compiled
+ *  binary next to the source file is used when it is up to
+ *  date, otherwise the source is parsed and recompiled. A
+ *  compiled scene can also be shipped without its source.
+ ***********************************************************/
+bool LoadSceneDescription(const char* filename, SCENE_DESCRIPTION& scene)
+{
+	std::string binaryFilename = std::string(filename) + "b";
+
+	long long sourceTime = GetSceneFileTime(filename);
+	long long binaryTime = GetSceneFileTime(binaryFilename.c_str());
+
+	if ((binaryTime >= 0) && (binaryTime >= sourceTime))
+	{
+		if (ReadSceneBinary(binaryFilename.c_str(), scene) == true)
+			return true;
+	}
+
+	if (sourceTime < 0)
+	{
+		std::cout << "Could not find scene file:" << filename << std::endl;
+		return false;
+	}
+
+	if (ParseSceneText(filename, scene) == false)
+		return false;
+
+	WriteSceneBinary(binaryFilename.c_str(), scene);
+	return true;
+}
+
+/***********************************************************
+ *  SceneMaterialsEqual()
+ ***********************************************************/
+bool SceneMaterialsEqual(const SCENE_MATERIAL& first, const SCENE_MATERIAL& second)
+{
+	return (first.tag == second.tag) &&
+		(first.diffuseColor == second.diffuseColor) &&
+		(first.specularColor == second.specularColor) &&
+		(first.shininess == second.shininess);
+}
+
+/***********************************************************
+ *  SceneObjectsEqual()
+ ***********************************************************/
+bool SceneObjectsEqual(const SCENE_OBJECT& first, const SCENE_OBJECT& second)
+{
+	return (first.name == second.name) &&
+		(first.mesh == second.mesh) &&
+		(first.boxSides == second.boxSides) &&
+		(first.scale == second.scale) &&
+		(first.rotation == second.rotation) &&
+		(first.position == second.position) &&
+		(first.color == second.color) &&
+		(first.texture == second.texture) &&
+		(first.uvScale == second.uvScale) &&
+		(first.material == second.material) &&
+		(first.bUseLighting == second.bUseLighting) &&
+		(first.prop == second.prop);
+}
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefile.h
+// ============
+// load scene descriptions from text source files and compiled binary files
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+// basic mesh used by a scene object
+enum SCENE_MESH
+{
+	SCENE_MESH_PLANE,
+	SCENE_MESH_BOX,
+	SCENE_MESH_CYLINDER,
+	SCENE_MESH_SPHERE
+};
+
+// box sides drawn by a box scene object, as bit flags
+enum SCENE_BOX_SIDE
+{
+	SCENE_SIDE_FRONT = 1 << 0,
+	SCENE_SIDE_BACK = 1 << 1,
+	SCENE_SIDE_LEFT = 1 << 2,
+	SCENE_SIDE_RIGHT = 1 << 3,
+	SCENE_SIDE_TOP = 1 << 4,
+	SCENE_SIDE_BOTTOM = 1 << 5,
+	SCENE_SIDE_ALL = (1 << 6) - 1
+};
+
+// kind of scene light
+enum SCENE_LIGHT_TYPE
+{
+	SCENE_LIGHT_DIRECTIONAL,
+	SCENE_LIGHT_POINT
+};
+
+struct SCENE_TEXTURE
+{
+	std::string tag;
+	std::string filename;
+};
+
+struct SCENE_MATERIAL
+{
+	std::string tag;
+	glm::vec3 diffuseColor;
+	glm::vec3 specularColor;
+	float shininess;
+};
+
+struct SCENE_LIGHT
+{
+	int type;
+	// direction for directional lights, position for point lights
+	glm::vec3 vector;
+	glm::vec3 ambient;
+	glm::vec3 diffuse;
+	glm::vec3 specular;
+};
+
+struct SCENE_OBJECT
+{
+	std::string name;
+	int mesh;
+	int boxSides;
+	glm::vec3 scale;
+	glm::vec3 rotation;
+	glm::vec3 position;
+	glm::vec4 color;
+	// empty when the object is drawn with its color only
+	std::string texture;
+	glm::vec2 uvScale;
+	std::string material;
+	bool bUseLighting;
+	// impostor prop the object belongs to, or empty for none
+	std::string prop;
+};
+
+struct SCENE_DESCRIPTION
+{
+	std::vector<SCENE_TEXTURE> textures;
+	std::vector<SCENE_MATERIAL> materials;
+	std::vector<SCENE_LIGHT> lights;
+	std::vector<SCENE_OBJECT> objects;
+};
+
+// modification time of a file, or -1 if it does not exist
+long long GetSceneFileTime(const char* filename);
+
+// parse a human-readable scene source file
+bool ParseSceneText(const char* filename, SCENE_DESCRIPTION& scene);
+// write and read the compiled binary form of a scene
+bool WriteSceneBinary(const char* filename, const SCENE_DESCRIPTION& scene);
+bool ReadSceneBinary(const char* filename, SCENE_DESCRIPTION& scene);
+
+// load a scene source file through its compiled binary, which
+// is rebuilt whenever the source file is newer
+bool LoadSceneDescription(const char* filename, SCENE_DESCRIPTION& scene);
+
+// compare scene entries, used to find what a reload changed
+bool SceneMaterialsEqual(const SCENE_MATERIAL& first, const SCENE_MATERIAL& second);
+bool SceneObjectsEqual(const SCENE_OBJECT& first, const SCENE_OBJECT& second);
@@ -0,0 +1,413 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegeometry.cpp
+// ============
+// basic scene meshes packed into one shared vertex and index buffer
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneGeometry.h"
+#include "ResourceAccounting.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+
+// declaration of global variables
+namespace
+{
+	const float g_Pi = 3.14159265358979f;
+
+	// tessellation matching the ShapeMeshes defaults
+	const int g_CylinderSlices = 36;
+	const int g_SphereStacks = 30;
+	const int g_SphereSectors = 30;
+}
+
+/***********************************************************
+ *  SceneGeometry()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneGeometry::SceneGeometry()
+{
+	m_vertexArrayID = 0;
+	m_vertexBufferID = 0;
+	m_indexBufferID = 0;
+	m_drawIndexBufferID = 0;
+	m_instancesPerDraw = 1;
+	m_meshBaseVertex = 0;
+
+	for (int i = 0; i < GEOMETRY_COUNT; i++)
+	{
+		m_ranges[i].indexCount = 0;
+		m_ranges[i].firstIndex = 0;
+		m_ranges[i].baseVertex = 0;
+	}
+}
+
+/***********************************************************
+ *  ~SceneGeometry()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneGeometry::~SceneGeometry()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to build every mesh into one vertex
+ *  and index list and upload them to the GPU.
+ ***********************************************************/
+bool SceneGeometry::Initialize(int maxDrawsPerFrame)
+{
+	Destroy();
+
+	BuildMeshes();
+
+	// draw index attribute values 0, 1, 2... picked by base instance
+	std::vector<GLint> drawIndices(maxDrawsPerFrame);
+	for (int i = 0; i < maxDrawsPerFrame; i++)
+	{
+		drawIndices[i] = i;
+	}
+
+	glGenVertexArrays(1, &m_vertexArrayID);
+	glGenBuffers(1, &m_vertexBufferID);
+	glGenBuffers(1, &m_indexBufferID);
+	glGenBuffers(1, &m_drawIndexBufferID);
+
+	glBindVertexArray(m_vertexArrayID);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferID);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(VERTEX) * m_vertices.size(), m_vertices.data(), GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(VERTEX), (void*)offsetof(VERTEX, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(VERTEX), (void*)offsetof(VERTEX, normal));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(VERTEX), (void*)offsetof(VERTEX, uv));
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_drawIndexBufferID);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLint) * drawIndices.size(), drawIndices.data(), GL_STATIC_DRAW);
+	glEnableVertexAttribArray(DRAW_INDEX_ATTRIBUTE);
+	glVertexAttribIPointer(DRAW_INDEX_ATTRIBUTE, 1, GL_INT, sizeof(GLint), (void*)0);
+	glVertexAttribDivisor(DRAW_INDEX_ATTRIBUTE, 1);
+	m_instancesPerDraw = 1;
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferID);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * m_indices.size(), m_indices.data(), GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	std::cout << "INFO: Shared scene geometry: " << m_vertices.size() << " vertices, "
+		<< m_indices.size() << " indices" << std::endl;
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_BUFFER, "scene geometry",
+		sizeof(VERTEX) * m_vertices.size() + sizeof(GLuint) * m_indices.size() +
+		sizeof(GLint) * drawIndices.size(), 0);
+
+	// the GPU copies are all that is needed from here on
+	m_vertices.clear();
+	m_vertices.shrink_to_fit();
+	m_indices.clear();
+	m_indices.shrink_to_fit();
+
+	return true;
+}
+
+/***********************************************************
+ *  BuildMeshes()
+ ***********************************************************/
+void SceneGeometry::BuildMeshes()
+{
+	m_vertices.clear();
+	m_indices.clear();
+	BuildPlane();
+	BuildBoxSides();
+	BuildCylinder(g_CylinderSlices);
+	BuildSphere(g_SphereStacks, g_SphereSectors);
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void SceneGeometry::Destroy()
+{
+	if (m_vertexArrayID != 0)
+	{
+		glDeleteVertexArrays(1, &m_vertexArrayID);
+		m_vertexArrayID = 0;
+	}
+	if (m_vertexBufferID != 0)
+	{
+		glDeleteBuffers(1, &m_vertexBufferID);
+		m_vertexBufferID = 0;
+	}
+	if (m_indexBufferID != 0)
+	{
+		glDeleteBuffers(1, &m_indexBufferID);
+		m_indexBufferID = 0;
+	}
+	if (m_drawIndexBufferID != 0)
+	{
+		glDeleteBuffers(1, &m_drawIndexBufferID);
+		m_drawIndexBufferID = 0;
+	}
+	ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_BUFFER, "scene geometry");
+}
+
+/***********************************************************
+ *  Bind()
+ ***********************************************************/
+void SceneGeometry::Bind() const
+{
+	glBindVertexArray(m_vertexArrayID);
+}
+
+/***********************************************************
+ *  SetInstancesPerDraw()
+ *
+ *  This method is used to change the draw index divisor.
+ *  The base instance of a draw still picks its draw index,
+ *  and gl_InstanceID counts the views within it.
+ ***********************************************************/
+void SceneGeometry::SetInstancesPerDraw(int count)
+{
+	if ((count == m_instancesPerDraw) || (m_vertexArrayID == 0))
+		return;
+
+	glBindVertexArray(m_vertexArrayID);
+	glVertexAttribDivisor(DRAW_INDEX_ATTRIBUTE, count);
+	m_instancesPerDraw = count;
+}
+
+/***********************************************************
+ *  BeginMesh()
+ ***********************************************************/
+void SceneGeometry::BeginMesh(GEOMETRY_MESH mesh)
+{
+	m_ranges[mesh].firstIndex = (GLuint)m_indices.size();
+	m_ranges[mesh].baseVertex = (GLint)m_vertices.size();
+	m_meshBaseVertex = m_ranges[mesh].baseVertex;
+}
+
+/***********************************************************
+ *  EndMesh()
+ ***********************************************************/
+void SceneGeometry::EndMesh(GEOMETRY_MESH mesh)
+{
+	m_ranges[mesh].indexCount = (GLuint)m_indices.size() - m_ranges[mesh].firstIndex;
+}
+
+/***********************************************************
+ *  AddVertex()
+ ***********************************************************/
+GLuint SceneGeometry::AddVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& uv)
+{
+	VERTEX vertex;
+	vertex.position = position;
+	vertex.normal = normal;
+	vertex.uv = uv;
+	m_vertices.push_back(vertex);
+
+	// indices are relative to the base vertex of the mesh
+	return (GLuint)(m_vertices.size() - 1 - m_meshBaseVertex);
+}
+
+/***********************************************************
+ *  AddQuad()
+ ***********************************************************/
+void SceneGeometry::AddQuad(const glm::vec3 corners[4], const glm::vec3& normal)
+{
+	const glm::vec2 uvs[4] = {
+		glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) };
+
+	GLuint first = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		GLuint index = AddVertex(corners[i], normal, uvs[i]);
+		if (i == 0)
+			first = index;
+	}
+
+	m_indices.push_back(first);
+	m_indices.push_back(first + 1);
+	m_indices.push_back(first + 2);
+	m_indices.push_back(first);
+	m_indices.push_back(first + 2);
+	m_indices.push_back(first + 3);
+}
+
+/***********************************************************
+ *  BuildPlane()
+ *
+ *  Two unit wide plane in XZ, facing up, like LoadPlaneMesh().
+ ***********************************************************/
+void SceneGeometry::BuildPlane()
+{
+	BeginMesh(GEOMETRY_PLANE);
+	const glm::vec3 corners[4] = {
+		glm::vec3(-1.0f, 0.0f, 1.0f), glm::vec3(1.0f, 0.0f, 1.0f),
+		glm::vec3(1.0f, 0.0f, -1.0f), glm::vec3(-1.0f, 0.0f, -1.0f) };
+	AddQuad(corners, glm::vec3(0.0f, 1.0f, 0.0f));
+	EndMesh(GEOMETRY_PLANE);
+}
+
+/***********************************************************
+ *  BuildBoxSides()
+ *
+ *  Unit box centered on the origin, one mesh per side so a
+ *  side can be drawn on its own like DrawBoxMeshSide().
+ ***********************************************************/
+void SceneGeometry::BuildBoxSides()
+{
+	const float h = 0.5f;
+	const GEOMETRY_MESH sides[6] = {
+		GEOMETRY_BOX_FRONT, GEOMETRY_BOX_BACK, GEOMETRY_BOX_LEFT,
+		GEOMETRY_BOX_RIGHT, GEOMETRY_BOX_TOP, GEOMETRY_BOX_BOTTOM };
+	const glm::vec3 normals[6] = {
+		glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+		glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f),
+		glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f) };
+	// corners of each side, counter-clockwise seen from outside
+	const glm::vec3 corners[6][4] = {
+		{ glm::vec3(-h, -h, h), glm::vec3(h, -h, h), glm::vec3(h, h, h), glm::vec3(-h, h, h) },
+		{ glm::vec3(h, -h, -h), glm::vec3(-h, -h, -h), glm::vec3(-h, h, -h), glm::vec3(h, h, -h) },
+		{ glm::vec3(-h, -h, -h), glm::vec3(-h, -h, h), glm::vec3(-h, h, h), glm::vec3(-h, h, -h) },
+		{ glm::vec3(h, -h, h), glm::vec3(h, -h, -h), glm::vec3(h, h, -h), glm::vec3(h, h, h) },
+		{ glm::vec3(-h, h, h), glm::vec3(h, h, h), glm::vec3(h, h, -h), glm::vec3(-h, h, -h) },
+		{ glm::vec3(-h, -h, -h), glm::vec3(h, -h, -h), glm::vec3(h, -h, h), glm::vec3(-h, -h, h) } };
+
+	for (int side = 0; side < 6; side++)
+	{
+		BeginMesh(sides[side]);
+		AddQuad(corners[side], normals[side]);
+		EndMesh(sides[side]);
+	}
+}
+
+/***********************************************************
+ *  BuildCylinder()
+ *
+ *  Unit radius cylinder from y = 0 to y = 1 with both caps,
+ *  like LoadCylinderMesh() with its default arguments.
+ ***********************************************************/
+void SceneGeometry::BuildCylinder(int slices)
+{
+	BeginMesh(GEOMETRY_CYLINDER);
+
+	// sides, with the seam vertices repeated for the UVs
+	GLuint sideStart = 0;
+	for (int i = 0; i <= slices; i++)
+	{
+		float u = (float)i / slices;
+		float angle = u * 2.0f * g_Pi;
+		glm::vec3 normal(cosf(angle), 0.0f, sinf(angle));
+		GLuint index = AddVertex(glm::vec3(normal.x, 0.0f, normal.z), normal, glm::vec2(u, 0.0f));
+		AddVertex(glm::vec3(normal.x, 1.0f, normal.z), normal, glm::vec2(u, 1.0f));
+		if (i == 0)
+			sideStart = index;
+	}
+	for (int i = 0; i < slices; i++)
+	{
+		GLuint bottom = sideStart + (i * 2);
+		GLuint top = bottom + 1;
+		GLuint nextBottom = bottom + 2;
+		GLuint nextTop = bottom + 3;
+		m_indices.push_back(bottom);
+		m_indices.push_back(top);
+		m_indices.push_back(nextBottom);
+		m_indices.push_back(nextBottom);
+		m_indices.push_back(top);
+		m_indices.push_back(nextTop);
+	}
+
+	// bottom and top caps as triangle fans
+	for (int cap = 0; cap < 2; cap++)
+	{
+		float y = (cap == 0) ? 0.0f : 1.0f;
+		glm::vec3 normal(0.0f, (cap == 0) ? -1.0f : 1.0f, 0.0f);
+		GLuint center = AddVertex(glm::vec3(0.0f, y, 0.0f), normal, glm::vec2(0.5f, 0.5f));
+		for (int i = 0; i <= slices; i++)
+		{
+			float angle = (float)i / slices * 2.0f * g_Pi;
+			AddVertex(glm::vec3(cosf(angle), y, sinf(angle)), normal,
+				glm::vec2(0.5f + 0.5f * cosf(angle), 0.5f + 0.5f * sinf(angle)));
+		}
+		for (int i = 0; i < slices; i++)
+		{
+			// wind each cap to face away from the cylinder
+			m_indices.push_back(center);
+			if (cap == 0)
+			{
+				m_indices.push_back(center + 1 + i);
+				m_indices.push_back(center + 2 + i);
+			}
+			else
+			{
+				m_indices.push_back(center + 2 + i);
+				m_indices.push_back(center + 1 + i);
+			}
+		}
+	}
+
+	EndMesh(GEOMETRY_CYLINDER);
+}
+
+/***********************************************************
+ *  BuildSphere()
+ *
+ *  Unit radius sphere centered on the origin, like
+ *  LoadSphereMesh().
+ ***********************************************************/
+void SceneGeometry::BuildSphere(int stacks, int sectors)
+{
+	BeginMesh(GEOMETRY_SPHERE);
+
+	GLuint start = 0;
+	for (int i = 0; i <= stacks; i++)
+	{
+		float stackAngle = g_Pi / 2.0f - (float)i / stacks * g_Pi;
+		float ringRadius = cosf(stackAngle);
+		float y = sinf(stackAngle);
+		for (int j = 0; j <= sectors; j++)
+		{
+			float sectorAngle = (float)j / sectors * 2.0f * g_Pi;
+			glm::vec3 position(ringRadius * cosf(sectorAngle), y, ringRadius * sinf(sectorAngle));
+			GLuint index = AddVertex(position, position,
+				glm::vec2((float)j / sectors, 1.0f - (float)i / stacks));
+			if ((i == 0) && (j == 0))
+				start = index;
+		}
+	}
+
+	// the poles only get one triangle per sector
+	for (int i = 0; i < stacks; i++)
+	{
+		GLuint ring = start + i * (sectors + 1);
+		GLuint nextRing = ring + sectors + 1;
+		for (int j = 0; j < sectors; j++)
+		{
+			if (i != 0)
+			{
+				m_indices.push_back(ring + j);
+				m_indices.push_back(ring + j + 1);
+				m_indices.push_back(nextRing + j);
+			}
+			if (i != (stacks - 1))
+			{
+				m_indices.push_back(ring + j + 1);
+				m_indices.push_back(nextRing + j + 1);
+				m_indices.push_back(nextRing + j);
+			}
+		}
+	}
+
+	EndMesh(GEOMETRY_SPHERE);
+}
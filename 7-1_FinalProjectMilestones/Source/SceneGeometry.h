@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenegeometry.h
+// ============
+// basic scene meshes packed into one shared vertex and index buffer
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  SceneGeometry
+ *
+ *  This class builds the basic meshes the scene draws with
+ *  (plane, box sides, cylinder and sphere), using the same
+ *  dimensions and vertex layout as ShapeMeshes, but packs
+ *  all of them into a single vertex array. Any mix of them
+ *  can then be drawn with one multi-draw call, each draw
+ *  picking its range by index offset and base vertex.
+ *
+ *  Attribute 3 is an instanced draw index read from a fixed
+ *  0, 1, 2... buffer, so a draw's base instance selects its
+ *  entry in the per-draw data buffer.
+ ***********************************************************/
+class SceneGeometry
+{
+public:
+	// constructor
+	SceneGeometry();
+	// destructor
+	~SceneGeometry();
+
+	enum GEOMETRY_MESH
+	{
+		GEOMETRY_PLANE,
+		GEOMETRY_BOX_FRONT,
+		GEOMETRY_BOX_BACK,
+		GEOMETRY_BOX_LEFT,
+		GEOMETRY_BOX_RIGHT,
+		GEOMETRY_BOX_TOP,
+		GEOMETRY_BOX_BOTTOM,
+		GEOMETRY_CYLINDER,
+		GEOMETRY_SPHERE,
+		GEOMETRY_COUNT
+	};
+
+	// range of the shared buffers that holds one mesh
+	struct MESH_RANGE
+	{
+		GLuint indexCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+	};
+
+	// interleaved position, normal and texture coordinate
+	struct VERTEX
+	{
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 uv;
+	};
+
+	// attribute location of the instanced draw index
+	static const GLuint DRAW_INDEX_ATTRIBUTE = 3;
+
+	// build every mesh and upload the shared buffers
+	bool Initialize(int maxDrawsPerFrame);
+	// free the buffers and vertex array
+	void Destroy();
+	bool IsAvailable() const { return m_vertexArrayID != 0; }
+
+	const MESH_RANGE& GetRange(GEOMETRY_MESH mesh) const { return m_ranges[mesh]; }
+	// build every mesh into the vertex and index lists only,
+	// for code that reads the meshes on the CPU; Initialize()
+	// frees the lists once they are uploaded
+	void BuildMeshes();
+	const std::vector<VERTEX>& GetVertices() const { return m_vertices; }
+	const std::vector<GLuint>& GetIndices() const { return m_indices; }
+	// bind the shared vertex array
+	void Bind() const;
+	// number of consecutive instances that read the same draw
+	// index, so each draw can be instanced once per view
+	void SetInstancesPerDraw(int count);
+
+private:
+	GLuint m_vertexArrayID;
+	GLuint m_vertexBufferID;
+	GLuint m_indexBufferID;
+	GLuint m_drawIndexBufferID;
+	MESH_RANGE m_ranges[GEOMETRY_COUNT];
+	// divisor of the draw index attribute
+	int m_instancesPerDraw;
+
+	// vertices and indices collected while building
+	std::vector<VERTEX> m_vertices;
+	std::vector<GLuint> m_indices;
+	// base vertex of the mesh being built
+	GLint m_meshBaseVertex;
+
+	// start and finish the range of a mesh being built
+	void BeginMesh(GEOMETRY_MESH mesh);
+	void EndMesh(GEOMETRY_MESH mesh);
+	// add one vertex of the current mesh, returning its index
+	// relative to the mesh's base vertex
+	GLuint AddVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& uv);
+	// add a quad from four corners in counter-clockwise order
+	void AddQuad(const glm::vec3 corners[4], const glm::vec3& normal);
+
+	void BuildPlane();
+	void BuildBoxSides();
+	void BuildCylinder(int slices);
+	void BuildSphere(int stacks, int sectors);
+};
@@ -8,6 +8,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SceneManager.h"
+#include "ViewManager.h"
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -16,14 +17,162 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+
 // declaration of global variables
 namespace
 {
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
+	// names the uniform handles are looked up by
+	const std::string g_ModelName = "model";
+	const std::string g_ColorValueName = "objectColor";
+	const std::string g_TextureValueName = "objectTexture";
+	const std::string g_UseTextureName = "bUseTexture";
+	const std::string g_UseLightingName = "bUseLighting";
+	const std::string g_UVScaleName = "UVscale";
+	const std::string g_AtlasRectName = "atlasRect";
+	const std::string g_AtlasRepeatName = "bAtlasRepeat";
+	const std::string g_LightmapTextureName = "lightmapTexture";
+	const std::string g_LightmapRectName = "lightmapRect";
+	const std::string g_ViewName = "view";
+	const std::string g_ProjectionName = "projection";
+	const std::string g_ViewPositionName = "viewPosition";
+	const std::string g_ViewOffsetName = "viewOffset";
+	const std::string g_MaterialDiffuseName = "material.diffuseColor";
+	const std::string g_MaterialSpecularName = "material.specularColor";
+	const std::string g_MaterialShininessName = "material.shininess";
+	const std::string g_SpotLightActiveName = "spotLight.bActive";
+
+	// uniform names of one light in the scene shader
+	struct LIGHT_UNIFORM_NAMES
+	{
+		// position for point lights, direction otherwise
+		std::string vector;
+		std::string ambient;
+		std::string diffuse;
+		std::string specular;
+		std::string bActive;
+
+		LIGHT_UNIFORM_NAMES(const std::string& base, const char* vectorName)
+			: vector(base + "." + vectorName),
+			ambient(base + ".ambient"),
+			diffuse(base + ".diffuse"),
+			specular(base + ".specular"),
+			bActive(base + ".bActive")
+		{
+		}
+	};
+
+	// TOTAL_POINT_LIGHTS in the scene shader
+	const int g_PointLightCount = ShaderPermutations::MAX_POINT_LIGHTS;
+
+	const LIGHT_UNIFORM_NAMES g_DirectionalLightNames("directionalLight", "direction");
+	const LIGHT_UNIFORM_NAMES g_PointLightNames[g_PointLightCount] = {
+		LIGHT_UNIFORM_NAMES("pointLights[0]", "position"),
+		LIGHT_UNIFORM_NAMES("pointLights[1]", "position"),
+		LIGHT_UNIFORM_NAMES("pointLights[2]", "position"),
+		LIGHT_UNIFORM_NAMES("pointLights[3]", "position"),
+		LIGHT_UNIFORM_NAMES("pointLights[4]", "position") };
+
+	// lights of the built-in scene
+	const SCENE_LIGHT g_BuiltInLights[] = {
+		// directional light (main)
+		{ SCENE_LIGHT_DIRECTIONAL, glm::vec3(-0.25f, -1.0f, -0.30f),
+			glm::vec3(0.35f, 0.35f, 0.35f), glm::vec3(0.70f, 0.70f, 0.70f), glm::vec3(0.60f, 0.60f, 0.60f) },
+		// point light 0: above/right
+		{ SCENE_LIGHT_POINT, glm::vec3(3.0f, 3.0f, 2.0f),
+			glm::vec3(0.06f, 0.06f, 0.06f), glm::vec3(0.80f, 0.80f, 0.80f), glm::vec3(0.90f, 0.90f, 0.90f) },
+		// point light 1: fill from opposite side (prevents full shadow)
+		{ SCENE_LIGHT_POINT, glm::vec3(-3.0f, 2.5f, -2.0f),
+			glm::vec3(0.05f, 0.05f, 0.05f), glm::vec3(0.45f, 0.45f, 0.45f), glm::vec3(0.50f, 0.50f, 0.50f) },
+		// point light 2: soft overhead fill (makes the scene look more real)
+		{ SCENE_LIGHT_POINT, glm::vec3(0.0f, 4.0f, 0.0f),
+			glm::vec3(0.03f, 0.03f, 0.03f), glm::vec3(0.35f, 0.35f, 0.35f), glm::vec3(0.20f, 0.20f, 0.20f) } };
+	const int g_BuiltInLightCount = sizeof(g_BuiltInLights) / sizeof(g_BuiltInLights[0]);
+
+	// file the baked lightmap is cached in between runs
+	const char* const g_LightmapCacheFile = "lightmap.cache";
+
+	/***********************************************************
+	 *  HashBytes()
+	 *
+	 *  This function is used to add bytes to a 64 bit FNV-1a
+	 *  hash.
+	 ***********************************************************/
+	unsigned long long HashBytes(unsigned long long hash, const void* pData, size_t size)
+	{
+		const unsigned char* pBytes = (const unsigned char*)pData;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= pBytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return(hash);
+	}
+
+	// draws per frame that fit in the per-draw data buffer
+	const int g_MaxDrawsPerFrame = 1024;
+
+	// low bits of a sort key that hold the position of the
+	// draw in the range being sorted
+	const int g_SortPositionBits = 20;
+	const unsigned long long g_SortPositionMask = (1ull << g_SortPositionBits) - 1;
+
+	// share of the objects that can move in a frame before the
+	// whole hierarchy is refit instead of one object at a time
+	const float g_FullRefitShare = 0.25f;
+
+	// starting size of the per-frame scratch memory
+	const size_t g_FrameArenaSize = 64 * 1024;
+
+	/***********************************************************
+	 *  GetDepthSortValue()
+	 *
+	 *  This function is used to turn a float into an unsigned
+	 *  value with the same order, negative values included.
+	 ***********************************************************/
+	unsigned int GetDepthSortValue(float depth)
+	{
+		unsigned int bits = 0;
+		std::memcpy(&bits, &depth, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+	/***********************************************************
+	 *  HalveImage()
+	 *
+	 *  This function is used to shrink an image to half its
+	 *  size in place, averaging each 2x2 block of texels. An
+	 *  odd last row or column is averaged with itself.
+	 ***********************************************************/
+	void HalveImage(unsigned char* image, int& width, int& height, int colorChannels)
+	{
+		int halfWidth = (width > 1) ? width / 2 : 1;
+		int halfHeight = (height > 1) ? height / 2 : 1;
+		for (int y = 0; y < halfHeight; y++)
+		{
+			int y0 = std::min(y * 2, height - 1);
+			int y1 = std::min(y * 2 + 1, height - 1);
+			for (int x = 0; x < halfWidth; x++)
+			{
+				int x0 = std::min(x * 2, width - 1);
+				int x1 = std::min(x * 2 + 1, width - 1);
+				for (int c = 0; c < colorChannels; c++)
+				{
+					int sum =
+						image[(y0 * width + x0) * colorChannels + c] +
+						image[(y0 * width + x1) * colorChannels + c] +
+						image[(y1 * width + x0) * colorChannels + c] +
+						image[(y1 * width + x1) * colorChannels + c];
+					image[(y * halfWidth + x) * colorChannels + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+		width = halfWidth;
+		height = halfHeight;
+	}
 }
 
 /***********************************************************
@@ -32,11 +181,108 @@ namespace
 SceneManager::SceneManager(ShaderManager* pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
+	m_basicMeshes = NULL;
+	m_pProgramCache = NULL;
 
 	// init texture tracking 
 	m_loadedTextures = 0;
+	m_pTextureAtlas = new TextureAtlas();
 	m_objectMaterials.clear();
+
+	// default state captured by the first recorded draw
+	m_drawState.mesh = MESH_PLANE;
+	m_drawState.boxSide = ShapeMeshes::box_front;
+	m_drawState.model = glm::mat4(1.0f);
+	m_drawState.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	m_drawState.uvScale = glm::vec2(1.0f, 1.0f);
+	m_drawState.textureSlot = 0;
+	m_drawState.materialIndex = -1;
+	m_drawState.bUseTexture = false;
+	m_drawState.bUseLighting = true;
+	m_drawState.viewDepth = 0.0f;
+	m_drawState.objectID = -1;
+	m_drawState.boundsMin = glm::vec3(0.0f);
+	m_drawState.boundsMax = glm::vec3(0.0f);
+	m_drawState.drawDataIndex = -1;
+	m_drawState.lightmapTile = -1;
+	m_drawState.propID = -1;
+	m_bSubmittedStateValid = false;
+
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+
+	m_pDepthPrePass = new DepthPrePass();
+	m_bDepthPrePass = false;
+	m_bOverdrawView = false;
+	m_bOverdrawStats = false;
+
+	m_objectCount = 0;
+	m_transformNode = -1;
+	m_pOcclusionCuller = new OcclusionCuller();
+	m_bOcclusionCulling = false;
+	m_pSceneBVH = new SceneBVH();
+	m_pTransformHierarchy = new TransformHierarchy();
+	m_conditionalObject = -1;
+	m_cameraPosition = glm::vec3(0.0f);
+	m_viewCount = 1;
+	m_views[0].view = glm::mat4(1.0f);
+	m_views[0].projection = glm::mat4(1.0f);
+	m_views[0].position = glm::vec3(0.0f);
+	m_views[0].viewport = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	m_pCameraBuffer = new CameraBuffer();
+	m_pViewLatch = NULL;
+	m_submitView = 0;
+	m_bSinglePassViews = false;
+	for (int i = 0; i < 4; i++)
+	{
+		m_targetViewport[i] = 0;
+	}
+
+	m_bSceneFileLoaded = false;
+	m_sceneFileTime = -1;
+	m_lastSceneCheckTime = 0.0;
+	m_bSceneDirty = true;
+
+	m_pPermutations = NULL;
+	m_bPermutations = false;
+	m_uberProgramID = 0;
+	m_activePermutation = -1;
+	m_frameNumber = 0;
+	for (int i = 0; i < ShaderPermutations::PERMUTATION_COUNT; i++)
+	{
+		m_permutationFrame[i] = 0;
+	}
+	m_bDirectionalLightActive = true;
+	m_activePointLights = 0;
+
+	m_pDrawDataRing = new DrawDataRing();
+	m_bDrawDataBuffer = false;
+	m_bActiveUsesDrawData = false;
+
+	m_pLightBaker = new LightBaker();
+	m_bBakedLighting = true;
+	m_bLightmapDirty = true;
+	m_lightmapUnit = -1;
+
+	m_pImpostorCache = new ImpostorCache();
+	m_bImpostors = true;
+	m_impostorUnit = -1;
+	m_plantProp = -1;
+
+	m_uberUniforms.programID = 0;
+	for (int i = 0; i < ShaderPermutations::PERMUTATION_COUNT; i++)
+	{
+		m_permutationUniforms[i].programID = 0;
+	}
+	m_pActiveUniforms = &m_uberUniforms;
+
+	m_pSceneGeometry = new SceneGeometry();
+	m_bMultiDraw = false;
+
+	m_pFramePasses = new FramePasses(this, m_pDepthPrePass, m_pSceneGeometry);
+
+	m_pFrameArena = new FrameArena();
+	m_pFrameArena->Reserve(g_FrameArenaSize);
 }
 
 /***********************************************************
@@ -45,12 +291,49 @@ SceneManager::SceneManager(ShaderManager* pShaderManager)
 SceneManager::~SceneManager()
 {
 	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
+	// hand the shared textures and meshes back to the cache
+	DestroyGLTextures();
+	if (m_basicMeshes != NULL)
+	{
+		ResourceCache::ReleaseShapeMeshes();
+		m_basicMeshes = NULL;
+	}
+	delete m_pDepthPrePass;
+	m_pDepthPrePass = NULL;
+	delete m_pOcclusionCuller;
+	m_pOcclusionCuller = NULL;
+	delete m_pSceneBVH;
+	m_pSceneBVH = NULL;
+	delete m_pTransformHierarchy;
+	m_pTransformHierarchy = NULL;
+	delete m_pCameraBuffer;
+	m_pCameraBuffer = NULL;
+	m_pViewLatch = NULL;
+	delete m_pPermutations;
+	m_pPermutations = NULL;
+	delete m_pDrawDataRing;
+	m_pDrawDataRing = NULL;
+	delete m_pLightBaker;
+	m_pLightBaker = NULL;
+	delete m_pImpostorCache;
+	m_pImpostorCache = NULL;
+	delete m_pFramePasses;
+	m_pFramePasses = NULL;
+	delete m_pSceneGeometry;
+	m_pSceneGeometry = NULL;
+	delete m_pFrameArena;
+	m_pFrameArena = NULL;
+	delete m_pTextureAtlas;
+	m_pTextureAtlas = NULL;
 }
 
 /***********************************************************
  *  CreateGLTexture()
+ *
+ *  This method is used to load an image into a texture
+ *  slot. An image another scene already loaded with the
+ *  same wrap mode is shared through the resource cache
+ *  instead of being decoded and uploaded again.
  ***********************************************************/
 bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 {
@@ -59,68 +342,152 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 	int colorChannels = 0;
 	GLuint textureID = 0;
 
-	stbi_set_flip_vertically_on_load(true);
-
-	unsigned char* image = stbi_load(filename, &width, &height, &colorChannels, 0);
-
-	if (!image)
+	// a tag that is already loaded gets replaced in its slot
+	int textureSlot = FindTextureSlot(tag.c_str());
+	if ((textureSlot < 0) && (m_loadedTextures >= 16))
 	{
-		std::cout << "Could not load image:" << filename << std::endl;
+		std::cout << "Too many textures to load:" << filename << std::endl;
 		return false;
 	}
 
-	std::cout << "Successfully loaded image:" << filename
-		<< ", width:" << width
-		<< ", height:" << height
-		<< ", channels:" << colorChannels << std::endl;
-
-	glGenTextures(1, &textureID);
-	glBindTexture(GL_TEXTURE_2D, textureID);
+	// WRAP
+	bool bRepeat = !(tag == "keyboard" || tag == "mouse");
+	long long fileTime = GetSceneFileTime(filename);
+	std::string key = ResourceCache::GetTextureKey(filename, fileTime, bRepeat);
 
-	// WRAP (must be set while bound)
-	if (tag == "keyboard" || tag == "mouse")
+	// another scene may already hold the same image
+	const ResourceCache::TEXTURE_RESOURCE* pTexture = ResourceCache::AcquireTexture(key);
+	if (pTexture != NULL)
 	{
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		std::cout << "INFO: Reusing the resident texture " << filename << std::endl;
+		if (pTexture->atlasPixels.empty() == false)
+		{
+			m_pTextureAtlas->AddImage(tag, pTexture->atlasPixels.data(),
+				pTexture->atlasWidth, pTexture->atlasHeight, 4, bRepeat);
+		}
+		textureID = pTexture->textureID;
 	}
 	else
 	{
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	}
+		stbi_set_flip_vertically_on_load(true);
+
+		unsigned char* image = stbi_load(filename, &width, &height, &colorChannels, 0);
 
-	// FILTER
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		if (!image)
+		{
+			std::cout << "Could not load image:" << filename << std::endl;
+			return false;
+		}
 
-	// (optional) aniso
-	float aniso = 0.0f;
-	glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso);
-	if (aniso < 1.0f) aniso = 1.0f;
-	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso);
+		std::cout << "Successfully loaded image:" << filename
+			<< ", width:" << width
+			<< ", height:" << height
+			<< ", channels:" << colorChannels << std::endl;
 
-	// Upload image (while still bound)
-	if (colorChannels == 3)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-	else if (colorChannels == 4)
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-	else
-		return false;
+		// shrink the image until it fits in the texture budget
+		int halvings = ResourceAccounting::GetTextureDownscale(key, width, height, colorChannels);
+		for (int i = 0; i < halvings; i++)
+		{
+			HalveImage(image, width, height, colorChannels);
+		}
+		if (halvings > 0)
+		{
+			std::cout << "INFO: Texture " << tag << " reduced to " << width << "x" << height
+				<< " to fit the texture budget" << std::endl;
+		}
+
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		// WRAP (must be set while bound)
+		if (bRepeat == false)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		}
+		else
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		}
+
+		// FILTER
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// (optional) aniso
+		float aniso = 0.0f;
+		glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso);
+		if (aniso < 1.0f) aniso = 1.0f;
+		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso);
+
+		// Upload image (while still bound)
+		if (colorChannels == 3)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		else if (colorChannels == 4)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		else
+		{
+			stbi_image_free(image);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			glDeleteTextures(1, &textureID);
+			return false;
+		}
+
+		glGenerateMipmap(GL_TEXTURE_2D);
 
-	glGenerateMipmap(GL_TEXTURE_2D);
+		// small and solid color images also get an atlas tile,
+		// with the same wrap mode, which the cache keeps a copy
+		// of for the next scene that loads the image
+		const unsigned char* atlasPixels = NULL;
+		int atlasWidth = 0;
+		int atlasHeight = 0;
+		if (m_pTextureAtlas->AddImage(tag, image, width, height, colorChannels, bRepeat) == true)
+		{
+			const TextureAtlas::ATLAS_ENTRY& atlasEntry =
+				m_pTextureAtlas->GetEntry(m_pTextureAtlas->FindEntry(tag));
+			atlasPixels = atlasEntry.pixels.data();
+			atlasWidth = atlasEntry.width;
+			atlasHeight = atlasEntry.height;
+		}
 
-	stbi_image_free(image);
-	glBindTexture(GL_TEXTURE_2D, 0);
+		stbi_image_free(image);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		ResourceCache::AddTexture(key, textureID, width, height, colorChannels,
+			atlasPixels, atlasWidth, atlasHeight);
+	}
 
 	// register + return true
-	m_textureIDs[m_loadedTextures].ID = textureID;
-	m_textureIDs[m_loadedTextures].tag = tag;
-	m_loadedTextures++;
+	if (textureSlot >= 0)
+	{
+		ResourceCache::ReleaseTexture(m_textureIDs[textureSlot].ID);
+	}
+	else
+	{
+		textureSlot = m_loadedTextures;
+		m_loadedTextures++;
+	}
+	m_textureIDs[textureSlot].ID = textureID;
+	m_textureIDs[textureSlot].tag = tag;
+	m_textureIDs[textureSlot].filename = filename;
+	m_textureIDs[textureSlot].fileTime = fileTime;
+	m_textureIDs[textureSlot].atlasUnit = -1;
+	m_textureIDs[textureSlot].atlasRect = glm::vec4(0.0f);
+	m_textureIDs[textureSlot].bAtlasRepeat = false;
+
 	return true;
 }
 
 /***********************************************************
  *  BindGLTextures()
+ *
+ *  This method is used to bind every loaded texture to the
+ *  unit of its slot, and the atlas pages and the lightmap
+ *  to the units after them, keeping one more unit for the
+ *  impostors. The course shader samples whole textures, so
+ *  the textures with an atlas tile keep their own unit for
+ *  it.
  ***********************************************************/
 void SceneManager::BindGLTextures()
 {
@@ -129,189 +496,1730 @@ void SceneManager::BindGLTextures()
 		glActiveTexture(GL_TEXTURE0 + i);
 		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
 	}
+
+	m_pTextureAtlas->Build();
+
+	GLint maxUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+	int pageCount = m_pTextureAtlas->GetPageCount();
+	if (m_loadedTextures + pageCount > maxUnits)
+	{
+		std::cout << "INFO: No texture units left for the atlas pages" << std::endl;
+		pageCount = 0;
+	}
+	for (int page = 0; page < pageCount; page++)
+	{
+		glActiveTexture(GL_TEXTURE0 + m_loadedTextures + page);
+		glBindTexture(GL_TEXTURE_2D, m_pTextureAtlas->GetPageTexture(page));
+	}
+	m_lightmapUnit = -1;
+	if (m_pLightBaker->IsAvailable() == true)
+	{
+		if (m_loadedTextures + pageCount < maxUnits)
+		{
+			m_lightmapUnit = m_loadedTextures + pageCount;
+			glActiveTexture(GL_TEXTURE0 + m_lightmapUnit);
+			glBindTexture(GL_TEXTURE_2D, m_pLightBaker->GetTexture());
+		}
+		else
+		{
+			std::cout << "INFO: No texture unit left for the lightmap" << std::endl;
+		}
+	}
+	m_impostorUnit = m_loadedTextures + pageCount + ((m_lightmapUnit >= 0) ? 1 : 0);
+	if (m_impostorUnit >= maxUnits)
+	{
+		std::cout << "INFO: No texture unit left for the impostors" << std::endl;
+		m_impostorUnit = -1;
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		TEXTURE_INFO& texture = m_textureIDs[i];
+		int entry = m_pTextureAtlas->FindEntry(texture.tag);
+		texture.atlasUnit = -1;
+		if ((entry >= 0) && (pageCount > 0))
+		{
+			const TextureAtlas::ATLAS_ENTRY& atlasEntry = m_pTextureAtlas->GetEntry(entry);
+			texture.atlasUnit = m_loadedTextures + atlasEntry.page;
+			texture.atlasRect = atlasEntry.rect;
+			texture.bAtlasRepeat = atlasEntry.bRepeat;
+		}
+	}
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		ResourceCache::ReleaseTexture(m_textureIDs[i].ID);
+		m_textureIDs[i].ID = 0;
+	}
+	m_loadedTextures = 0;
+	m_pTextureAtlas->Clear();
+}
+
+/***********************************************************
+ *  DestroyGLTexture()
+ ***********************************************************/
+void SceneManager::DestroyGLTexture(int textureSlot)
+{
+	if ((textureSlot < 0) || (textureSlot >= m_loadedTextures))
+		return;
+
+	ResourceCache::ReleaseTexture(m_textureIDs[textureSlot].ID);
+	m_pTextureAtlas->RemoveImage(m_textureIDs[textureSlot].tag);
+
+	// keep the loaded textures packed, BindGLTextures()
+	// has to be called again afterwards
+	m_loadedTextures--;
+	m_textureIDs[textureSlot] = m_textureIDs[m_loadedTextures];
+}
+
+/***********************************************************
+ *  UsesTextureAtlas()
+ *
+ *  This method is used to decide whether a draw samples
+ *  its atlas tile. Only the permutation shaders map texture
+ *  coordinates into a tile, so draws that end up on the
+ *  course shader keep sampling their own texture.
+ ***********************************************************/
+bool SceneManager::UsesTextureAtlas(const DRAW_COMMAND& command)
+{
+	return (m_bPermutations == true) &&
+		(command.bUseTexture == true) &&
+		(command.textureSlot >= 0) &&
+		(command.textureSlot < m_loadedTextures) &&
+		(m_textureIDs[command.textureSlot].atlasUnit >= 0) &&
+		(m_pPermutations->GetProgram(GetPermutationKey(command)) != 0);
+}
+
+/***********************************************************
+ *  GetTextureUnit()
+ ***********************************************************/
+int SceneManager::GetTextureUnit(const DRAW_COMMAND& command)
+{
+	if (UsesTextureAtlas(command) == true)
+		return m_textureIDs[command.textureSlot].atlasUnit;
+	return command.textureSlot;
+}
+
+/***********************************************************
+ *  FindTextureID()
+ ***********************************************************/
+int SceneManager::FindTextureID(const char* tag)
+{
+	int textureID = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_loadedTextures) && (bFound == false))
+	{
+		if (m_textureIDs[index].tag.compare(tag) == 0)
+		{
+			textureID = m_textureIDs[index].ID;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const char* tag)
+{
+	int textureSlot = -1;
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < m_loadedTextures) && (bFound == false))
+	{
+		if (m_textureIDs[index].tag.compare(tag) == 0)
+		{
+			textureSlot = index;
+			bFound = true;
+		}
+		else
+			index++;
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ ***********************************************************/
+bool SceneManager::FindMaterial(const char* tag, OBJECT_MATERIAL& material)
+{
+	if (m_objectMaterials.size() == 0)
+		return false;
+
+	int index = 0;
+	bool bFound = false;
+
+	while ((index < (int)m_objectMaterials.size()) && (bFound == false))
+	{
+		if (m_objectMaterials[index].tag.compare(tag) == 0)
+		{
+			bFound = true;
+			material.diffuseColor = m_objectMaterials[index].diffuseColor;
+			material.specularColor = m_objectMaterials[index].specularColor;
+			material.shininess = m_objectMaterials[index].shininess;
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	return bFound;
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const char* tag)
+{
+	for (int index = 0; index < (int)m_objectMaterials.size(); index++)
+	{
+		if (m_objectMaterials[index].tag.compare(tag) == 0)
+			return(index);
+	}
+
+	return(-1);
+}
+
+/***********************************************************
+ *  SetTransformations()
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	glm::mat4 modelView;
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	scale = glm::scale(scaleXYZ);
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	translation = glm::translate(positionXYZ);
+
+	modelView = translation * rotationZ * rotationY * rotationX * scale;
+
+	m_drawState.model = modelView;
+	m_transformNode = -1;
+
+	// every new transform starts a new scene object
+	m_drawState.objectID = m_objectCount;
+	m_objectCount++;
+}
+
+/***********************************************************
+ *  SetTransformNode()
+ *
+ *  This method is used to draw the next meshes with the
+ *  world matrix of a transform node, starting a new scene
+ *  object like SetTransformations() does.
+ ***********************************************************/
+void SceneManager::SetTransformNode(int node)
+{
+	m_drawState.model = m_pTransformHierarchy->GetWorldMatrix(node);
+	m_transformNode = node;
+
+	m_drawState.objectID = m_objectCount;
+	m_objectCount++;
+}
+
+/***********************************************************
+ *  BeginProp()
+ ***********************************************************/
+void SceneManager::BeginProp(int prop)
+{
+	m_drawState.propID = prop;
+}
+
+/***********************************************************
+ *  EndProp()
+ ***********************************************************/
+void SceneManager::EndProp()
+{
+	m_drawState.propID = -1;
+}
+
+/***********************************************************
+ *  SetNodeTransform()
+ ***********************************************************/
+void SceneManager::SetNodeTransform(int node, const glm::vec3& scale,
+	const glm::vec3& rotationDegrees, const glm::vec3& position)
+{
+	m_pTransformHierarchy->SetLocalTransform(node, scale, rotationDegrees, position);
+	m_bSceneDirty = true;
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	glm::vec4 currentColor;
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	m_drawState.bUseTexture = false;
+	m_drawState.color = currentColor;
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ ***********************************************************/
+void SceneManager::SetShaderTexture(const char* textureTag)
+{
+	m_drawState.bUseTexture = true;
+
+	// an unknown tag leaves the previous texture selected,
+	// the same as the sampler rejecting a slot of -1
+	int textureSlot = FindTextureSlot(textureTag);
+	if (textureSlot >= 0)
+	{
+		m_drawState.textureSlot = textureSlot;
+	}
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	m_drawState.uvScale = glm::vec2(u, v);
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(const char* materialTag)
+{
+	int materialIndex = FindMaterialIndex(materialTag);
+	if (materialIndex >= 0)
+	{
+		m_drawState.materialIndex = materialIndex;
+	}
+}
+
+/***********************************************************
+ *  SetViews()
+ *
+ *  This method is used to set the views of the frame. The
+ *  first view's camera is also used for draw sorting, the
+ *  depth pre-pass and occlusion culling.
+ ***********************************************************/
+void SceneManager::SetViews(const CameraBuffer::CAMERA_VIEW* pViews, int viewCount)
+{
+	if (viewCount > CameraBuffer::MAX_VIEWS)
+		viewCount = CameraBuffer::MAX_VIEWS;
+	if (viewCount < 1)
+		return;
+
+	for (int i = 0; i < viewCount; i++)
+	{
+		m_views[i] = pViews[i];
+	}
+	m_viewCount = viewCount;
+
+	m_viewMatrix = pViews[0].view;
+	m_projectionMatrix = pViews[0].projection;
+	m_cameraPosition = pViews[0].position;
+}
+
+/***********************************************************
+ *  SetDepthPrePass()
+ ***********************************************************/
+void SceneManager::SetDepthPrePass(bool bEnabled)
+{
+	m_bDepthPrePass = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Depth pre-pass " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  SetOverdrawView()
+ ***********************************************************/
+void SceneManager::SetOverdrawView(bool bEnabled)
+{
+	m_bOverdrawView = bEnabled;
+	m_pDepthPrePass->SetReportEnabled(m_bOverdrawView || m_bOverdrawStats);
+	m_bSceneDirty = true;
+	std::cout << "INFO: Overdraw view " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  SetOverdrawStats()
+ ***********************************************************/
+void SceneManager::SetOverdrawStats(bool bEnabled)
+{
+	m_bOverdrawStats = bEnabled;
+	m_pDepthPrePass->SetReportEnabled(m_bOverdrawView || m_bOverdrawStats);
+}
+
+/***********************************************************
+ *  LoadSceneFile()
+ *
+ *  This method is used to load the scene from a scene file.
+ *  Once loaded, the scene file replaces the built-in scene
+ *  and is watched for changes.
+ ***********************************************************/
+bool SceneManager::LoadSceneFile(const char* filename)
+{
+	SCENE_DESCRIPTION scene;
+	if (LoadSceneDescription(filename, scene) == false)
+	{
+		std::cout << "Using the built-in scene" << std::endl;
+		return false;
+	}
+
+	m_sceneFilename = filename;
+	m_sceneFileTime = GetSceneFileTime(filename);
+	ApplySceneDescription(scene);
+	m_bSceneFileLoaded = true;
+	return true;
+}
+
+/***********************************************************
+ *  CheckSceneReload()
+ *
+ *  This method is used to watch the scene file. When it
+ *  changes, the new scene is applied on top of the running
+ *  one, so only what changed gets reloaded.
+ ***********************************************************/
+void SceneManager::CheckSceneReload()
+{
+	if (m_bSceneFileLoaded == false)
+		return;
+
+	// checking the file a few times a second is plenty
+	double currentTime = std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+	if (currentTime - m_lastSceneCheckTime < 0.5)
+		return;
+	m_lastSceneCheckTime = currentTime;
+
+	long long fileTime = GetSceneFileTime(m_sceneFilename.c_str());
+	if ((fileTime < 0) || (fileTime == m_sceneFileTime))
+		return;
+	m_sceneFileTime = fileTime;
+
+	// a file caught halfway through saving fails to parse,
+	// and is picked up again on its next change
+	SCENE_DESCRIPTION scene;
+	if (ParseSceneText(m_sceneFilename.c_str(), scene) == false)
+		return;
+
+	WriteSceneBinary((m_sceneFilename + "b").c_str(), scene);
+	ApplySceneDescription(scene);
+}
+
+/***********************************************************
+ *  ApplySceneDescription()
+ *
+ *  This method is used to apply a scene description. Images
+ *  are only decoded for textures that are new, point at a
+ *  different file or whose file changed on disk.
+ ***********************************************************/
+void SceneManager::ApplySceneDescription(const SCENE_DESCRIPTION& scene)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	m_bSceneDirty = true;
+	m_bLightmapDirty = true;
+
+	int texturesLoaded = 0;
+	int texturesRemoved = 0;
+	int materialsChanged = 0;
+	int objectsChanged = 0;
+
+	// drop textures the scene no longer uses
+	for (int slot = m_loadedTextures - 1; slot >= 0; slot--)
+	{
+		bool bUsed = false;
+		for (const SCENE_TEXTURE& texture : scene.textures)
+		{
+			if (texture.tag == m_textureIDs[slot].tag)
+				bUsed = true;
+		}
+		if (bUsed == false)
+		{
+			DestroyGLTexture(slot);
+			texturesRemoved++;
+		}
+	}
+
+	// load new and changed textures
+	for (const SCENE_TEXTURE& texture : scene.textures)
+	{
+		int slot = FindTextureSlot(texture.tag.c_str());
+		if ((slot >= 0) &&
+			(m_textureIDs[slot].filename == texture.filename) &&
+			(m_textureIDs[slot].fileTime == GetSceneFileTime(texture.filename.c_str())))
+			continue;
+
+		if (CreateGLTexture(texture.filename.c_str(), texture.tag) == true)
+			texturesLoaded++;
+	}
+	if ((texturesLoaded > 0) || (texturesRemoved > 0))
+	{
+		BindGLTextures();
+	}
+
+	// update materials in place, so unchanged ones keep their index
+	for (const SCENE_MATERIAL& sceneMaterial : scene.materials)
+	{
+		OBJECT_MATERIAL material;
+		material.tag = sceneMaterial.tag;
+		material.diffuseColor = sceneMaterial.diffuseColor;
+		material.specularColor = sceneMaterial.specularColor;
+		material.shininess = sceneMaterial.shininess;
+
+		int index = FindMaterialIndex(material.tag.c_str());
+		if (index < 0)
+		{
+			m_objectMaterials.push_back(material);
+			materialsChanged++;
+			continue;
+		}
+
+		SCENE_MATERIAL current;
+		current.tag = m_objectMaterials[index].tag;
+		current.diffuseColor = m_objectMaterials[index].diffuseColor;
+		current.specularColor = m_objectMaterials[index].specularColor;
+		current.shininess = m_objectMaterials[index].shininess;
+		if (SceneMaterialsEqual(current, sceneMaterial) == false)
+		{
+			m_objectMaterials[index] = material;
+			materialsChanged++;
+		}
+	}
+	for (int index = (int)m_objectMaterials.size() - 1; index >= 0; index--)
+	{
+		bool bUsed = false;
+		for (const SCENE_MATERIAL& sceneMaterial : scene.materials)
+		{
+			if (sceneMaterial.tag == m_objectMaterials[index].tag)
+				bUsed = true;
+		}
+		if (bUsed == false)
+		{
+			m_objectMaterials.erase(m_objectMaterials.begin() + index);
+			materialsChanged++;
+		}
+	}
+
+	// objects are recorded every frame, so they only need counting
+	size_t objectCount = std::max(scene.objects.size(), m_scene.objects.size());
+	for (size_t index = 0; index < objectCount; index++)
+	{
+		if ((index >= scene.objects.size()) || (index >= m_scene.objects.size()) ||
+			(SceneObjectsEqual(scene.objects[index], m_scene.objects[index]) == false))
+			objectsChanged++;
+	}
+
+	// scene file objects are placed by transform nodes too,
+	// replacing the built-in ones. With the same object count
+	// the nodes are moved in place, so a reload recomputes
+	// only the objects whose transform changed.
+	if (m_sceneObjectNodes.size() == scene.objects.size())
+	{
+		for (size_t index = 0; index < scene.objects.size(); index++)
+		{
+			const SCENE_OBJECT& object = scene.objects[index];
+			m_pTransformHierarchy->SetLocalTransform(m_sceneObjectNodes[index],
+				object.scale, object.rotation, object.position);
+		}
+	}
+	else
+	{
+		m_pTransformHierarchy->Clear();
+		m_sceneObjectNodes.clear();
+		for (const SCENE_OBJECT& object : scene.objects)
+		{
+			m_sceneObjectNodes.push_back(m_pTransformHierarchy->AddNode(-1,
+				object.scale, object.rotation, object.position));
+		}
+	}
+
+	m_scene = scene;
+
+	// objects of a prop are captured and faded together, the
+	// prop being registered the first time a scene uses it
+	m_sceneObjectProps.clear();
+	for (const SCENE_OBJECT& object : m_scene.objects)
+	{
+		int prop = -1;
+		if (!object.prop.empty())
+		{
+			prop = m_pImpostorCache->FindProp(object.prop.c_str());
+			if (prop < 0)
+				prop = m_pImpostorCache->AddProp(object.prop.c_str());
+		}
+		m_sceneObjectProps.push_back(prop);
+	}
+
+	double milliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "INFO: Scene applied in " << milliseconds << " ms ("
+		<< texturesLoaded << " textures loaded, "
+		<< texturesRemoved << " removed, "
+		<< materialsChanged << " materials changed, "
+		<< objectsChanged << " objects changed)" << std::endl;
+}
+
+/***********************************************************
+ *  SetShaderPermutations()
+ ***********************************************************/
+void SceneManager::SetShaderPermutations(bool bEnabled)
+{
+	m_bPermutations = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Shader permutations " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  GetPermutationKey()
+ ***********************************************************/
+int SceneManager::GetPermutationKey(const DRAW_COMMAND& command)
+{
+	return ShaderPermutations::GetKey(
+		command.bUseTexture,
+		command.bUseLighting,
+		m_bDirectionalLightActive,
+		m_activePointLights,
+		command.drawDataIndex >= 0,
+		command.lightmapTile >= 0);
+}
+
+/***********************************************************
+ *  SetDrawDataBuffer()
+ ***********************************************************/
+void SceneManager::SetDrawDataBuffer(bool bEnabled)
+{
+	m_bDrawDataBuffer = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Per-draw data buffer " << (bEnabled ? "enabled" : "disabled") << std::endl;
+	if ((bEnabled == true) && (m_bPermutations == false))
+	{
+		std::cout << "INFO: Per-draw data buffer is only used with shader permutations" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  IsDrawDataActive()
+ ***********************************************************/
+bool SceneManager::IsDrawDataActive() const
+{
+	return (m_bPermutations == true) &&
+		(m_bDrawDataBuffer == true) &&
+		(m_pDrawDataRing->IsAvailable() == true);
+}
+
+/***********************************************************
+ *  WriteDrawData()
+ *
+ *  This method is used to copy the per-draw values of every
+ *  recorded draw into this frame's region of the buffer.
+ *  Draws that do not fit keep a slot of -1 and fall back to
+ *  setting uniforms.
+ ***********************************************************/
+void SceneManager::WriteDrawData()
+{
+	m_pDrawDataRing->BeginFrame();
+
+	DrawDataRing::DRAW_DATA data;
+	for (DRAW_COMMAND& command : m_drawCommands)
+	{
+		data.model = command.model;
+		data.color = command.color;
+		data.uvScale = glm::vec4(command.uvScale, 0.0f, 0.0f);
+		data.atlasRect = glm::vec4(0.0f);
+		if (UsesTextureAtlas(command) == true)
+		{
+			const TEXTURE_INFO& texture = m_textureIDs[command.textureSlot];
+			data.uvScale.z = (texture.bAtlasRepeat == true) ? 1.0f : 0.0f;
+			data.atlasRect = texture.atlasRect;
+		}
+		data.diffuseColor = glm::vec4(0.0f);
+		data.specularColor = glm::vec4(0.0f);
+		if ((command.materialIndex >= 0) &&
+			(command.materialIndex < (int)m_objectMaterials.size()))
+		{
+			const OBJECT_MATERIAL& material = m_objectMaterials[command.materialIndex];
+			data.diffuseColor = glm::vec4(material.diffuseColor, material.shininess);
+			data.specularColor = glm::vec4(material.specularColor, 0.0f);
+		}
+		data.lightmapRect = (command.lightmapTile >= 0) ?
+			m_pLightBaker->GetTileRect(command.lightmapTile) : glm::vec4(0.0f);
+
+		command.drawDataIndex = m_pDrawDataRing->Append(data);
+	}
+
+	m_pDrawDataRing->Bind();
+}
+
+/***********************************************************
+ *  SetBakedLighting()
+ ***********************************************************/
+void SceneManager::SetBakedLighting(bool bEnabled)
+{
+	m_bBakedLighting = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Baked lighting " << (bEnabled ? "enabled" : "disabled") << std::endl;
+	if ((bEnabled == true) && (m_bPermutations == false))
+	{
+		std::cout << "INFO: Baked lighting is only used with shader permutations" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  BakeLighting()
+ *
+ *  This method is used to bake every lit plane and box side
+ *  recorded this frame, where each one is placed now. The
+ *  baker keeps a cache file, so an unchanged scene is only
+ *  baked on its first run.
+ ***********************************************************/
+void SceneManager::BakeLighting()
+{
+	m_bLightmapDirty = false;
+
+	std::vector<LightBaker::BAKE_SURFACE> surfaces;
+	for (const DRAW_COMMAND& command : m_drawCommands)
+	{
+		SceneGeometry::GEOMETRY_MESH mesh = GetGeometryMesh(command);
+		if ((command.bUseLighting == false) || (command.objectID < 0) ||
+			(LightBaker::CanBake(mesh) == false))
+			continue;
+
+		LightBaker::BAKE_SURFACE surface;
+		surface.objectID = command.objectID;
+		surface.mesh = mesh;
+		surface.model = command.model;
+		surfaces.push_back(surface);
+	}
+
+	SCENE_LIGHT lights[g_PointLightCount + 1];
+	int lightCount = GetSceneLights(lights);
+	if (m_pLightBaker->Bake(surfaces, lights, lightCount, g_LightmapCacheFile) == false)
+	{
+		std::cout << "INFO: Nothing to bake, surfaces are lit per fragment" << std::endl;
+	}
+
+	// the lightmap takes the unit after the atlas pages
+	BindGLTextures();
+}
+
+/***********************************************************
+ *  AssignLightmapTiles()
+ *
+ *  This method is used to find the lightmap tile of every
+ *  recorded draw. Draws without one, such as objects that
+ *  moved after the bake, keep the full lighting.
+ ***********************************************************/
+void SceneManager::AssignLightmapTiles()
+{
+	bool bBaked = (m_bPermutations == true) &&
+		(m_bBakedLighting == true) &&
+		(m_lightmapUnit >= 0);
+
+	for (DRAW_COMMAND& command : m_drawCommands)
+	{
+		command.lightmapTile = -1;
+		if ((bBaked == true) && (command.bUseLighting == true))
+		{
+			command.lightmapTile = m_pLightBaker->FindTile(
+				command.objectID, GetGeometryMesh(command), command.model);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetImpostors()
+ ***********************************************************/
+void SceneManager::SetImpostors(bool bEnabled)
+{
+	m_bImpostors = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Prop impostors " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  UpdateImpostors()
+ *
+ *  This method is used to place each prop at the bounds of
+ *  its recorded draws and fade its impostor in by distance.
+ *  A prop is only captured once its impostor is needed, and
+ *  again only when its key changes. Several views, or the
+ *  overdraw view, keep every prop on its full geometry.
+ ***********************************************************/
+void SceneManager::UpdateImpostors()
+{
+	bool bImpostors = (m_bImpostors == true) &&
+		(m_pImpostorCache->IsAvailable() == true) &&
+		(m_impostorUnit >= 0) &&
+		(m_viewCount == 1) &&
+		(m_bOverdrawView == false);
+
+	for (int prop = 0; prop < m_pImpostorCache->GetPropCount(); prop++)
+	{
+		bool bFound = false;
+		glm::vec3 boundsMin(0.0f);
+		glm::vec3 boundsMax(0.0f);
+		for (const DRAW_COMMAND& command : m_drawCommands)
+		{
+			if (command.propID != prop)
+				continue;
+			boundsMin = (bFound == true) ? glm::min(boundsMin, command.boundsMin) : command.boundsMin;
+			boundsMax = (bFound == true) ? glm::max(boundsMax, command.boundsMax) : command.boundsMax;
+			bFound = true;
+		}
+		if ((bImpostors == false) || (bFound == false))
+		{
+			m_pImpostorCache->HideProp(prop);
+			continue;
+		}
+
+		m_pImpostorCache->UpdateProp(prop, boundsMin, boundsMax, m_cameraPosition);
+		if (m_pImpostorCache->GetFade(prop) <= 0.0f)
+			continue;
+
+		unsigned long long key = GetPropKey(prop);
+		if (m_pImpostorCache->NeedsCapture(prop, key) == true)
+		{
+			CaptureImpostor(prop, key);
+		}
+	}
+}
+
+/***********************************************************
+ *  GetPropKey()
+ *
+ *  This method is used to hash what a prop's capture shows:
+ *  the placement, mesh, texture and material of each of its
+ *  draws and the lights they are lit by.
+ ***********************************************************/
+unsigned long long SceneManager::GetPropKey(int prop)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	for (const DRAW_COMMAND& command : m_drawCommands)
+	{
+		if (command.propID != prop)
+			continue;
+
+		hash = HashBytes(hash, &command.model[0][0], sizeof(float) * 16);
+		hash = HashBytes(hash, &command.mesh, sizeof(command.mesh));
+		hash = HashBytes(hash, &command.boxSide, sizeof(command.boxSide));
+		hash = HashBytes(hash, &command.color[0], sizeof(float) * 4);
+		hash = HashBytes(hash, &command.uvScale[0], sizeof(float) * 2);
+		hash = HashBytes(hash, &command.bUseLighting, sizeof(command.bUseLighting));
+		GLuint textureID = 0;
+		if ((command.bUseTexture == true) && (command.textureSlot >= 0) &&
+			(command.textureSlot < m_loadedTextures))
+		{
+			textureID = m_textureIDs[command.textureSlot].ID;
+		}
+		hash = HashBytes(hash, &textureID, sizeof(textureID));
+		if ((command.materialIndex >= 0) &&
+			(command.materialIndex < (int)m_objectMaterials.size()))
+		{
+			const OBJECT_MATERIAL& material = m_objectMaterials[command.materialIndex];
+			hash = HashBytes(hash, &material.diffuseColor[0], sizeof(float) * 3);
+			hash = HashBytes(hash, &material.specularColor[0], sizeof(float) * 3);
+			hash = HashBytes(hash, &material.shininess, sizeof(material.shininess));
+		}
+	}
+
+	SCENE_LIGHT lights[g_PointLightCount + 1];
+	int lightCount = GetSceneLights(lights);
+	for (int i = 0; i < lightCount; i++)
+	{
+		hash = HashBytes(hash, &lights[i].type, sizeof(lights[i].type));
+		hash = HashBytes(hash, &lights[i].vector[0], sizeof(float) * 3);
+		hash = HashBytes(hash, &lights[i].ambient[0], sizeof(float) * 3);
+		hash = HashBytes(hash, &lights[i].diffuse[0], sizeof(float) * 3);
+		hash = HashBytes(hash, &lights[i].specular[0], sizeof(float) * 3);
+	}
+	return(hash);
+}
+
+/***********************************************************
+ *  CaptureImpostor()
+ *
+ *  This method is used to draw a prop once for every cell
+ *  of its atlas, through the same programs and draw state
+ *  as the frame, with the cell's camera standing in for the
+ *  first view. The frame's view and render target are put
+ *  back afterwards.
+ ***********************************************************/
+void SceneManager::CaptureImpostor(int prop, unsigned long long key)
+{
+	GLint framebuffer = 0;
+	glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &framebuffer);
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	CameraBuffer::CAMERA_VIEW frameView = m_views[0];
+	GLint frameTarget[4];
+	std::memcpy(frameTarget, m_targetViewport, sizeof(frameTarget));
+
+	m_pImpostorCache->BeginCapture(prop);
+	m_targetViewport[0] = 0;
+	m_targetViewport[1] = 0;
+	m_targetViewport[2] = m_pImpostorCache->GetAtlasWidth();
+	m_targetViewport[3] = m_pImpostorCache->GetAtlasHeight();
+	m_bSubmittedStateValid = false;
+
+	for (int cell = 0; cell < ImpostorCache::CELL_COUNT; cell++)
+	{
+		m_views[0] = m_pImpostorCache->GetCaptureView(prop, cell);
+		m_pCameraBuffer->Update(m_views, 1);
+		m_pCameraBuffer->Bind();
+		SelectView(0);
+		for (int index = 0; index < (int)m_drawCommands.size(); index++)
+		{
+			if (m_drawCommands[index].propID != prop)
+				continue;
+			ApplyDrawState(index);
+			DrawRecordedMesh(index);
+		}
+	}
+	m_pImpostorCache->EndCapture(prop, key);
+
+	m_views[0] = frameView;
+	std::memcpy(m_targetViewport, frameTarget, sizeof(frameTarget));
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	RestoreSceneProgram();
+	ShaderUniforms::Set(m_uberUniforms.view, frameView.view);
+	ShaderUniforms::Set(m_uberUniforms.projection, frameView.projection);
+	ShaderUniforms::Set(m_uberUniforms.viewPosition, frameView.position);
+}
+
+/***********************************************************
+ *  DrawImpostors()
+ ***********************************************************/
+void SceneManager::DrawImpostors()
+{
+	if (m_pImpostorCache->Draw(m_viewMatrix, m_projectionMatrix, m_cameraPosition, m_impostorUnit) == true)
+	{
+		RestoreSceneProgram();
+	}
+}
+
+/***********************************************************
+ *  SetMultiDraw()
+ ***********************************************************/
+void SceneManager::SetMultiDraw(bool bEnabled)
+{
+	m_bMultiDraw = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Multi-draw indirect " << (bEnabled ? "enabled" : "disabled") << std::endl;
+	if ((bEnabled == true) && (IsDrawDataActive() == false))
+	{
+		std::cout << "INFO: Multi-draw indirect is only used with the per-draw data buffer" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  IsMultiDrawActive()
+ *
+ *  Conditional rendering works on single draws, so with
+ *  occlusion culling on the draws are submitted one by one.
+ ***********************************************************/
+bool SceneManager::IsMultiDrawActive() const
+{
+	return (m_bMultiDraw == true) &&
+		(m_bOcclusionCulling == false) &&
+		(m_pFramePasses->IsMultiDrawAvailable() == true) &&
+		(m_pSceneGeometry->IsAvailable() == true) &&
+		(IsDrawDataActive() == true);
+}
+
+/***********************************************************
+ *  GetGeometryMesh()
+ ***********************************************************/
+SceneGeometry::GEOMETRY_MESH SceneManager::GetGeometryMesh(const DRAW_COMMAND& command) const
+{
+	switch (command.mesh)
+	{
+	case MESH_BOX_SIDE:
+		switch (command.boxSide)
+		{
+		case ShapeMeshes::box_front:
+			return SceneGeometry::GEOMETRY_BOX_FRONT;
+		case ShapeMeshes::box_back:
+			return SceneGeometry::GEOMETRY_BOX_BACK;
+		case ShapeMeshes::box_left:
+			return SceneGeometry::GEOMETRY_BOX_LEFT;
+		case ShapeMeshes::box_right:
+			return SceneGeometry::GEOMETRY_BOX_RIGHT;
+		case ShapeMeshes::box_top:
+			return SceneGeometry::GEOMETRY_BOX_TOP;
+		default:
+			return SceneGeometry::GEOMETRY_BOX_BOTTOM;
+		}
+	case MESH_CYLINDER:
+		return SceneGeometry::GEOMETRY_CYLINDER;
+	case MESH_SPHERE:
+		return SceneGeometry::GEOMETRY_SPHERE;
+	default:
+		return SceneGeometry::GEOMETRY_PLANE;
+	}
+}
+
+/***********************************************************
+ *  GetBatchDraw()
+ *
+ *  This method is used to tell the frame passes how a draw
+ *  goes into a multi-draw. Draws with the same program and
+ *  texture share a call, and draws without a per-draw data
+ *  slot are drawn the regular way.
+ ***********************************************************/
+bool SceneManager::GetBatchDraw(int draw, FramePasses::BATCH_DRAW& batchDraw)
+{
+	const DRAW_COMMAND& command = m_drawCommands[draw];
+	if (command.drawDataIndex < 0)
+		return(false);
+
+	batchDraw.permutationKey = GetPermutationKey(command);
+	batchDraw.textureUnit = (command.bUseTexture == true) ? GetTextureUnit(command) : -1;
+	batchDraw.mesh = GetGeometryMesh(command);
+	batchDraw.drawDataIndex = command.drawDataIndex;
+	return(true);
+}
+
+/***********************************************************
+ *  GetFrustumPlanes()
+ ***********************************************************/
+void SceneManager::GetFrustumPlanes(const CameraBuffer::CAMERA_VIEW& view, glm::vec4 planes[6]) const
+{
+	// frustum planes from the rows of the view projection
+	glm::mat4 viewProjection = view.projection * view.view;
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++)
+	{
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i],
+			viewProjection[2][i], viewProjection[3][i]);
+	}
+	planes[0] = rows[3] + rows[0];
+	planes[1] = rows[3] - rows[0];
+	planes[2] = rows[3] + rows[1];
+	planes[3] = rows[3] - rows[1];
+	planes[4] = rows[3] + rows[2];
+	planes[5] = rows[3] - rows[2];
+}
+
+/***********************************************************
+ *  UpdateSceneBVH()
+ *
+ *  This method is used to gather each object's bounds from
+ *  its recorded draws. The hierarchy is rebuilt only when
+ *  the number of objects changes; moved objects otherwise
+ *  refit the boxes above them, or the whole tree when many
+ *  of them moved at once.
+ ***********************************************************/
+void SceneManager::UpdateSceneBVH()
+{
+	m_objectBounds.resize(m_objectCount);
+	for (SceneBVH::BOUNDS& bounds : m_objectBounds)
+	{
+		bounds.min = glm::vec3(FLT_MAX);
+		bounds.max = glm::vec3(-FLT_MAX);
+	}
+	for (const DRAW_COMMAND& command : m_drawCommands)
+	{
+		if (command.objectID < 0)
+			continue;
+		SceneBVH::BOUNDS& bounds = m_objectBounds[command.objectID];
+		bounds.min = glm::min(bounds.min, command.boundsMin);
+		bounds.max = glm::max(bounds.max, command.boundsMax);
+	}
+
+	if (m_pSceneBVH->GetObjectCount() != m_objectCount)
+	{
+		m_pSceneBVH->Build(m_objectBounds.data(), m_objectCount);
+		return;
+	}
+
+	int movedCount = 0;
+	for (int i = 0; i < m_objectCount; i++)
+	{
+		const SceneBVH::BOUNDS& previous = m_pSceneBVH->GetBounds(i);
+		if ((previous.min != m_objectBounds[i].min) || (previous.max != m_objectBounds[i].max))
+			movedCount++;
+	}
+	if (movedCount > m_objectCount * g_FullRefitShare)
+	{
+		m_pSceneBVH->Refit(m_objectBounds.data());
+		return;
+	}
+	for (int i = 0; (i < m_objectCount) && (movedCount > 0); i++)
+	{
+		const SceneBVH::BOUNDS& previous = m_pSceneBVH->GetBounds(i);
+		if ((previous.min != m_objectBounds[i].min) || (previous.max != m_objectBounds[i].max))
+		{
+			m_pSceneBVH->UpdateBounds(i, m_objectBounds[i]);
+			movedCount--;
+		}
+	}
+}
+
+/***********************************************************
+ *  PickObject()
+ ***********************************************************/
+int SceneManager::PickObject(const glm::vec3& origin, const glm::vec3& direction,
+	float maxDistance, float& hitDistance) const
+{
+	return(m_pSceneBVH->Raycast(origin, direction, maxDistance, hitDistance));
+}
+
+/***********************************************************
+ *  BindPermutation()
+ *
+ *  This method is used to switch to the program for a
+ *  permutation. Uniforms belong to each program, so the
+ *  lights are sent to a permutation the first time it is
+ *  bound in a frame, and the per-draw state is sent again
+ *  in full.
+ ***********************************************************/
+void SceneManager::BindPermutation(int key)
+{
+	if (key == m_activePermutation)
+		return;
+
+	// fall back to the uber shader if the build failed
+	GLuint programID = m_pPermutations->GetProgram(key);
+	if (programID == 0)
+		programID = m_uberProgramID;
+
+	m_pShaderManager->m_programID = programID;
+	m_pShaderManager->use();
+	m_activePermutation = key;
+	m_bSubmittedStateValid = false;
+	m_bActiveUsesDrawData = (programID != m_uberProgramID) &&
+		(ShaderPermutations::UsesDrawData(key) == true);
+
+	SCENE_UNIFORMS& uniforms = (programID == m_uberProgramID) ?
+		m_uberUniforms : m_permutationUniforms[key];
+	if (uniforms.programID != programID)
+	{
+		ResolveSceneUniforms(programID, uniforms);
+	}
+	m_pActiveUniforms = &uniforms;
+
+	// the cameras come from the camera buffer, so only the
+	// view they start at is per program
+	ShaderUniforms::Set(uniforms.viewOffset, m_submitView);
+	if ((programID != m_uberProgramID) && (m_permutationFrame[key] != m_frameNumber))
+	{
+		SetupSceneLights();
+		m_permutationFrame[key] = m_frameNumber;
+	}
+}
+
+/***********************************************************
+ *  RestoreSceneProgram()
+ ***********************************************************/
+void SceneManager::RestoreSceneProgram()
+{
+	m_pShaderManager->m_programID = m_uberProgramID;
+	m_pShaderManager->use();
+	m_activePermutation = -1;
+	m_bSubmittedStateValid = false;
+	m_bActiveUsesDrawData = false;
+	m_pActiveUniforms = &m_uberUniforms;
+}
+
+/***********************************************************
+ *  ResolveSceneUniforms()
+ *
+ *  This method is used to reflect a scene program and keep
+ *  a handle for every uniform the scene sets. Uniforms a
+ *  permutation compiled out get invalid handles, and values
+ *  set through them are ignored.
+ ***********************************************************/
+void SceneManager::ResolveSceneUniforms(GLuint programID, SCENE_UNIFORMS& uniforms)
+{
+	ShaderUniforms table(programID);
+	CameraBuffer::BindProgram(programID);
+
+	uniforms.programID = programID;
+	uniforms.model = table.GetHandle<glm::mat4>(g_ModelName);
+	uniforms.view = table.GetHandle<glm::mat4>(g_ViewName);
+	uniforms.projection = table.GetHandle<glm::mat4>(g_ProjectionName);
+	uniforms.viewPosition = table.GetHandle<glm::vec3>(g_ViewPositionName);
+	uniforms.viewOffset = table.GetHandle<int>(g_ViewOffsetName);
+	uniforms.objectColor = table.GetHandle<glm::vec4>(g_ColorValueName);
+	uniforms.objectTexture = table.GetHandle<int>(g_TextureValueName);
+	uniforms.bUseTexture = table.GetHandle<bool>(g_UseTextureName);
+	uniforms.bUseLighting = table.GetHandle<bool>(g_UseLightingName);
+	uniforms.uvScale = table.GetHandle<glm::vec2>(g_UVScaleName);
+	uniforms.atlasRect = table.GetHandle<glm::vec4>(g_AtlasRectName);
+	uniforms.bAtlasRepeat = table.GetHandle<bool>(g_AtlasRepeatName);
+	uniforms.lightmapTexture = table.GetHandle<int>(g_LightmapTextureName);
+	uniforms.lightmapRect = table.GetHandle<glm::vec4>(g_LightmapRectName);
+	uniforms.materialDiffuse = table.GetHandle<glm::vec3>(g_MaterialDiffuseName);
+	uniforms.materialSpecular = table.GetHandle<glm::vec3>(g_MaterialSpecularName);
+	uniforms.materialShininess = table.GetHandle<float>(g_MaterialShininessName);
+	uniforms.spotLightActive = table.GetHandle<bool>(g_SpotLightActiveName);
+
+	for (int i = 0; i <= g_PointLightCount; i++)
+	{
+		const LIGHT_UNIFORM_NAMES& names = (i == g_PointLightCount) ?
+			g_DirectionalLightNames : g_PointLightNames[i];
+		LIGHT_UNIFORMS& light = (i == g_PointLightCount) ?
+			uniforms.directionalLight : uniforms.pointLights[i];
+		light.vector = table.GetHandle<glm::vec3>(names.vector);
+		light.ambient = table.GetHandle<glm::vec3>(names.ambient);
+		light.diffuse = table.GetHandle<glm::vec3>(names.diffuse);
+		light.specular = table.GetHandle<glm::vec3>(names.specular);
+		light.bActive = table.GetHandle<bool>(names.bActive);
+	}
+}
+
+/***********************************************************
+ *  SetOcclusionCulling()
+ ***********************************************************/
+void SceneManager::SetOcclusionCulling(bool bEnabled)
+{
+	m_bOcclusionCulling = bEnabled;
+	m_bSceneDirty = true;
+	std::cout << "INFO: Occlusion culling " << (bEnabled ? "enabled" : "disabled") << std::endl;
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used to record a draw of the given mesh
+ *  with the current transform, color, texture and material.
+ ***********************************************************/
+void SceneManager::DrawMesh(DRAW_MESH mesh)
+{
+	DRAW_COMMAND command = m_drawState;
+	command.mesh = mesh;
+
+	// distance along the view direction, for front to back sorting
+	glm::vec4 viewPosition = m_viewMatrix * command.model[3];
+	command.viewDepth = -viewPosition.z;
+
+	// conservative object space bounds of each basic mesh
+	StaticScene::SHAPE shape = StaticScene::SHAPE_UNIT;
+	if (mesh == MESH_PLANE)
+		shape = StaticScene::SHAPE_PLANE;
+	else if (mesh == MESH_BOX_SIDE)
+		shape = StaticScene::SHAPE_BOX;
+
+	// built-in scene nodes that have not moved use the world
+	// bounds computed when compiling
+	if ((m_transformNode >= 0) && (m_pTransformHierarchy->IsBaked(m_transformNode) == true))
+	{
+		StaticScene::GetWorldBounds(m_transformNode, shape, command.boundsMin, command.boundsMax);
+		m_drawCommands.push_back(command);
+		return;
+	}
+
+	glm::vec3 localMin;
+	glm::vec3 localMax;
+	StaticScene::GetLocalBounds(shape, localMin, localMax);
+
+	// world space bounds enclosing the eight transformed corners
+	for (int corner = 0; corner < 8; corner++)
+	{
+		glm::vec4 localCorner(
+			(corner & 1) ? localMax.x : localMin.x,
+			(corner & 2) ? localMax.y : localMin.y,
+			(corner & 4) ? localMax.z : localMin.z,
+			1.0f);
+		glm::vec3 worldCorner = glm::vec3(command.model * localCorner);
+		if (corner == 0)
+		{
+			command.boundsMin = worldCorner;
+			command.boundsMax = worldCorner;
+		}
+		else
+		{
+			command.boundsMin = glm::min(command.boundsMin, worldCorner);
+			command.boundsMax = glm::max(command.boundsMax, worldCorner);
+		}
+	}
+
+	m_drawCommands.push_back(command);
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used to record a draw of one side of the
+ *  box mesh.
+ ***********************************************************/
+void SceneManager::DrawMesh(ShapeMeshes::BoxSide boxSide)
+{
+	m_drawState.boxSide = boxSide;
+	DrawMesh(MESH_BOX_SIDE);
+}
+
+/***********************************************************
+ *  ApplyDrawState()
+ *
+ *  This method is used to send the state of a recorded draw
+ *  to the shader, skipping values that are already set.
+ ***********************************************************/
+void SceneManager::ApplyDrawState(int draw)
+{
+	if (NULL == m_pShaderManager)
+		return;
+
+	const DRAW_COMMAND& command = m_drawCommands[draw];
+
+	if (m_bPermutations == true)
+	{
+		BindPermutation(GetPermutationKey(command));
+	}
+
+	bool bForce = !m_bSubmittedStateValid;
+	const DRAW_COMMAND& last = m_submittedState;
+
+	const SCENE_UNIFORMS& uniforms = *m_pActiveUniforms;
+
+	// the rest of the per-draw values are already in the
+	// storage buffer, so only its index is sent
+	if (m_bActiveUsesDrawData == true)
+	{
+		glVertexAttribI1i(SceneGeometry::DRAW_INDEX_ATTRIBUTE, command.drawDataIndex);
+		int textureUnit = GetTextureUnit(command);
+		if (bForce || (textureUnit != GetTextureUnit(last)))
+		{
+			ShaderUniforms::Set(uniforms.objectTexture, textureUnit);
+		}
+
+		m_submittedState = command;
+		m_bSubmittedStateValid = true;
+		return;
+	}
+
+	ShaderUniforms::Set(uniforms.model, command.model);
+
+	if (bForce || (command.bUseTexture != last.bUseTexture))
+	{
+		ShaderUniforms::Set(uniforms.bUseTexture, command.bUseTexture);
+	}
+	if (bForce || (command.color != last.color))
+	{
+		ShaderUniforms::Set(uniforms.objectColor, command.color);
+	}
+	if (bForce || (command.textureSlot != last.textureSlot) ||
+		(command.bUseTexture != last.bUseTexture))
+	{
+		// a zero sized tile tells the shader to sample the
+		// whole texture
+		glm::vec4 atlasRect(0.0f);
+		bool bAtlasRepeat = false;
+		if (UsesTextureAtlas(command) == true)
+		{
+			atlasRect = m_textureIDs[command.textureSlot].atlasRect;
+			bAtlasRepeat = m_textureIDs[command.textureSlot].bAtlasRepeat;
+		}
+		ShaderUniforms::Set(uniforms.objectTexture, GetTextureUnit(command));
+		ShaderUniforms::Set(uniforms.atlasRect, atlasRect);
+		ShaderUniforms::Set(uniforms.bAtlasRepeat, bAtlasRepeat);
+	}
+	if (bForce || (command.lightmapTile != last.lightmapTile))
+	{
+		ShaderUniforms::Set(uniforms.lightmapRect, (command.lightmapTile >= 0) ?
+			m_pLightBaker->GetTileRect(command.lightmapTile) : glm::vec4(0.0f));
+	}
+	if (bForce || (command.uvScale != last.uvScale))
+	{
+		ShaderUniforms::Set(uniforms.uvScale, command.uvScale);
+	}
+	if ((command.materialIndex >= 0) &&
+		(command.materialIndex < (int)m_objectMaterials.size()) &&
+		(bForce || (command.materialIndex != last.materialIndex)))
+	{
+		const OBJECT_MATERIAL& material = m_objectMaterials[command.materialIndex];
+		ShaderUniforms::Set(uniforms.materialDiffuse, material.diffuseColor);
+		ShaderUniforms::Set(uniforms.materialSpecular, material.specularColor);
+		ShaderUniforms::Set(uniforms.materialShininess, material.shininess);
+	}
+	if (bForce || (command.bUseLighting != last.bUseLighting))
+	{
+		ShaderUniforms::Set(uniforms.bUseLighting, command.bUseLighting);
+	}
+
+	m_submittedState = command;
+	m_bSubmittedStateValid = true;
+}
+
+/***********************************************************
+ *  DrawRecordedMesh()
+ *
+ *  This method is used to issue the mesh draw call for a
+ *  recorded draw command.
+ ***********************************************************/
+void SceneManager::DrawRecordedMesh(int draw)
+{
+	const DRAW_COMMAND& command = m_drawCommands[draw];
+	switch (command.mesh)
+	{
+	case MESH_PLANE:
+		m_basicMeshes->DrawPlaneMesh();
+		break;
+	case MESH_BOX_SIDE:
+		m_basicMeshes->DrawBoxMeshSide(command.boxSide);
+		break;
+	case MESH_CYLINDER:
+		m_basicMeshes->DrawCylinderMesh();
+		break;
+	case MESH_SPHERE:
+		m_basicMeshes->DrawSphereMesh();
+		break;
+	}
 }
 
 /***********************************************************
- *  DestroyGLTextures()
+ *  BeginObjectDraw()
+ *
+ *  This method is used to draw the following commands only
+ *  if their object was visible in the previous frame's
+ *  occlusion query. Consecutive draws of the same object
+ *  share one conditional render.
  ***********************************************************/
-void SceneManager::DestroyGLTextures()
+void SceneManager::BeginObjectDraw(int draw)
 {
-	for (int i = 0; i < m_loadedTextures; i++)
+	const DRAW_COMMAND& command = m_drawCommands[draw];
+	if ((m_bOcclusionCulling == false) || (m_viewCount > 1) ||
+		(command.objectID == m_conditionalObject))
+		return;
+
+	EndObjectDraw();
+	if (m_pOcclusionCuller->BeginConditionalDraw(command.objectID, m_cameraPosition) == true)
 	{
-		glDeleteTextures(1, &m_textureIDs[i].ID);
+		m_conditionalObject = command.objectID;
 	}
 }
 
 /***********************************************************
- *  FindTextureID()
+ *  EndObjectDraw()
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+void SceneManager::EndObjectDraw()
 {
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
+	if (m_conditionalObject >= 0)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
+		m_pOcclusionCuller->EndConditionalDraw();
+		m_conditionalObject = -1;
 	}
-
-	return(textureID);
 }
 
 /***********************************************************
- *  FindTextureSlot()
+ *  IssueOcclusionQueries()
+ *
+ *  This method is used to test every object's bounding box
+ *  against the finished depth buffer. The results decide
+ *  what the next frame draws, which hides the query latency.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+void SceneManager::IssueOcclusionQueries()
 {
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
+	m_pDepthPrePass->BeginBoundsPass(m_viewMatrix, m_projectionMatrix);
+	for (int objectID = 0; objectID < m_objectCount; objectID++)
 	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
+		if (m_pOcclusionCuller->BeginBoundsQuery(objectID) == true)
 		{
-			textureSlot = index;
-			bFound = true;
+			m_pDepthPrePass->SetModel(m_pOcclusionCuller->GetBoundsTransform(objectID));
+			m_basicMeshes->DrawBoxMesh();
+			m_pOcclusionCuller->EndBoundsQuery();
 		}
-		else
-			index++;
 	}
-
-	return(textureSlot);
+	m_pDepthPrePass->EndBoundsPass();
+	m_pShaderManager->use();
 }
 
 /***********************************************************
- *  FindMaterial()
+ *  GetSortValue()
+ *
+ *  This method is used to pack the fields an order compares
+ *  into one integer, most significant field first. The
+ *  value has to fit above the position bits of the key.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+unsigned long long SceneManager::GetSortValue(const DRAW_COMMAND& command, FramePasses::DRAW_SORT sort)
 {
-	if (m_objectMaterials.size() == 0)
-		return false;
+	unsigned long long value = 0;
+	unsigned long long texture = (unsigned long long)(GetTextureUnit(command) + 1) & 0xFFF;
+	unsigned long long material = (unsigned long long)(command.materialIndex + 1) & 0xFFF;
 
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < (int)m_objectMaterials.size()) && (bFound == false))
+	switch (sort)
 	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
+	case FramePasses::SORT_TRANSLUCENT_LAST:
+		// farthest first, so the inverted depth order
+		if (command.color.a < 1.0f)
+			value = (2ull << 32) | (~GetDepthSortValue(command.viewDepth) & 0xFFFFFFFFull);
+		else if (command.bUseLighting == false)
+			value = (1ull << 32);
+		break;
+	case FramePasses::SORT_FRONT_TO_BACK:
+		value = GetDepthSortValue(command.viewDepth);
+		break;
+	case FramePasses::SORT_SHADER_STATE:
+		if (m_bPermutations == true)
+			value = (unsigned long long)GetPermutationKey(command) << 24;
+		value |= (texture << 12) | material;
+		break;
+	case FramePasses::SORT_PERMUTATION:
+		value = (unsigned long long)GetPermutationKey(command);
+		break;
+	case FramePasses::SORT_PERMUTATION_TEXTURE:
+		value = ((unsigned long long)GetPermutationKey(command) << 12) | texture;
+		break;
 	}
 
-	return bFound;
+	return(value);
 }
 
 /***********************************************************
- *  SetTransformations()
+ *  SortDrawOrder()
+ *
+ *  This method is used to sort a range of the draw order
+ *  by 64-bit keys held in the frame arena. Each key is the
+ *  sort value above the draw's position in the range, so
+ *  every key is unique, equal values keep their order, and
+ *  the plain std::sort needs no buffer the way
+ *  std::stable_sort does.
  ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
+void SceneManager::SortDrawOrder(int begin, int end, FramePasses::DRAW_SORT sort)
 {
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
+	int count = end - begin;
+	if (count < 2)
+		return;
 
-	scale = glm::scale(scaleXYZ);
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	translation = glm::translate(positionXYZ);
+	unsigned long long* keys = m_pFrameArena->Allocate<unsigned long long>(count);
+	int* order = m_pFrameArena->Allocate<int>(count);
+	for (int i = 0; i < count; i++)
+	{
+		keys[i] = (GetSortValue(m_drawCommands[m_drawOrder[begin + i]], sort) << g_SortPositionBits) |
+			(unsigned long long)i;
+	}
 
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
+	std::sort(keys, keys + count);
 
-	if (NULL != m_pShaderManager)
+	for (int i = 0; i < count; i++)
+	{
+		order[i] = m_drawOrder[begin + (int)(keys[i] & g_SortPositionMask)];
+	}
+	for (int i = 0; i < count; i++)
 	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		m_drawOrder[begin + i] = order[i];
 	}
 }
 
 /***********************************************************
- *  SetShaderColor()
+ *  SubmitDrawCommands()
+ *
+ *  This method is used to submit the recorded draws. The
+ *  visible draws are split into the ranges of the opaque,
+ *  unlit and blended passes, and the frame graph picks the
+ *  passes to run and their order. With the depth pre-pass
+ *  enabled, opaque draws are first rendered front to back
+ *  into the depth buffer only, and the lighting passes then
+ *  shade just the visible surface of each pixel using
+ *  GL_EQUAL.
  ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
+void SceneManager::SubmitDrawCommands()
 {
-	glm::vec4 currentColor;
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
+	// viewport size, for turning shaded samples into overdraw
+	// and placing the views
+	GLint* viewport = m_targetViewport;
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	// the lighting program has to be re-sent everything
+	// after another program has been bound
+	m_bSubmittedStateValid = false;
+
+	// the depth pre-pass, overdraw view and occlusion culling
+	// work from the first view's depth, so they are left out
+	// while several views share the frame
+	bool bSingleView = (m_viewCount == 1);
+	bool bDepthPrePass = (m_bDepthPrePass == true) && (bSingleView == true);
+	bool bOcclusionCulling = (m_bOcclusionCulling == true) && (bSingleView == true);
+
+	// only draws of objects the hierarchy finds inside the
+	// frustum of any view are submitted, so the views share one
+	// culled and sorted draw list; draws recorded before the
+	// first transform belong to no object and are always kept
+	UpdateSceneBVH();
+	glm::vec4 planes[6];
+	m_visibleObjects.clear();
+	for (int view = 0; view < m_viewCount; view++)
+	{
+		GetFrustumPlanes(m_views[view], planes);
+		m_pSceneBVH->QueryFrustum(planes, m_visibleObjects);
+	}
+	m_objectVisible.assign(m_objectCount, false);
+	for (int objectID : m_visibleObjects)
+	{
+		m_objectVisible[objectID] = true;
+	}
 
-	if (NULL != m_pShaderManager)
+	m_drawOrder.clear();
+	for (int i = 0; i < (int)m_drawCommands.size(); i++)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+		const DRAW_COMMAND& command = m_drawCommands[i];
+		if ((command.objectID >= 0) && (m_objectVisible[command.objectID] == false))
+			continue;
+
+		// a visible prop shows its impostor, and once that has
+		// faded in fully its own draws are left out
+		if (command.propID >= 0)
+		{
+			m_pImpostorCache->SetVisible(command.propID);
+			if (m_pImpostorCache->GetFade(command.propID) >= 1.0f)
+				continue;
+		}
+		m_drawOrder.push_back(i);
 	}
-}
 
-/***********************************************************
- *  SetShaderTexture()
- ***********************************************************/
-void SceneManager::SetShaderTexture(std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
+	if (bOcclusionCulling == true)
+	{
+		m_pOcclusionCuller->BeginFrame(m_objectCount);
+		for (int i = 0; i < (int)m_drawCommands.size(); i++)
+		{
+			m_pOcclusionCuller->AddBounds(m_drawCommands[i].objectID,
+				m_drawCommands[i].boundsMin, m_drawCommands[i].boundsMax);
+		}
+	}
+
+	// opaque lit draws first, then the opaque unlit ones such
+	// as the monitor screen, then the translucent draws
+	int opaqueCount = 0;
+	int litCount = 0;
+	for (int index : m_drawOrder)
+	{
+		if (m_drawCommands[index].color.a >= 1.0f)
+		{
+			opaqueCount++;
+			if (m_drawCommands[index].bUseLighting == true)
+				litCount++;
+		}
+	}
+	SortDrawOrder(0, (int)m_drawOrder.size(), FramePasses::SORT_TRANSLUCENT_LAST);
+
+	// the overdraw view replaces the lit passes, and the
+	// occlusion queries only run while their results are used
+	bool bOverdrawView = (m_bOverdrawView == true) && (bSingleView == true);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_OVERDRAW, bOverdrawView);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_DEPTH_PREPASS, (bDepthPrePass == true) && (bOverdrawView == false));
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_OPAQUE, bOverdrawView == false);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_UNLIT, bOverdrawView == false);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_IMPOSTORS, bOverdrawView == false);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_BLENDED, bOverdrawView == false);
+	m_pFramePasses->SetPassEnabled(FramePasses::PASS_OCCLUSION, bOverdrawView == false);
+	m_pFramePasses->SetOutput(FramePasses::TARGET_OCCLUSION, bOcclusionCulling);
+
+	if ((bSingleView == false) && (IsSinglePassViewsAvailable() == true))
+	{
+		// every draw is instanced once per view, and the vertex
+		// shader sends each instance to its view's viewport
+		m_bSinglePassViews = true;
+		for (int view = 0; view < m_viewCount; view++)
+		{
+			const glm::vec4& area = m_views[view].viewport;
+			glViewportIndexedf(view,
+				viewport[0] + area.x * viewport[2], viewport[1] + area.y * viewport[3],
+				area.z * viewport[2], area.w * viewport[3]);
+		}
+		m_pSceneGeometry->SetInstancesPerDraw(m_viewCount);
+	}
+
+	m_pFramePasses->Execute(litCount, opaqueCount, viewport[2], viewport[3]);
+
+	if (m_bSinglePassViews == true)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+		m_pSceneGeometry->SetInstancesPerDraw(1);
+		m_bSinglePassViews = false;
+	}
+	if (bSingleView == false)
+	{
+		glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	}
 
-		int textureSlot = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureSlot);
+	// the view manager sets next frame's camera on the uber shader
+	if (m_activePermutation >= 0)
+	{
+		RestoreSceneProgram();
 	}
 }
 
 /***********************************************************
- *  SetTextureUVScale()
+ *  IsSinglePassViewsAvailable()
+ *
+ *  This method is used to check whether all views can be
+ *  drawn in one pass. Every lit draw has to go through the
+ *  permutation multi-draw, which can instance it per view,
+ *  and the vertex shader has to be able to pick a viewport.
  ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
+bool SceneManager::IsSinglePassViewsAvailable() const
 {
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
+	return (IsMultiDrawActive() == true) &&
+		(m_pPermutations != NULL) &&
+		(m_pPermutations->CanSelectViewport() == true) &&
+		(m_pCameraBuffer->IsAvailable() == true);
 }
 
 /***********************************************************
- *  SetShaderMaterial()
+ *  SelectView()
+ *
+ *  This method is used to send the following draws to one
+ *  view. The permutations read their camera from the camera
+ *  buffer at the view offset, while the uber shader is
+ *  given the view's camera directly.
  ***********************************************************/
-void SceneManager::SetShaderMaterial(std::string materialTag)
+void SceneManager::SelectView(int view)
 {
-	if (m_objectMaterials.size() > 0 && NULL != m_pShaderManager)
+	const CameraBuffer::CAMERA_VIEW& camera = m_views[view];
+	m_submitView = view;
+
+	float x = m_targetViewport[0] + camera.viewport.x * m_targetViewport[2];
+	float y = m_targetViewport[1] + camera.viewport.y * m_targetViewport[3];
+	float width = camera.viewport.z * m_targetViewport[2];
+	float height = camera.viewport.w * m_targetViewport[3];
+	if (m_bSinglePassViews == true)
 	{
-		OBJECT_MATERIAL material;
-		bool bFound = FindMaterial(materialTag, material);
-
-		if (bFound == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
+		// the uber shader always draws to the first viewport
+		glViewportIndexedf(0, x, y, width, height);
+	}
+	else
+	{
+		glViewport((GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height);
 	}
+
+	ShaderUniforms::Set(m_pActiveUniforms->viewOffset, view);
+	ShaderUniforms::Set(m_uberUniforms.view, camera.view);
+	ShaderUniforms::Set(m_uberUniforms.projection, camera.projection);
+	ShaderUniforms::Set(m_uberUniforms.viewPosition, camera.position);
 }
 
 /**************************************************************/
@@ -323,11 +2231,8 @@ void SceneManager::SetShaderMaterial(std::string materialTag)
  ***********************************************************/
 void SceneManager::PrepareScene()
 {
-	// load meshes once
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadBoxMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadSphereMesh();
+	// load meshes once, or share those of another scene
+	m_basicMeshes = ResourceCache::AcquireShapeMeshes();
 
 	// load textures once
 	CreateGLTexture("textures/Wood.jpg", "wood");
@@ -343,6 +2248,39 @@ void SceneManager::PrepareScene()
 	// bind texture IDs to texture slots
 	BindGLTextures();
 
+	// compile the depth-only program for the pre-pass
+	if (m_pDepthPrePass->Initialize(m_pProgramCache) == false)
+	{
+		std::cout << "Depth pre-pass unavailable" << std::endl;
+	}
+	if (m_pImpostorCache->Initialize(m_pProgramCache) == false)
+	{
+		std::cout << "Prop impostors unavailable" << std::endl;
+	}
+	m_plantProp = m_pImpostorCache->AddProp("plant");
+	m_pFramePasses->Initialize();
+	m_pOcclusionCuller->Initialize();
+	m_pCameraBuffer->Initialize();
+
+	m_pDrawDataRing->Initialize(g_MaxDrawsPerFrame);
+	if (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect)
+	{
+		m_pSceneGeometry->Initialize(g_MaxDrawsPerFrame);
+	}
+
+	// specialized programs are built on first use
+	m_uberProgramID = m_pShaderManager->m_programID;
+	ResourceAccounting::TrackProgram(m_uberProgramID);
+	ResolveSceneUniforms(m_uberProgramID, m_uberUniforms);
+	m_pActiveUniforms = &m_uberUniforms;
+	m_pPermutations = new ShaderPermutations(m_pProgramCache);
+	if (m_pPermutations->Initialize(
+		"shaders/sceneVertexShader.glsl",
+		"shaders/sceneFragmentShader.glsl") == false)
+	{
+		std::cout << "Shader permutations unavailable" << std::endl;
+	}
+
 	// -----------------------------
 	// Materials for lighting
 	// -----------------------------
@@ -368,6 +2306,9 @@ void SceneManager::PrepareScene()
 	keyboardMat.specularColor = glm::vec3(0.50f, 0.50f, 0.50f);
 	keyboardMat.shininess = 48.0f;
 	m_objectMaterials.push_back(keyboardMat);
+
+	// place the objects of the built-in scene
+	BuildSceneHierarchy();
 }
 
 /***********************************************************
@@ -381,51 +2322,89 @@ void SceneManager::SetupSceneLights()
 		return;
 
 	// Turn lighting ON in fragment shader
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	// ---------------------------
-	// Directional Light (main)
-	// ---------------------------
-	m_pShaderManager->setVec3Value("directionalLight.direction", -0.25f, -1.0f, -0.30f);
-	m_pShaderManager->setVec3Value("directionalLight.ambient", 0.35f, 0.35f, 0.35f);
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", 0.70f, 0.70f, 0.70f);
-	m_pShaderManager->setVec3Value("directionalLight.specular", 0.60f, 0.60f, 0.60f);
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
-
-	// ---------------------------
-	// Point Lights (fill lights)
-	// TOTAL_POINT_LIGHTS = 5 in shader
-	// ---------------------------
-	// Light 0: above/right
-	m_pShaderManager->setVec3Value("pointLights[0].position", 3.0f, 3.0f, 2.0f);
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", 0.06f, 0.06f, 0.06f);
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", 0.80f, 0.80f, 0.80f);
-	m_pShaderManager->setVec3Value("pointLights[0].specular", 0.90f, 0.90f, 0.90f);
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-
-	// Light 1: fill from opposite side (prevents full shadow)
-	m_pShaderManager->setVec3Value("pointLights[1].position", -3.0f, 2.5f, -2.0f);
-	m_pShaderManager->setVec3Value("pointLights[1].ambient", 0.05f, 0.05f, 0.05f);
-	m_pShaderManager->setVec3Value("pointLights[1].diffuse", 0.45f, 0.45f, 0.45f);
-	m_pShaderManager->setVec3Value("pointLights[1].specular", 0.50f, 0.50f, 0.50f);
-	m_pShaderManager->setBoolValue("pointLights[1].bActive", true);
-
-	// Light 2: soft overhead fill (makes the scene look more real)
-	m_pShaderManager->setVec3Value("pointLights[2].position", 0.0f, 4.0f, 0.0f);
-	m_pShaderManager->setVec3Value("pointLights[2].ambient", 0.03f, 0.03f, 0.03f);
-	m_pShaderManager->setVec3Value("pointLights[2].diffuse", 0.35f, 0.35f, 0.35f);
-	m_pShaderManager->setVec3Value("pointLights[2].specular", 0.20f, 0.20f, 0.20f);
-	m_pShaderManager->setBoolValue("pointLights[2].bActive", true);
+	m_drawState.bUseLighting = true;
+
+	const SCENE_UNIFORMS& uniforms = *m_pActiveUniforms;
+
+	SCENE_LIGHT lights[g_PointLightCount + 1];
+	int lightCount = GetSceneLights(lights);
+	bool bDirectional = false;
+	int pointLights = 0;
+	for (int i = 0; i < lightCount; i++)
+	{
+		const LIGHT_UNIFORMS* pLight = NULL;
+		if (lights[i].type == SCENE_LIGHT_DIRECTIONAL)
+		{
+			pLight = &uniforms.directionalLight;
+			bDirectional = true;
+		}
+		else
+		{
+			pLight = &uniforms.pointLights[pointLights];
+			pointLights++;
+		}
+		ShaderUniforms::Set(pLight->vector, lights[i].vector);
+		ShaderUniforms::Set(pLight->ambient, lights[i].ambient);
+		ShaderUniforms::Set(pLight->diffuse, lights[i].diffuse);
+		ShaderUniforms::Set(pLight->specular, lights[i].specular);
+		ShaderUniforms::Set(pLight->bActive, true);
+	}
+
+	ShaderUniforms::Set(uniforms.directionalLight.bActive, bDirectional);
+	m_bDirectionalLightActive = bDirectional;
+	m_activePointLights = pointLights;
 
 	// Disable unused point lights
-	for (int i = 3; i < 5; i++)
+	for (int i = pointLights; i < g_PointLightCount; i++)
+	{
+		ShaderUniforms::Set(uniforms.pointLights[i].bActive, false);
+	}
+
+	if (m_lightmapUnit >= 0)
 	{
-		std::string base = "pointLights[" + std::to_string(i) + "].bActive";
-		m_pShaderManager->setBoolValue(base, false);
+		ShaderUniforms::Set(uniforms.lightmapTexture, m_lightmapUnit);
 	}
 
 	// Spotlight off for this scene
-	m_pShaderManager->setBoolValue("spotLight.bActive", false);
+	ShaderUniforms::Set(uniforms.spotLightActive, false);
+}
+
+/***********************************************************
+ *  GetSceneLights()
+ *
+ *  Lights from the scene file replace the built-in lights.
+ *  Only the first directional light and as many point
+ *  lights as the shader has are used.
+ ***********************************************************/
+int SceneManager::GetSceneLights(SCENE_LIGHT lights[]) const
+{
+	const SCENE_LIGHT* pSource = g_BuiltInLights;
+	int sourceCount = g_BuiltInLightCount;
+	if (m_bSceneFileLoaded == true)
+	{
+		pSource = m_scene.lights.data();
+		sourceCount = (int)m_scene.lights.size();
+	}
+
+	int lightCount = 0;
+	for (int i = 0; i < sourceCount; i++)
+	{
+		if (pSource[i].type == SCENE_LIGHT_DIRECTIONAL)
+		{
+			lights[lightCount++] = pSource[i];
+			break;
+		}
+	}
+	int pointLights = 0;
+	for (int i = 0; (i < sourceCount) && (pointLights < g_PointLightCount); i++)
+	{
+		if (pSource[i].type == SCENE_LIGHT_POINT)
+		{
+			lights[lightCount++] = pSource[i];
+			pointLights++;
+		}
+	}
+	return(lightCount);
 }
 
 /***********************************************************
@@ -433,47 +2412,199 @@ void SceneManager::SetupSceneLights()
  ***********************************************************/
 void SceneManager::RenderScene()
 {
+	// scratch memory from the last frame is no longer in use
+	m_pFrameArena->Reset();
+
 	// set lights once per frame
+	m_frameNumber++;
 	SetupSceneLights();
 
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
+	// world matrices change only below nodes that moved
+	m_pTransformHierarchy->Update();
+
+	// record the scene, then submit it in one go
+	m_drawCommands.clear();
+	m_objectCount = 0;
+	m_transformNode = -1;
+	if (m_bSceneFileLoaded == true)
+		RecordSceneFile();
+	else
+		RecordScene();
+
+	// static surfaces take their ambient and diffuse light
+	// from the lightmap, baked once the scene is recorded
+	if ((m_bPermutations == true) && (m_bBakedLighting == true) && (m_bLightmapDirty == true))
+	{
+		BakeLighting();
+	}
+	AssignLightmapTiles();
+
+	bool bDrawData = IsDrawDataActive();
+	if (bDrawData == true)
+	{
+		WriteDrawData();
+	}
+
+	// distant props switch to their impostors, which are
+	// captured with the draws just recorded
+	UpdateImpostors();
+
+	// the camera is latched as late as possible, after the
+	// frame is recorded, so mouse look that arrived while
+	// recording is still shown by this frame; the uber shader
+	// is given the latched view too, so the lit draws, the
+	// depth pre-pass, the impostors and culling share a camera
+	if ((m_pViewLatch != NULL) && (m_pViewLatch->LatchCamera(m_views[0]) == true))
+	{
+		m_viewMatrix = m_views[0].view;
+		ShaderUniforms::Set(m_uberUniforms.view, m_viewMatrix);
+	}
+
+	// cameras of every view, read by the permutations
+	m_pCameraBuffer->Update(m_views, m_viewCount);
+	m_pCameraBuffer->Bind();
+
+	SubmitDrawCommands();
+	if (bDrawData == true)
+	{
+		m_pDrawDataRing->EndFrame();
+	}
+}
+
+/***********************************************************
+ *  RecordSceneFile()
+ *
+ *  This method is used to record the objects of the loaded
+ *  scene file, the same way RecordScene() records the
+ *  built-in scene. Each object is placed by its transform
+ *  node, so recording does not compute any matrices.
+ ***********************************************************/
+void SceneManager::RecordSceneFile()
+{
+	// box sides in the order of the SCENE_BOX_SIDE flags
+	const ShapeMeshes::BoxSide boxSides[6] = {
+		ShapeMeshes::box_front, ShapeMeshes::box_back,
+		ShapeMeshes::box_left, ShapeMeshes::box_right,
+		ShapeMeshes::box_top, ShapeMeshes::box_bottom };
+
+	for (size_t index = 0; index < m_scene.objects.size(); index++)
+	{
+		const SCENE_OBJECT& object = m_scene.objects[index];
+		BeginProp(m_sceneObjectProps[index]);
+		SetTransformNode(m_sceneObjectNodes[index]);
+		if (!object.material.empty())
+			SetShaderMaterial(object.material.c_str());
+		SetShaderColor(object.color.r, object.color.g, object.color.b, object.color.a);
+		if (!object.texture.empty())
+			SetShaderTexture(object.texture.c_str());
+		SetTextureUVScale(object.uvScale.x, object.uvScale.y);
+		m_drawState.bUseLighting = object.bUseLighting;
+
+		switch (object.mesh)
+		{
+		case SCENE_MESH_PLANE:
+			DrawMesh(MESH_PLANE);
+			break;
+		case SCENE_MESH_CYLINDER:
+			DrawMesh(MESH_CYLINDER);
+			break;
+		case SCENE_MESH_SPHERE:
+			DrawMesh(MESH_SPHERE);
+			break;
+		case SCENE_MESH_BOX:
+			for (int side = 0; side < 6; side++)
+			{
+				if (object.boxSides & (1 << side))
+					DrawMesh(boxSides[side]);
+			}
+			break;
+		}
+	}
+
+	EndProp();
+	m_drawState.bUseLighting = true;
+}
+
+/***********************************************************
+ *  BuildSceneHierarchy()
+ *
+ *  This method is used to place the objects of the 3D scene
+ *  as transform nodes. Parts that belong together hang off
+ *  an unscaled group node, so moving the group carries them
+ *  along and only their world matrices are recomputed.
+ ***********************************************************/
+void SceneManager::BuildSceneHierarchy()
+{
+	TransformHierarchy& nodes = *m_pTransformHierarchy;
+	SCENE_NODES& scene = m_sceneNodes;
+
+	nodes.Clear();
+	scene.leaves.clear();
+
+	// the matrices were computed when compiling, so adding
+	// the nodes only copies them and the first update skips
+	// them; the hierarchy indices match StaticScene::NODE
+	for (int node = 0; node < StaticScene::NODE_COUNT; node++)
+	{
+		glm::mat4 localMatrix;
+		glm::mat4 worldMatrix;
+		StaticScene::GetLocalMatrix(node, localMatrix);
+		StaticScene::GetWorldMatrix(node, worldMatrix);
+		nodes.AddBakedNode(StaticScene::GetParent(node), localMatrix, worldMatrix);
+	}
+
+	scene.floor = StaticScene::NODE_FLOOR;
+	scene.desk = StaticScene::NODE_DESK;
+	scene.keyboard = StaticScene::NODE_KEYBOARD;
+	scene.keyboardBase = StaticScene::NODE_KEYBOARD_BASE;
+	scene.keyboardPlate = StaticScene::NODE_KEYBOARD_PLATE;
+	scene.monitor = StaticScene::NODE_MONITOR;
+	scene.monitorStand = StaticScene::NODE_MONITOR_STAND;
+	scene.monitorScreen = StaticScene::NODE_MONITOR_SCREEN;
+	scene.mousepad = StaticScene::NODE_MOUSEPAD;
+	scene.mousepadBody = StaticScene::NODE_MOUSEPAD_BODY;
+	scene.mouse = StaticScene::NODE_MOUSE;
+	scene.plant = StaticScene::NODE_PLANT;
+	scene.pot = StaticScene::NODE_POT;
+	scene.stem = StaticScene::NODE_STEM;
+	scene.leafBase = StaticScene::NODE_LEAF_BASE;
+	for (int leaf = 0; leaf < StaticScene::LEAF_COUNT; leaf++)
+	{
+		scene.leaves.push_back(StaticScene::NODE_FIRST_LEAF + leaf);
+	}
+}
 
+/***********************************************************
+ *  RecordScene()
+ *
+ *  The objects are placed by the transform nodes from
+ *  BuildSceneHierarchy(), so recording a frame does not
+ *  compute any matrices.
+ ***********************************************************/
+void SceneManager::RecordScene()
+{
 	/******************************************************************/
 	// Floor plane (wood texture + lit)
 	/******************************************************************/
-	scaleXYZ = glm::vec3(20.0f, 1.0f, 10.0f);
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.floor);
 	SetShaderMaterial("woodMat");
 	SetShaderTexture("wood");
 	SetTextureUVScale(8.0f, 4.0f);
-	m_basicMeshes->DrawPlaneMesh();
+	DrawMesh(MESH_PLANE);
 
 	/******************************************************************/
 	// Desk plane (plastic texture + lit)
 	/******************************************************************/
-	scaleXYZ = glm::vec3(12.0f, 1.0f, 6.0f);
-	positionXYZ = glm::vec3(0.0f, 0.05f, 0.0f);
-
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.desk);
 	SetShaderMaterial("plasticMat");
 	SetShaderTexture("plastic");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawPlaneMesh();
+	DrawMesh(MESH_PLANE);
 
 	/******************************************************************/
 	// Keyboard base (color only + lit)
 	/******************************************************************/
-	scaleXYZ = glm::vec3(6.5f, 0.35f, 2.2f);
-	positionXYZ = glm::vec3(0.0f, 0.20f, -0.40f);
-
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.keyboardBase);
 	SetShaderMaterial("plasticMat");
 	SetShaderTexture("keyboard");
 
@@ -481,122 +2612,92 @@ void SceneManager::RenderScene()
 	SetShaderColor(0.15f, 0.15f, 0.15f, 1.0f);
 
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_front);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_back);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_left);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_right);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_bottom);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
+	DrawMesh(ShapeMeshes::box_front);
+	DrawMesh(ShapeMeshes::box_back);
+	DrawMesh(ShapeMeshes::box_left);
+	DrawMesh(ShapeMeshes::box_right);
+	DrawMesh(ShapeMeshes::box_bottom);
+	DrawMesh(ShapeMeshes::box_top);
 
 	/******************************************************************/
 	// Keyboard top plate
 	/******************************************************************/
-	scaleXYZ = glm::vec3(6.3f, 0.12f, 2.0f);
-	positionXYZ = glm::vec3(0.0f, 0.20f + (0.35f / 2.0f) + (0.12f / 2.0f), -0.40f);
-
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.keyboardPlate);
 
 	// TOP face = keyboard texture
 	SetShaderMaterial("keyboardMat");
 	SetShaderTexture("keyboard");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
+	DrawMesh(ShapeMeshes::box_top);
 
 	// All other faces
 	SetShaderMaterial("plasticMat");
 	SetShaderTexture("plastic");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_front);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_back);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_left);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_right);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_bottom);
+	DrawMesh(ShapeMeshes::box_front);
+	DrawMesh(ShapeMeshes::box_back);
+	DrawMesh(ShapeMeshes::box_left);
+	DrawMesh(ShapeMeshes::box_right);
+	DrawMesh(ShapeMeshes::box_bottom);
 
 	/******************************************************************/
 	// Monitor stand (cylinder)
 	/******************************************************************/
-	float deskY = 0.05f;
-
-	scaleXYZ = glm::vec3(0.18f, 1.6f, 0.18f);
-	positionXYZ = glm::vec3(0.0f, deskY, -2.0f);
-
-	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.monitorStand);
 	SetShaderMaterial("plasticMat");
 	SetShaderTexture("DarkGrey");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	DrawMesh(MESH_CYLINDER);
 
 	/******************************************************************/
 	// Monitor (box)
 	/******************************************************************/
-	scaleXYZ = glm::vec3(7.2f, 3.4f, 0.18f);
-
-	float monitorHalfH = scaleXYZ.y * 0.5f;
-
-	positionXYZ = glm::vec3(0.0f, deskY + 1.2f + monitorHalfH, -2.0f);
-
-	SetTransformations(scaleXYZ, -10.0f, 0.0f, 0.0f, positionXYZ);
+	SetTransformNode(m_sceneNodes.monitorScreen);
 	SetShaderMaterial("plasticMat");
 	SetShaderTexture("monitorscreen");
 	SetTextureUVScale(1.0f, 1.0f);
 
 	// SCREEN FACE (no lighting  pure texture)
-	m_pShaderManager->setBoolValue(g_UseLightingName, false);
+	m_drawState.bUseLighting = false;
 	SetShaderTexture("monitorscreen");
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_front);
+	DrawMesh(ShapeMeshes::box_front);
 
 	// Everything else = plastic (frame/back)
 	SetShaderTexture("DarkGrey");
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_back);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_left);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_right);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_bottom);
+	DrawMesh(ShapeMeshes::box_back);
+	DrawMesh(ShapeMeshes::box_left);
+	DrawMesh(ShapeMeshes::box_right);
+	DrawMesh(ShapeMeshes::box_top);
+	DrawMesh(ShapeMeshes::box_bottom);
 
 	// Turn lighting back ON
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
+	m_drawState.bUseLighting = true;
 
 	/******************************************************************/
 	// Mousepad
 	/******************************************************************/
-	glm::vec3 padScale = glm::vec3(3.2f, 0.05f, 2.4f);
-	glm::vec3 padPos = glm::vec3(5.8f, deskY + (padScale.y * 0.5f) + 0.01f, -0.35f);
-
-	SetTransformations(padScale, 0.0f, 0.0f, 0.0f, padPos);
+	SetTransformNode(m_sceneNodes.mousepadBody);
 
 	// TOP FACE (logitech texture)
 	SetShaderMaterial("plasticMat");
 	SetShaderColor(1.0f, 1.0f, 1.0f, 1.0f);
 	SetShaderTexture("logitech");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
+	DrawMesh(ShapeMeshes::box_top);
 
 	// ALL OTHER SIDES (dark grey)
 	SetShaderTexture("DarkGrey");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_front);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_back);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_left);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_right);
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_bottom);
+	DrawMesh(ShapeMeshes::box_front);
+	DrawMesh(ShapeMeshes::box_back);
+	DrawMesh(ShapeMeshes::box_left);
+	DrawMesh(ShapeMeshes::box_right);
+	DrawMesh(ShapeMeshes::box_bottom);
 
 	/******************************************************************/
 	// Mouse
 	/******************************************************************/
-	float padTopY = padPos.y + (padScale.y * 0.5f);
-
-	// Size of the mouse 
-	float mouseR = 0.75f;
-	glm::vec3 mouseScale = glm::vec3(mouseR, mouseR * 0.55f, mouseR);
-
-	// Position: sit on pad
-	glm::vec3 mousePos = glm::vec3(
-		padPos.x,
-		padTopY + (mouseScale.y * 0.35f),
-		padPos.z
-	);
-
-	SetTransformations(mouseScale, 0.0f, 200.0f, 0.0f, mousePos);
+	SetTransformNode(m_sceneNodes.mouse);
 
 	//mouse texture
 	SetShaderMaterial("plasticMat");
@@ -605,49 +2706,36 @@ void SceneManager::RenderScene()
 	SetTextureUVScale(0.90f, 0.70f);
 	SetShaderTexture("mouse");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawSphereMesh();
-	m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
+	DrawMesh(MESH_SPHERE);
+	DrawMesh(ShapeMeshes::box_top);
 
 	/******************************************************************/
 	// Desk Plant (LEFT) - Pot
 	/******************************************************************/
 
-		float plantX = -5.2f;
-		float plantZ = -0.35f;
+		// the plant is one prop, drawn as an impostor from afar
+		BeginProp(m_plantProp);
 
 		// --- Pot (cylinder) ---
-		glm::vec3 potScale = glm::vec3(0.55f, 0.45f, 0.55f);
-		glm::vec3 potPos = glm::vec3(plantX, deskY + (potScale.y * 0.5f), plantZ);
-
-		SetTransformations(potScale, 0.0f, 0.0f, 0.0f, potPos);
+		SetTransformNode(m_sceneNodes.pot);
 		SetShaderMaterial("plasticMat");
 		SetShaderColor(1.0f, 1.0f, 1.0f, 1.0f);
 		SetShaderTexture("pot");
 		SetTextureUVScale(1.0f, 1.0f);
-		m_basicMeshes->DrawCylinderMesh();
+		DrawMesh(MESH_CYLINDER);
 
 		//soil
 		SetShaderTexture("soil");
 		SetTextureUVScale(1.0f, 1.0f);
-		m_basicMeshes->DrawSphereMesh();
-		m_basicMeshes->DrawBoxMeshSide(ShapeMeshes::box_top);
-
-		// Where the plant starts (top of pot)
-		float leavesBaseY = potPos.y + (potScale.y * 0.5f) + 0.02f;
-
-		// center for the plant
-		float cx = plantX;
-		float cz = plantZ;
+		DrawMesh(MESH_SPHERE);
+		DrawMesh(ShapeMeshes::box_top);
 
 		// --- Stem (skinny cylinder) ---
-		glm::vec3 stemScale = glm::vec3(0.08f, 0.70f, 0.08f);
-		glm::vec3 stemPos = glm::vec3(cx, leavesBaseY + (stemScale.y * 0.5f) - 0.12f, cz);
-
-		SetTransformations(stemScale, 0.0f, 0.0f, 0.0f, stemPos);
+		SetTransformNode(m_sceneNodes.stem);
 		SetShaderMaterial("plasticMat");
 		SetShaderColor(0.35f, 0.28f, 0.20f, 1.0f);
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_basicMeshes->DrawCylinderMesh();
+		m_drawState.bUseTexture = false;
+		DrawMesh(MESH_CYLINDER);
 
 		// --- Leaves (oval spheres) ---
 		SetShaderMaterial("plasticMat");
@@ -655,66 +2743,10 @@ void SceneManager::RenderScene()
 		SetShaderTexture("plant");
 		SetTextureUVScale(1.0f, 1.0f);
 
-		glm::vec3 leafScale = glm::vec3(0.22f, 0.07f, 0.16f);
-
-		auto DrawLeaf = [&](glm::vec3 pos, float xRot, float yRot, float zRot, glm::vec3 scaleOverride)
-			{
-				SetTransformations(scaleOverride, xRot, yRot, zRot, pos);
-				m_basicMeshes->DrawSphereMesh();
-			};
-
-		auto DrawLeafDefault = [&](glm::vec3 pos, float xRot, float yRot, float zRot)
-			{
-				DrawLeaf(pos, xRot, yRot, zRot, leafScale);
-			};
-
-		// Heights
-		float yBottom = leavesBaseY + 0.28f;
-		float yMid = leavesBaseY + 0.45f;
-		float yTop = leavesBaseY + 0.58f;
-
-		// -------- Enhanced Top Crown --------
-		glm::vec3 capScale = glm::vec3(0.16f, 0.05f, 0.12f);
-		float yCap = leavesBaseY + 0.80f;
-		float rCap = 0.09f;
-
-		// 8 leaves around tip
-		DrawLeaf(glm::vec3(cx + rCap, yCap, cz), 40.0f, 90.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx - rCap, yCap, cz), 40.0f, -90.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx, yCap, cz + rCap), 42.0f, 0.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx, yCap, cz - rCap), 35.0f, 180.0f, 0.0f, capScale);
-
-		DrawLeaf(glm::vec3(cx + 0.07f, yCap, cz + 0.07f), 45.0f, 45.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx - 0.07f, yCap, cz + 0.07f), 45.0f, -45.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx + 0.07f, yCap, cz - 0.07f), 35.0f, 135.0f, 0.0f, capScale);
-		DrawLeaf(glm::vec3(cx - 0.07f, yCap, cz - 0.07f), 35.0f, -135.0f, 0.0f, capScale);
-
-		// tiny top leaf
-		DrawLeaf(glm::vec3(cx, yCap + 0.04f, cz), 90.0f, 0.0f, 0.0f, glm::vec3(0.13f, 0.04f, 0.13f));
-
-		// -------- Bottom ring --------
-		float rB = 0.20f;
-		DrawLeafDefault(glm::vec3(cx + rB, yBottom, cz), 0.0f, 90.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx - rB, yBottom, cz), 0.0f, -90.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx, yBottom, cz + rB), 10.0f, 0.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx, yBottom, cz - rB), -10.0f, 180.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx + 0.14f, yBottom, cz + 0.14f), 8.0f, 45.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx - 0.14f, yBottom, cz + 0.14f), 8.0f, -45.0f, 0.0f);
-
-		// -------- Middle ring --------
-		float rM = 0.17f;
-		DrawLeafDefault(glm::vec3(cx + rM, yMid, cz + 0.02f), 5.0f, 80.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx - rM, yMid, cz + 0.02f), 5.0f, -80.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx + 0.02f, yMid, cz + rM), 12.0f, 0.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx - 0.02f, yMid, cz - rM), -8.0f, 180.0f, 0.0f);
-		DrawLeafDefault(glm::vec3(cx, yMid + 0.01f, cz), 25.0f, 20.0f, 0.0f);
-
-		// -------- Top ring --------
-		glm::vec3 leafScaleTop = glm::vec3(0.18f, 0.06f, 0.13f);
-		float rT = 0.12f;
-
-		DrawLeaf(glm::vec3(cx + rT, yTop, cz), 28.0f, 90.0f, 0.0f, leafScaleTop);
-		DrawLeaf(glm::vec3(cx - rT, yTop, cz), 28.0f, -90.0f, 0.0f, leafScaleTop);
-		DrawLeaf(glm::vec3(cx, yTop, cz + rT), 30.0f, 0.0f, 0.0f, leafScaleTop);
-		DrawLeaf(glm::vec3(cx, yTop, cz - rT), 22.0f, 180.0f, 0.0f, leafScaleTop);
-	}
\ No newline at end of file
+		for (int leaf : m_sceneNodes.leaves)
+		{
+			SetTransformNode(leaf);
+			DrawMesh(MESH_SPHERE);
+		}
+		EndProp();
+	}
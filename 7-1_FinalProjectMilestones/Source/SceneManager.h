@@ -11,17 +11,39 @@
 
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
+#include "DepthPrePass.h"
+#include "OcclusionCuller.h"
+#include "SceneFile.h"
+#include "ShaderPermutations.h"
+#include "DrawDataRing.h"
+#include "SceneGeometry.h"
+#include "FrameArena.h"
+#include "ShaderUniforms.h"
+#include "SceneBVH.h"
+#include "TextureAtlas.h"
+#include "CameraBuffer.h"
+#include "TransformHierarchy.h"
+#include "StaticScene.h"
+#include "ResourceAccounting.h"
+#include "ResourceCache.h"
+#include "LightBaker.h"
+#include "ImpostorCache.h"
+#include "FrameGraph.h"
 
 #include <string>
 #include <vector>
 
+class ViewManager;
+
 /***********************************************************
  *  SceneManager
  *
  *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
+ *  3D scenes, including the shader settings. The frame
+ *  passes draw the recorded scene through the draw source
+ *  interface it implements.
  ***********************************************************/
-class SceneManager
+class SceneManager : private FramePasses::DRAW_SOURCE
 {
 public:
 	// constructor
@@ -33,6 +55,14 @@ public:
 	{
 		std::string tag;
 		uint32_t ID;
+		// source image and its modification time when loaded
+		std::string filename;
+		long long fileTime;
+		// texture unit of the atlas page holding a copy of the
+		// image, or -1, and the image's tile on the page
+		int atlasUnit;
+		glm::vec4 atlasRect;
+		bool bAtlasRepeat;
 	};
 
 	struct OBJECT_MATERIAL
@@ -43,19 +73,294 @@ public:
 		std::string tag;
 	};
 
+	// basic mesh rendered by a recorded draw command
+	enum DRAW_MESH
+	{
+		MESH_PLANE,
+		MESH_BOX_SIDE,
+		MESH_CYLINDER,
+		MESH_SPHERE
+	};
+
+	// everything needed to submit one mesh draw, captured
+	// from the current shader state when the draw is recorded
+	struct DRAW_COMMAND
+	{
+		DRAW_MESH mesh;
+		ShapeMeshes::BoxSide boxSide;
+		glm::mat4 model;
+		glm::vec4 color;
+		glm::vec2 uvScale;
+		int textureSlot;
+		int materialIndex;
+		bool bUseTexture;
+		bool bUseLighting;
+		float viewDepth;
+		// scene object the draw belongs to, one per transform
+		int objectID;
+		// world space bounds of the drawn mesh
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		// slot in this frame's per-draw data buffer, or -1
+		int drawDataIndex;
+		// baked lightmap tile lighting the draw, or -1
+		int lightmapTile;
+		// compound prop the draw is part of, or -1
+		int propID;
+	};
+
+	// set the cache used to build the scene's own shader programs
+	void SetShaderProgramCache(ShaderProgramCache* pProgramCache) { m_pProgramCache = pProgramCache; }
+
+	// set the views to render, the first of which is used for
+	// sorting, the depth pre-pass and occlusion culling
+	void SetViews(const CameraBuffer::CAMERA_VIEW* pViews, int viewCount);
+	// set the view manager asked for the newest camera right
+	// before the recorded frame is submitted, or NULL for none
+	void SetViewLatch(ViewManager* pViewLatch) { m_pViewLatch = pViewLatch; }
+	// enable or disable the depth-only pre-pass
+	void SetDepthPrePass(bool bEnabled);
+	bool IsDepthPrePassEnabled() const { return m_bDepthPrePass; }
+	// enable or disable the overdraw visualization
+	void SetOverdrawView(bool bEnabled);
+	bool IsOverdrawViewEnabled() const { return m_bOverdrawView; }
+	// print the shaded fragments per pixel, which the overdraw
+	// view also does
+	void SetOverdrawStats(bool bEnabled);
+	// load the scene from a scene file instead of the built-in scene
+	bool LoadSceneFile(const char* filename);
+	// reload the scene file if it changed since it was loaded
+	void CheckSceneReload();
+	// whether the scene or its render settings changed since
+	// the last call to ClearSceneDirty()
+	bool IsSceneDirty() const { return m_bSceneDirty; }
+	void ClearSceneDirty() { m_bSceneDirty = false; }
+
+	// enable or disable the specialized shader permutations
+	void SetShaderPermutations(bool bEnabled);
+	bool IsShaderPermutationsEnabled() const { return m_bPermutations; }
+	// enable or disable reading per-draw data from the storage
+	// buffer, which needs the shader permutations
+	void SetDrawDataBuffer(bool bEnabled);
+	bool IsDrawDataBufferEnabled() const { return m_bDrawDataBuffer; }
+	// enable or disable submitting the lit scene with one
+	// multi-draw per program and texture, which needs the
+	// per-draw data buffer
+	void SetMultiDraw(bool bEnabled);
+	bool IsMultiDrawEnabled() const { return m_bMultiDraw; }
+	// enable or disable lighting static flat surfaces from the
+	// baked lightmap, which needs the shader permutations
+	void SetBakedLighting(bool bEnabled);
+	bool IsBakedLightingEnabled() const { return m_bBakedLighting; }
+	// enable or disable drawing distant compound props as
+	// billboard impostors, which needs a single view
+	void SetImpostors(bool bEnabled);
+	bool IsImpostorsEnabled() const { return m_bImpostors; }
+
+	// enable or disable occlusion culling
+	void SetOcclusionCulling(bool bEnabled);
+	bool IsOcclusionCullingEnabled() const { return m_bOcclusionCulling; }
+
+	// find the nearest scene object whose bounds a ray hits in
+	// the last submitted frame, returning -1 when there is none
+	int PickObject(const glm::vec3& origin, const glm::vec3& direction,
+		float maxDistance, float& hitDistance) const;
+
+	// transform nodes of the built-in scene; the group nodes
+	// carry no scale and place the parts under them
+	struct SCENE_NODES
+	{
+		int floor;
+		int desk;
+		int keyboard;
+		int keyboardBase;
+		int keyboardPlate;
+		int monitor;
+		int monitorStand;
+		int monitorScreen;
+		int mousepad;
+		int mousepadBody;
+		int mouse;
+		int plant;
+		int pot;
+		int stem;
+		int leafBase;
+		std::vector<int> leaves;
+	};
+	const SCENE_NODES& GetSceneNodes() const { return m_sceneNodes; }
+	// move a node of the built-in scene relative to its parent,
+	// which moves every node below it too; while a scene file
+	// is loaded, the nodes are its objects in file order
+	void SetNodeTransform(int node, const glm::vec3& scale,
+		const glm::vec3& rotationDegrees, const glm::vec3& position);
+
 private:
 	// set the scene lights
 	void SetupSceneLights();
+	// lights the permutations are given, the directional light
+	// first, returning how many there are
+	int GetSceneLights(SCENE_LIGHT lights[]) const;
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
+	// pointer to basic shapes object, shared with the other
+	// scenes through the resource cache
 	ShapeMeshes* m_basicMeshes;
+	// pointer to the shader program binary cache
+	ShaderProgramCache* m_pProgramCache;
 	// total number of loaded textures
 	int m_loadedTextures;
 	// loaded textures info
 	TEXTURE_INFO m_textureIDs[16];
+	// atlas pages shared by the small and solid color textures
+	TextureAtlas* m_pTextureAtlas;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// shader state that the next recorded draw will capture
+	DRAW_COMMAND m_drawState;
+	// draw commands recorded for the current frame
+	std::vector<DRAW_COMMAND> m_drawCommands;
+	// draw order used when submitting the recorded commands
+	std::vector<int> m_drawOrder;
+	// scratch memory for the current frame, such as sort keys
+	FrameArena* m_pFrameArena;
+	// last state sent to the shader, for skipping redundant updates
+	DRAW_COMMAND m_submittedState;
+	bool m_bSubmittedStateValid;
+	// camera matrices for the current frame
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// depth pre-pass and overdraw measurement
+	DepthPrePass* m_pDepthPrePass;
+	bool m_bDepthPrePass;
+	bool m_bOverdrawView;
+	bool m_bOverdrawStats;
+	// number of scene objects recorded this frame
+	int m_objectCount;
+	// transform node the current model matrix comes from, or
+	// -1 when it was set directly
+	int m_transformNode;
+	// occlusion queries on object bounds
+	OcclusionCuller* m_pOcclusionCuller;
+	bool m_bOcclusionCulling;
+	// hierarchy over the object bounds, for frustum culling
+	// and picking, with the bounds of each object this frame
+	SceneBVH* m_pSceneBVH;
+	// transforms of the built-in scene, world matrices being
+	// recomputed only below nodes that moved
+	TransformHierarchy* m_pTransformHierarchy;
+	SCENE_NODES m_sceneNodes;
+	std::vector<SceneBVH::BOUNDS> m_objectBounds;
+	// objects inside the frustum this frame
+	std::vector<int> m_visibleObjects;
+	std::vector<bool> m_objectVisible;
+	// object whose conditional render is open, or -1
+	int m_conditionalObject;
+	// camera position for the current frame
+	glm::vec3 m_cameraPosition;
+	// every view of the current frame, with their cameras in
+	// a uniform buffer for the scene permutations
+	CameraBuffer::CAMERA_VIEW m_views[CameraBuffer::MAX_VIEWS];
+	int m_viewCount;
+	CameraBuffer* m_pCameraBuffer;
+	// late latches the camera into the recorded frame
+	ViewManager* m_pViewLatch;
+	// view the draws being submitted go to, and whether every
+	// view is drawn by one instanced pass
+	int m_submitView;
+	bool m_bSinglePassViews;
+	// render target area the views are placed in
+	GLint m_targetViewport[4];
+	// scene loaded from a scene file, if any
+	SCENE_DESCRIPTION m_scene;
+	// impostor prop of each scene file object, or -1
+	std::vector<int> m_sceneObjectProps;
+	// transform node of each scene file object
+	std::vector<int> m_sceneObjectNodes;
+	bool m_bSceneFileLoaded;
+	std::string m_sceneFilename;
+	long long m_sceneFileTime;
+	// time of the last scene file change check, in seconds
+	double m_lastSceneCheckTime;
+	// set when the scene or render settings change
+	bool m_bSceneDirty;
+	// specialized shader programs, and the course uber shader
+	ShaderPermutations* m_pPermutations;
+	bool m_bPermutations;
+	GLuint m_uberProgramID;
+	// permutation currently bound, or -1 for the uber shader
+	int m_activePermutation;
+	// frame in which each permutation last got the frame uniforms
+	unsigned int m_frameNumber;
+	unsigned int m_permutationFrame[ShaderPermutations::PERMUTATION_COUNT];
+	// lights set up for the current frame
+	bool m_bDirectionalLightActive;
+	int m_activePointLights;
+	// persistently mapped per-draw data
+	DrawDataRing* m_pDrawDataRing;
+	bool m_bDrawDataBuffer;
+	// the bound program reads the per-draw data buffer
+	bool m_bActiveUsesDrawData;
+	// lightmap of the static flat surfaces, baked again when
+	// the scene or its lights change, and its texture unit
+	LightBaker* m_pLightBaker;
+	bool m_bBakedLighting;
+	bool m_bLightmapDirty;
+	int m_lightmapUnit;
+	// captured views of the compound props, the texture unit
+	// the billboards sample them from and the desk plant prop
+	ImpostorCache* m_pImpostorCache;
+	bool m_bImpostors;
+	int m_impostorUnit;
+	int m_plantProp;
+	// passes of the frame, run from the frame graph
+	FramePasses* m_pFramePasses;
+
+	// uniform handles of one light in a scene program
+	struct LIGHT_UNIFORMS
+	{
+		// position for point lights, direction otherwise
+		ShaderUniforms::HANDLE<glm::vec3> vector;
+		ShaderUniforms::HANDLE<glm::vec3> ambient;
+		ShaderUniforms::HANDLE<glm::vec3> diffuse;
+		ShaderUniforms::HANDLE<glm::vec3> specular;
+		ShaderUniforms::HANDLE<bool> bActive;
+	};
+	// uniform handles of a scene program, resolved the first
+	// time the program is used
+	struct SCENE_UNIFORMS
+	{
+		// program the handles belong to, 0 before resolving
+		GLuint programID;
+		ShaderUniforms::HANDLE<glm::mat4> model;
+		ShaderUniforms::HANDLE<glm::mat4> view;
+		ShaderUniforms::HANDLE<glm::mat4> projection;
+		ShaderUniforms::HANDLE<glm::vec3> viewPosition;
+		ShaderUniforms::HANDLE<int> viewOffset;
+		ShaderUniforms::HANDLE<glm::vec4> objectColor;
+		ShaderUniforms::HANDLE<int> objectTexture;
+		ShaderUniforms::HANDLE<bool> bUseTexture;
+		ShaderUniforms::HANDLE<bool> bUseLighting;
+		ShaderUniforms::HANDLE<glm::vec2> uvScale;
+		ShaderUniforms::HANDLE<glm::vec4> atlasRect;
+		ShaderUniforms::HANDLE<int> lightmapTexture;
+		ShaderUniforms::HANDLE<glm::vec4> lightmapRect;
+		ShaderUniforms::HANDLE<bool> bAtlasRepeat;
+		ShaderUniforms::HANDLE<glm::vec3> materialDiffuse;
+		ShaderUniforms::HANDLE<glm::vec3> materialSpecular;
+		ShaderUniforms::HANDLE<float> materialShininess;
+		LIGHT_UNIFORMS directionalLight;
+		LIGHT_UNIFORMS pointLights[ShaderPermutations::MAX_POINT_LIGHTS];
+		ShaderUniforms::HANDLE<bool> spotLightActive;
+	};
+	// handles of the uber shader and of each permutation
+	SCENE_UNIFORMS m_uberUniforms;
+	SCENE_UNIFORMS m_permutationUniforms[ShaderPermutations::PERMUTATION_COUNT];
+	// handles of the program currently bound
+	SCENE_UNIFORMS* m_pActiveUniforms;
+
+	// basic meshes in one shared vertex and index buffer
+	SceneGeometry* m_pSceneGeometry;
+	bool m_bMultiDraw;
 
 	// load texture images and convert to OpenGL texture data
 	bool CreateGLTexture(const char* filename, std::string tag);
@@ -63,11 +368,94 @@ private:
 	void BindGLTextures();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
+	// free one loaded texture, moving the last texture into its slot
+	void DestroyGLTexture(int textureSlot);
+	// whether a draw samples its texture from the atlas
+	bool UsesTextureAtlas(const DRAW_COMMAND& command);
+	// texture unit a draw samples, its own or an atlas page
+	int GetTextureUnit(const DRAW_COMMAND& command);
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const char* tag);
+	int FindTextureSlot(const char* tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const char* tag, OBJECT_MATERIAL& material);
+	int FindMaterialIndex(const char* tag);
+
+	// record a draw of the given mesh using the current shader state
+	void DrawMesh(DRAW_MESH mesh);
+	void DrawMesh(ShapeMeshes::BoxSide boxSide);
+	// send the state of a recorded draw command to the shader
+	void ApplyDrawState(int draw);
+	// issue the mesh draw call for a recorded draw command
+	void DrawRecordedMesh(int draw);
+	// open the conditional render for a draw's object
+	void BeginObjectDraw(int draw);
+	// close any open conditional render
+	void EndObjectDraw();
+	// query every object's bounds against the finished frame
+	void IssueOcclusionQueries();
+
+	// permutation key for the features a draw uses
+	int GetPermutationKey(const DRAW_COMMAND& command);
+	// bind a permutation, sending the per-frame uniforms the
+	// first time it is used in a frame
+	void BindPermutation(int key);
+	// rebind the uber shader that the view manager updates
+	void RestoreSceneProgram();
+	// look up the uniform handles of a scene program
+	void ResolveSceneUniforms(GLuint programID, SCENE_UNIFORMS& uniforms);
+	// whether this frame's draws read the per-draw data buffer
+	bool IsDrawDataActive() const;
+	// copy every recorded draw into the per-draw data buffer
+	void WriteDrawData();
+	// bake the lighting of the recorded static flat surfaces
+	void BakeLighting();
+	// give each recorded draw its lightmap tile
+	void AssignLightmapTiles();
+	// fade each prop's impostor by its distance, capturing
+	// the props whose draws changed since their last capture
+	void UpdateImpostors();
+	// key of everything a prop's capture depends on
+	unsigned long long GetPropKey(int prop);
+	// render a prop's draws into its impostor atlas
+	void CaptureImpostor(int prop, unsigned long long key);
+	// draw the billboards of the faded in props
+	void DrawImpostors();
+	// whether the lit draws go through multi-draw indirect
+	bool IsMultiDrawActive() const;
+	// shared geometry mesh for a recorded draw
+	SceneGeometry::GEOMETRY_MESH GetGeometryMesh(const DRAW_COMMAND& command) const;
+	// frustum planes of a view, facing inward
+	void GetFrustumPlanes(const CameraBuffer::CAMERA_VIEW& view, glm::vec4 planes[6]) const;
+	// bring the object hierarchy in line with the recorded draws
+	void UpdateSceneBVH();
+	// what the frame passes read of the sorted draws and views
+	int GetDrawOrderSize() const { return (int)m_drawOrder.size(); }
+	int GetOrderedDraw(int position) const { return m_drawOrder[position]; }
+	const glm::mat4& GetDrawModel(int draw) const { return m_drawCommands[draw].model; }
+	bool GetBatchDraw(int draw, FramePasses::BATCH_DRAW& batchDraw);
+	const glm::mat4& GetViewMatrix() const { return m_viewMatrix; }
+	const glm::mat4& GetProjectionMatrix() const { return m_projectionMatrix; }
+	int GetViewCount() const { return m_viewCount; }
+	bool IsSinglePassViews() const { return m_bSinglePassViews; }
+	// whether every view can be drawn by one instanced pass
+	bool IsSinglePassViewsAvailable() const;
+	// direct the following draws to one view
+	void SelectView(int view);
+
+	// bring the loaded textures, materials and objects in line
+	// with a scene description, touching only what changed
+	void ApplySceneDescription(const SCENE_DESCRIPTION& scene);
+	// record the draw commands for the scene file objects
+	void RecordSceneFile();
+	// submit the recorded draw commands for the frame
+	void SubmitDrawCommands();
+
+	// sort key value of a draw for one of the orders
+	unsigned long long GetSortValue(const DRAW_COMMAND& command, FramePasses::DRAW_SORT sort);
+	// sort part of the draw order, keeping the current order
+	// of draws with the same value
+	void SortDrawOrder(int begin, int end, FramePasses::DRAW_SORT sort);
 
 	// set the transformation values 
 	// into the transform buffer
@@ -77,6 +465,12 @@ private:
 		float YrotationDegrees,
 		float ZrotationDegrees,
 		glm::vec3 positionXYZ);
+	// use the world matrix of a transform node for the next draws
+	void SetTransformNode(int node);
+	// mark the next draws as parts of a compound prop, until
+	// EndProp() is called
+	void BeginProp(int prop);
+	void EndProp();
 
 	// set the color values into the shader
 	void SetShaderColor(
@@ -87,7 +481,7 @@ private:
 
 	// set the texture data into the shader
 	void SetShaderTexture(
-		std::string textureTag);
+		const char* textureTag);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
@@ -95,7 +489,7 @@ private:
 
 	// set the object material into the shader
 	void SetShaderMaterial(
-		std::string materialTag);
+		const char* materialTag);
 
 public:
 
@@ -103,5 +497,9 @@ public:
 	// customize for their own 3D scene
 	void PrepareScene();
 	void RenderScene();
+	// build the transform nodes of the 3D scene
+	void BuildSceneHierarchy();
+	// record the draw commands that make up the 3D scene
+	void RecordScene();
 
 };
\ No newline at end of file
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.cpp
+// ============
+// specialized scene shader programs built from compile-time feature defines
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderPermutations.h"
+#include "ResourceCache.h"
+
+#include <iostream>
+#include <sstream>
+
+/***********************************************************
+ *  ShaderPermutations()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderPermutations::ShaderPermutations(ShaderProgramCache* pProgramCache)
+{
+	m_pProgramCache = pProgramCache;
+	m_bInitialized = false;
+	m_builtCount = 0;
+	m_viewportExtension = NULL;
+
+	for (int i = 0; i < PERMUTATION_COUNT; i++)
+	{
+		m_programIDs[i] = 0;
+		m_buildFailed[i] = false;
+	}
+}
+
+/***********************************************************
+ *  ~ShaderPermutations()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderPermutations::~ShaderPermutations()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Initialize()
+ *
+ *  This method is used to read the GLSL source that every
+ *  permutation is built from, and to check whether the
+ *  vertex shader can pick the viewport to draw into.
+ ***********************************************************/
+bool ShaderPermutations::Initialize(const char* vertexShaderFile, const char* fragmentShaderFile)
+{
+	if (m_pProgramCache == NULL)
+		return false;
+
+	m_viewportExtension = NULL;
+	if (GLEW_VERSION_4_1 || GLEW_ARB_viewport_array)
+	{
+		if (GLEW_ARB_shader_viewport_layer_array)
+			m_viewportExtension = "GL_ARB_shader_viewport_layer_array";
+		else if (GLEW_AMD_vertex_shader_viewport_index)
+			m_viewportExtension = "GL_AMD_vertex_shader_viewport_index";
+	}
+
+	m_bInitialized =
+		m_pProgramCache->ReadSourceFile(vertexShaderFile, m_vertexSource) &&
+		m_pProgramCache->ReadSourceFile(fragmentShaderFile, m_fragmentSource);
+
+	return m_bInitialized;
+}
+
+/***********************************************************
+ *  Destroy()
+ ***********************************************************/
+void ShaderPermutations::Destroy()
+{
+	for (int i = 0; i < PERMUTATION_COUNT; i++)
+	{
+		if (m_programIDs[i] != 0)
+		{
+			ResourceCache::ReleaseProgram(m_programIDs[i]);
+			m_programIDs[i] = 0;
+		}
+		m_buildFailed[i] = false;
+	}
+	m_builtCount = 0;
+}
+
+/***********************************************************
+ *  GetKey()
+ ***********************************************************/
+int ShaderPermutations::GetKey(bool bUseTexture, bool bUseLighting, bool bDirectionalLight,
+	int pointLights, bool bUseDrawData, bool bBakedLighting)
+{
+	if (pointLights < 0)
+		pointLights = 0;
+	if (pointLights > MAX_POINT_LIGHTS)
+		pointLights = MAX_POINT_LIGHTS;
+
+	// unlit permutations ignore the lights entirely
+	if (bUseLighting == false)
+	{
+		bDirectionalLight = false;
+		pointLights = 0;
+		bBakedLighting = false;
+	}
+
+	return (bUseTexture ? 1 : 0) |
+		(bUseLighting ? 2 : 0) |
+		(bDirectionalLight ? 4 : 0) |
+		(bUseDrawData ? 8 : 0) |
+		(bBakedLighting ? 16 : 0) |
+		(pointLights << 5);
+}
+
+/***********************************************************
+ *  GetDefines()
+ ***********************************************************/
+std::string ShaderPermutations::GetDefines(int key)
+{
+	std::ostringstream defines;
+	defines << "#define USE_TEXTURE " << ((key & 1) ? 1 : 0) << "\n"
+		<< "#define USE_LIGHTING " << ((key & 2) ? 1 : 0) << "\n"
+		<< "#define USE_DIRECTIONAL_LIGHT " << ((key & 4) ? 1 : 0) << "\n"
+		<< "#define USE_DRAW_DATA_BUFFER " << (UsesDrawData(key) ? 1 : 0) << "\n"
+		<< "#define USE_BAKED_LIGHTING " << ((key & 16) ? 1 : 0) << "\n"
+		<< "#define POINT_LIGHT_COUNT " << (key >> 5) << "\n";
+	if (m_viewportExtension != NULL)
+	{
+		defines << "#extension " << m_viewportExtension << " : require\n"
+			<< "#define VIEWPORT_FROM_VERTEX 1\n";
+	}
+	return defines.str();
+}
+
+/***********************************************************
+ *  GetVersionedSource()
+ *
+ *  This method is used to raise the #version line for the
+ *  permutations that read the shader storage buffer, so the
+ *  rest keep building on GLSL 3.30.
+ ***********************************************************/
+std::string ShaderPermutations::GetVersionedSource(const std::string& source, int key)
+{
+	if (UsesDrawData(key) == false)
+		return source;
+
+	size_t versionStart = source.find("#version");
+	if (versionStart == std::string::npos)
+		return source;
+
+	size_t lineEnd = source.find('\n', versionStart);
+	if (lineEnd == std::string::npos)
+		lineEnd = source.size();
+
+	return source.substr(0, versionStart) + "#version 430 core" + source.substr(lineEnd);
+}
+
+/***********************************************************
+ *  GetProgram()
+ *
+ *  This method is used to get the program for a key. The
+ *  first request builds it, from the binary cache when the
+ *  permutation was built by an earlier run.
+ ***********************************************************/
+GLuint ShaderPermutations::GetProgram(int key)
+{
+	if ((m_bInitialized == false) || (key < 0) || (key >= PERMUTATION_COUNT))
+		return 0;
+
+	if ((m_programIDs[key] == 0) && (m_buildFailed[key] == false))
+	{
+		m_programIDs[key] = m_pProgramCache->BuildProgram(
+			GetVersionedSource(m_vertexSource, key),
+			GetVersionedSource(m_fragmentSource, key),
+			GetDefines(key));
+
+		if (m_programIDs[key] == 0)
+		{
+			std::cout << "ERROR: Could not build shader permutation " << key << std::endl;
+			m_buildFailed[key] = true;
+		}
+		else
+		{
+			m_builtCount++;
+		}
+	}
+
+	return(m_programIDs[key]);
+}
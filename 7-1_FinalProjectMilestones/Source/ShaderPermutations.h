@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderpermutations.h
+// ============
+// specialized scene shader programs built from compile-time feature defines
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+#include "ShaderProgramCache.h"
+
+/***********************************************************
+ *  ShaderPermutations
+ *
+ *  This class builds one program per combination of scene
+ *  shader features (textured, lit, directional light,
+ *  number of point lights, baked lighting and where per-draw
+ *  data is read from). Each program only contains the
+ *  code path it runs. Programs are built the first time a
+ *  draw needs them and are kept for the rest of the run.
+ ***********************************************************/
+class ShaderPermutations
+{
+public:
+	// constructor
+	ShaderPermutations(ShaderProgramCache* pProgramCache);
+	// destructor
+	~ShaderPermutations();
+
+	// highest point light count a permutation can be built for
+	static const int MAX_POINT_LIGHTS = 5;
+	// number of distinct permutation keys
+	static const int PERMUTATION_COUNT = 32 * (MAX_POINT_LIGHTS + 1);
+
+	// read the GLSL source shared by every permutation
+	bool Initialize(const char* vertexShaderFile, const char* fragmentShaderFile);
+	// free every permutation built so far
+	void Destroy();
+
+	// key identifying the permutation for a set of features
+	static int GetKey(bool bUseTexture, bool bUseLighting, bool bDirectionalLight,
+		int pointLights, bool bUseDrawData, bool bBakedLighting);
+	// whether a key reads per-draw data from the storage buffer
+	static bool UsesDrawData(int key) { return (key & 8) != 0; }
+
+	// get the program for a key, building it on first use,
+	// or 0 if it could not be built
+	GLuint GetProgram(int key);
+
+	// number of permutations built so far
+	int GetBuiltCount() const { return m_builtCount; }
+	// whether the vertex shader picks the viewport, so one
+	// instanced draw can cover several views
+	bool CanSelectViewport() const { return m_viewportExtension != NULL; }
+
+private:
+	// cache used to build and store the programs
+	ShaderProgramCache* m_pProgramCache;
+	// shared GLSL source
+	std::string m_vertexSource;
+	std::string m_fragmentSource;
+	bool m_bInitialized;
+	// built programs, indexed by key
+	GLuint m_programIDs[PERMUTATION_COUNT];
+	// keys whose build failed, so it is not retried every draw
+	bool m_buildFailed[PERMUTATION_COUNT];
+	int m_builtCount;
+	// extension that lets the vertex shader write the
+	// viewport index, or NULL when there is none
+	const char* m_viewportExtension;
+
+	// #define lines for a key
+	std::string GetDefines(int key);
+	// source with the #version line a key needs
+	std::string GetVersionedSource(const std::string& source, int key);
+};
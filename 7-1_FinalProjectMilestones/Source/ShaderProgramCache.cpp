@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderprogramcache.cpp
+// ============
+// on-disk cache of linked shader program binaries, keyed by source hash
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderProgramCache.h"
+#include "ResourceAccounting.h"
+#include "ResourceCache.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+// declaration of global variables
+namespace
+{
+	// identifies a cached program binary file
+	const uint32_t g_CacheFileMagic = 0x42505243;	// "CRPB"
+}
+
+/***********************************************************
+ *  ShaderProgramCache()
+ *
+ *  The constructor for the class. Must be called once the
+ *  OpenGL context is current.
+ ***********************************************************/
+ShaderProgramCache::ShaderProgramCache(const char* cacheDirectory)
+{
+	m_cacheDirectory = cacheDirectory;
+	m_totalBuildTime = 0.0;
+	m_cacheHits = 0;
+	m_cacheMisses = 0;
+
+	// a driver update changes these strings and so every key
+	const GLubyte* vendor = glGetString(GL_VENDOR);
+	const GLubyte* renderer = glGetString(GL_RENDERER);
+	const GLubyte* version = glGetString(GL_VERSION);
+	m_driverString = std::string(vendor ? (const char*)vendor : "") + "|" +
+		std::string(renderer ? (const char*)renderer : "") + "|" +
+		std::string(version ? (const char*)version : "");
+
+	GLint binaryFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+	m_bBinarySupported = (binaryFormats > 0);
+
+	if (m_bBinarySupported == true)
+	{
+#ifdef _WIN32
+		_mkdir(m_cacheDirectory.c_str());
+#else
+		mkdir(m_cacheDirectory.c_str(), 0755);
+#endif
+	}
+	else
+	{
+		std::cout << "INFO: Driver has no program binary formats, shader cache disabled" << std::endl;
+	}
+}
+
+/***********************************************************
+ *  ~ShaderProgramCache()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ShaderProgramCache::~ShaderProgramCache()
+{
+	std::cout << "INFO: Shader cache: " << m_cacheHits << " hits, "
+		<< m_cacheMisses << " misses" << std::endl;
+}
+
+/***********************************************************
+ *  ReadSourceFile()
+ ***********************************************************/
+bool ShaderProgramCache::ReadSourceFile(const char* filename, std::string& source)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+	{
+		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ: " << filename << std::endl;
+		return false;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	source = stream.str();
+	return true;
+}
+
+/***********************************************************
+ *  InsertDefines()
+ *
+ *  This method is used to insert #define lines right after
+ *  the #version line, which has to stay first.
+ ***********************************************************/
+std::string ShaderProgramCache::InsertDefines(const std::string& source, const std::string& defines)
+{
+	if (defines.empty())
+		return source;
+
+	size_t versionStart = source.find("#version");
+	if (versionStart == std::string::npos)
+		return defines + source;
+
+	size_t lineEnd = source.find('\n', versionStart);
+	if (lineEnd == std::string::npos)
+		return source + "\n" + defines;
+
+	return source.substr(0, lineEnd + 1) + defines + source.substr(lineEnd + 1);
+}
+
+/***********************************************************
+ *  HashKey()
+ ***********************************************************/
+unsigned long long ShaderProgramCache::HashKey(
+	const std::string& vertexSource,
+	const std::string& fragmentSource,
+	const std::string& defines)
+{
+	unsigned long long hash = 14695981039346656037ULL;
+	const std::string* parts[4] = { &vertexSource, &fragmentSource, &defines, &m_driverString };
+
+	for (int part = 0; part < 4; part++)
+	{
+		for (unsigned char character : *parts[part])
+		{
+			hash ^= character;
+			hash *= 1099511628211ULL;
+		}
+		// separator, so moving text between parts changes the key
+		hash ^= 0xFF;
+		hash *= 1099511628211ULL;
+	}
+
+	return(hash);
+}
+
+/***********************************************************
+ *  GetCacheFilename()
+ ***********************************************************/
+std::string ShaderProgramCache::GetCacheFilename(unsigned long long key)
+{
+	std::ostringstream filename;
+	filename << m_cacheDirectory << "/" << std::hex << key << ".bin";
+	return filename.str();
+}
+
+/***********************************************************
+ *  LoadCachedProgram()
+ *
+ *  This method is used to create a program from a cached
+ *  binary. The driver may reject a binary at any time, for
+ *  example after a driver update that kept its version
+ *  string, in which case 0 is returned.
+ ***********************************************************/
+GLuint ShaderProgramCache::LoadCachedProgram(unsigned long long key)
+{
+	std::ifstream file(GetCacheFilename(key).c_str(), std::ios::binary);
+	if (!file.is_open())
+		return 0;
+
+	uint32_t magic = 0;
+	uint32_t binaryFormat = 0;
+	uint32_t binaryLength = 0;
+	file.read((char*)&magic, sizeof(magic));
+	file.read((char*)&binaryFormat, sizeof(binaryFormat));
+	file.read((char*)&binaryLength, sizeof(binaryLength));
+	if (file.fail() || (magic != g_CacheFileMagic) || (binaryLength == 0))
+		return 0;
+
+	std::vector<char> binary(binaryLength);
+	file.read(binary.data(), binaryLength);
+	if (file.fail())
+		return 0;
+
+	GLuint programID = glCreateProgram();
+	glProgramBinary(programID, (GLenum)binaryFormat, binary.data(), (GLsizei)binaryLength);
+
+	GLint success = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		std::cout << "INFO: Cached shader binary rejected by the driver, recompiling" << std::endl;
+		glDeleteProgram(programID);
+		return 0;
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  SaveCachedProgram()
+ ***********************************************************/
+void ShaderProgramCache::SaveCachedProgram(unsigned long long key, GLuint programID)
+{
+	GLint binaryLength = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0)
+		return;
+
+	std::vector<char> binary(binaryLength);
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(programID, binaryLength, NULL, &binaryFormat, binary.data());
+
+	std::ofstream file(GetCacheFilename(key).c_str(), std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return;
+
+	uint32_t format = (uint32_t)binaryFormat;
+	uint32_t length = (uint32_t)binaryLength;
+	file.write((const char*)&g_CacheFileMagic, sizeof(g_CacheFileMagic));
+	file.write((const char*)&format, sizeof(format));
+	file.write((const char*)&length, sizeof(length));
+	file.write(binary.data(), binaryLength);
+}
+
+/***********************************************************
+ *  CompileShader()
+ ***********************************************************/
+GLuint ShaderProgramCache::CompileShader(GLenum type, const std::string& source)
+{
+	GLuint shaderID = glCreateShader(type);
+	const char* sourceText = source.c_str();
+	glShaderSource(shaderID, 1, &sourceText, NULL);
+	glCompileShader(shaderID);
+
+	GLint success = 0;
+	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success);
+	if (!success)
+	{
+		GLchar infoLog[1024];
+		glGetShaderInfoLog(shaderID, 1024, NULL, infoLog);
+		std::cout << "ERROR::SHADER_COMPILATION_ERROR of type: "
+			<< ((type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT") << "\n"
+			<< infoLog << std::endl;
+		glDeleteShader(shaderID);
+		return 0;
+	}
+
+	return(shaderID);
+}
+
+/***********************************************************
+ *  CompileProgram()
+ ***********************************************************/
+GLuint ShaderProgramCache::CompileProgram(const std::string& vertexSource, const std::string& fragmentSource)
+{
+	GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, vertexSource);
+	GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSource);
+	if ((vertexShader == 0) || (fragmentShader == 0))
+	{
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return 0;
+	}
+
+	GLuint programID = glCreateProgram();
+	glAttachShader(programID, vertexShader);
+	glAttachShader(programID, fragmentShader);
+
+	// ask the driver to keep a retrievable binary
+	if (m_bBinarySupported == true)
+	{
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	glLinkProgram(programID);
+
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	GLint success = 0;
+	glGetProgramiv(programID, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		GLchar infoLog[1024];
+		glGetProgramInfoLog(programID, 1024, NULL, infoLog);
+		std::cout << "ERROR::PROGRAM_LINKING_ERROR\n" << infoLog << std::endl;
+		glDeleteProgram(programID);
+		return 0;
+	}
+
+	return(programID);
+}
+
+/***********************************************************
+ *  BuildProgram()
+ *
+ *  This method is used to get a linked program for the
+ *  given source and defines, from the cache when possible.
+ *  A program that is still resident is shared with another
+ *  reference, so it has to be freed with
+ *  ResourceCache::ReleaseProgram() rather than deleted.
+ ***********************************************************/
+GLuint ShaderProgramCache::BuildProgram(
+	const std::string& vertexSource,
+	const std::string& fragmentSource,
+	const std::string& defines)
+{
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	unsigned long long key = HashKey(vertexSource, fragmentSource, defines);
+
+	// another user already holds the same program
+	GLuint programID = ResourceCache::AcquireProgram(key);
+	if (programID != 0)
+		return(programID);
+
+	if (m_bBinarySupported == true)
+	{
+		programID = LoadCachedProgram(key);
+	}
+
+	bool bCacheHit = (programID != 0);
+	if (bCacheHit == false)
+	{
+		programID = CompileProgram(
+			InsertDefines(vertexSource, defines),
+			InsertDefines(fragmentSource, defines));
+		if ((programID != 0) && (m_bBinarySupported == true))
+		{
+			SaveCachedProgram(key, programID);
+		}
+	}
+
+	double milliseconds = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - startTime).count();
+	m_totalBuildTime += milliseconds;
+	ResourceCache::AddProgram(key, programID);
+	if (bCacheHit == true)
+		m_cacheHits++;
+	else
+		m_cacheMisses++;
+
+	std::cout << "INFO: Shader program " << std::hex << key << std::dec
+		<< (bCacheHit ? " loaded from cache in " : " compiled in ")
+		<< milliseconds << " ms" << std::endl;
+
+	return(programID);
+}
+
+/***********************************************************
+ *  LoadProgram()
+ *
+ *  This method is used to build a program from GLSL files.
+ ***********************************************************/
+GLuint ShaderProgramCache::LoadProgram(
+	const char* vertexShaderFile,
+	const char* fragmentShaderFile,
+	const std::string& defines)
+{
+	std::string vertexSource;
+	std::string fragmentSource;
+	if ((ReadSourceFile(vertexShaderFile, vertexSource) == false) ||
+		(ReadSourceFile(fragmentShaderFile, fragmentSource) == false))
+		return 0;
+
+	return BuildProgram(vertexSource, fragmentSource, defines);
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderprogramcache.h
+// ============
+// on-disk cache of linked shader program binaries, keyed by source hash
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+
+/***********************************************************
+ *  ShaderProgramCache
+ *
+ *  This class builds shader programs from GLSL source and
+ *  saves the linked program binary to disk. The cache key
+ *  hashes the source text, the compile-time defines and
+ *  the driver's vendor, renderer and version strings, so
+ *  any change to one of them misses the cache. Binaries
+ *  the driver rejects fall back to a full compile.
+ ***********************************************************/
+class ShaderProgramCache
+{
+public:
+	// constructor
+	ShaderProgramCache(const char* cacheDirectory);
+	// destructor
+	~ShaderProgramCache();
+
+	// build a program from GLSL source files
+	GLuint LoadProgram(
+		const char* vertexShaderFile,
+		const char* fragmentShaderFile,
+		const std::string& defines);
+
+	// build a program from GLSL source text, with the defines
+	// inserted after the #version line of each stage; the
+	// program is shared and freed with ResourceCache
+	GLuint BuildProgram(
+		const std::string& vertexSource,
+		const std::string& fragmentSource,
+		const std::string& defines);
+
+	// total time spent building programs, in milliseconds
+	double GetTotalBuildTime() const { return m_totalBuildTime; }
+
+	// read a whole text file
+	bool ReadSourceFile(const char* filename, std::string& source);
+
+private:
+	// folder that holds the cached binaries
+	std::string m_cacheDirectory;
+	// driver identification, part of every cache key
+	std::string m_driverString;
+	// whether the driver can save program binaries at all
+	bool m_bBinarySupported;
+	// running totals for the startup log
+	double m_totalBuildTime;
+	int m_cacheHits;
+	int m_cacheMisses;
+
+	// insert the defines after the #version line
+	std::string InsertDefines(const std::string& source, const std::string& defines);
+	// 64-bit FNV-1a hash of the cache key
+	unsigned long long HashKey(
+		const std::string& vertexSource,
+		const std::string& fragmentSource,
+		const std::string& defines);
+	// path of the cache file for a key
+	std::string GetCacheFilename(unsigned long long key);
+
+	// load a program from a cached binary, 0 on a miss or reject
+	GLuint LoadCachedProgram(unsigned long long key);
+	// save a linked program's binary to the cache
+	void SaveCachedProgram(unsigned long long key, GLuint programID);
+	// compile and link a program from source
+	GLuint CompileProgram(const std::string& vertexSource, const std::string& fragmentSource);
+	// compile one shader stage
+	GLuint CompileShader(GLenum type, const std::string& source);
+};
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.cpp
+// ============
+// reflected uniform locations of a shader program and typed handles to them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShaderUniforms.h"
+
+#include <iostream>
+#include <cstring>
+
+#include <glm/gtc/type_ptr.hpp>
+
+// declaration of global variables
+namespace
+{
+	// suffix of the first element of an array uniform
+	const char* g_ArraySuffix = "[0]";
+	const size_t g_ArraySuffixLength = 3;
+
+	/***********************************************************
+	 *  HasProgramUniform()
+	 *
+	 *  This function is used to check for glProgramUniform*,
+	 *  core since OpenGL 4.1.
+	 ***********************************************************/
+	bool HasProgramUniform()
+	{
+		return GLEW_VERSION_4_1 || GLEW_ARB_separate_shader_objects;
+	}
+
+	/***********************************************************
+	 *  BindForUniform()
+	 *
+	 *  This function is used by contexts without
+	 *  glProgramUniform*, binding the handle's program for a
+	 *  glUniform* call and returning the program to restore.
+	 ***********************************************************/
+	GLint BindForUniform(GLuint programID)
+	{
+		GLint previousProgram = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+		if ((GLuint)previousProgram != programID)
+			glUseProgram(programID);
+		return previousProgram;
+	}
+
+	/***********************************************************
+	 *  RestoreAfterUniform()
+	 ***********************************************************/
+	void RestoreAfterUniform(GLuint programID, GLint previousProgram)
+	{
+		if ((GLuint)previousProgram != programID)
+			glUseProgram(previousProgram);
+	}
+}
+
+/***********************************************************
+ *  ShaderUniforms()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ShaderUniforms::ShaderUniforms(GLuint programID)
+{
+	m_programID = 0;
+	Reflect(programID);
+}
+
+/***********************************************************
+ *  Reflect()
+ *
+ *  This method is used to build the uniform table. Uniforms
+ *  inside uniform or storage blocks have no location and
+ *  are left out. Contexts without program interface queries
+ *  use the older active uniform queries.
+ ***********************************************************/
+void ShaderUniforms::Reflect(GLuint programID)
+{
+	m_programID = programID;
+	m_uniforms.clear();
+	if (programID == 0)
+		return;
+
+	std::vector<char> name;
+	if (GLEW_VERSION_4_3 || GLEW_ARB_program_interface_query)
+	{
+		GLint count = 0;
+		glGetProgramInterfaceiv(programID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &count);
+
+		const GLenum properties[3] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION };
+		for (GLint i = 0; i < count; i++)
+		{
+			GLint values[3] = { 0, 0, -1 };
+			glGetProgramResourceiv(programID, GL_UNIFORM, i, 3, properties, 3, NULL, values);
+			if ((values[2] < 0) || (values[0] <= 0))
+				continue;
+
+			name.resize(values[0]);
+			glGetProgramResourceName(programID, GL_UNIFORM, i, values[0], NULL, name.data());
+			AddUniform(name.data(), (GLenum)values[1], values[2]);
+		}
+	}
+	else
+	{
+		GLint count = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		name.resize(maxLength + 1);
+
+		for (GLint i = 0; i < count; i++)
+		{
+			GLint size = 0;
+			GLenum type = 0;
+			name[0] = '\0';
+			glGetActiveUniform(programID, i, maxLength + 1, NULL, &size, &type, name.data());
+			GLint location = glGetUniformLocation(programID, name.data());
+			if (location < 0)
+				continue;
+
+			AddUniform(name.data(), type, location);
+		}
+	}
+}
+
+/***********************************************************
+ *  AddUniform()
+ ***********************************************************/
+void ShaderUniforms::AddUniform(const char* name, GLenum type, GLint location)
+{
+	UNIFORM_INFO uniform;
+	uniform.name = name;
+	uniform.type = type;
+	uniform.location = location;
+
+	size_t length = uniform.name.length();
+	if ((length > g_ArraySuffixLength) &&
+		(uniform.name.compare(length - g_ArraySuffixLength, g_ArraySuffixLength, g_ArraySuffix) == 0))
+	{
+		uniform.name.erase(length - g_ArraySuffixLength);
+	}
+
+	m_uniforms.push_back(uniform);
+}
+
+/***********************************************************
+ *  FindUniform()
+ ***********************************************************/
+const ShaderUniforms::UNIFORM_INFO* ShaderUniforms::FindUniform(const std::string& name) const
+{
+	size_t length = name.length();
+	if ((length > g_ArraySuffixLength) &&
+		(name.compare(length - g_ArraySuffixLength, g_ArraySuffixLength, g_ArraySuffix) == 0))
+	{
+		length -= g_ArraySuffixLength;
+	}
+
+	for (const UNIFORM_INFO& uniform : m_uniforms)
+	{
+		if ((uniform.name.length() == length) && (name.compare(0, length, uniform.name) == 0))
+			return &uniform;
+	}
+
+	return NULL;
+}
+
+/***********************************************************
+ *  ReportTypeMismatch()
+ ***********************************************************/
+void ShaderUniforms::ReportTypeMismatch(const std::string& name) const
+{
+	std::cout << "ERROR: Uniform " << name << " of program " << m_programID
+		<< " does not have the requested type" << std::endl;
+}
+
+/***********************************************************
+ *  AcceptsType()
+ *
+ *  Booleans can be set with integers, and samplers with the
+ *  texture unit as an integer.
+ ***********************************************************/
+bool ShaderUniforms::AcceptsType(GLenum type, const bool*)
+{
+	return (type == GL_BOOL) || (type == GL_INT);
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const int*)
+{
+	return (type == GL_INT) || (type == GL_BOOL) ||
+		(type == GL_SAMPLER_2D) || (type == GL_SAMPLER_CUBE) || (type == GL_SAMPLER_2D_ARRAY);
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const float*)
+{
+	return type == GL_FLOAT;
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const glm::vec2*)
+{
+	return type == GL_FLOAT_VEC2;
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const glm::vec3*)
+{
+	return type == GL_FLOAT_VEC3;
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const glm::vec4*)
+{
+	return type == GL_FLOAT_VEC4;
+}
+
+bool ShaderUniforms::AcceptsType(GLenum type, const glm::mat4*)
+{
+	return type == GL_FLOAT_MAT4;
+}
+
+/***********************************************************
+ *  Set()
+ ***********************************************************/
+void ShaderUniforms::Set(const HANDLE<bool>& handle, bool value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform1i(handle.programID, handle.location, (int)value);
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform1i(handle.location, (int)value);
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<int>& handle, int value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform1i(handle.programID, handle.location, value);
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform1i(handle.location, value);
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<float>& handle, float value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform1f(handle.programID, handle.location, value);
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform1f(handle.location, value);
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<glm::vec2>& handle, const glm::vec2& value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform2fv(handle.programID, handle.location, 1, glm::value_ptr(value));
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform2fv(handle.location, 1, glm::value_ptr(value));
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<glm::vec3>& handle, const glm::vec3& value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform3fv(handle.programID, handle.location, 1, glm::value_ptr(value));
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform3fv(handle.location, 1, glm::value_ptr(value));
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<glm::vec4>& handle, const glm::vec4& value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniform4fv(handle.programID, handle.location, 1, glm::value_ptr(value));
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniform4fv(handle.location, 1, glm::value_ptr(value));
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
+
+void ShaderUniforms::Set(const HANDLE<glm::mat4>& handle, const glm::mat4& value)
+{
+	if (handle.location < 0)
+		return;
+
+	if (HasProgramUniform())
+	{
+		glProgramUniformMatrix4fv(handle.programID, handle.location, 1, GL_FALSE, glm::value_ptr(value));
+		return;
+	}
+	GLint previousProgram = BindForUniform(handle.programID);
+	glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
+	RestoreAfterUniform(handle.programID, previousProgram);
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// shaderuniforms.h
+// ============
+// reflected uniform locations of a shader program and typed handles to them
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  ShaderUniforms
+ *
+ *  This class reads the active uniforms of a linked program
+ *  into a table of names, types and locations. Code that
+ *  sets uniforms looks each name up once and keeps the
+ *  typed handle it gets back; setting a value through a
+ *  handle is then a single glProgramUniform* call, with no
+ *  name lookup and no need for the program to be bound.
+ ***********************************************************/
+class ShaderUniforms
+{
+public:
+	// location of one uniform in one program, typed by the
+	// value it is set with. A location of -1 ignores values,
+	// the same as glUniform* does.
+	template<typename T>
+	struct HANDLE
+	{
+		GLuint programID;
+		GLint location;
+
+		HANDLE() : programID(0), location(-1) {}
+		bool IsValid() const { return location >= 0; }
+	};
+
+	// constructor, reflecting the program if one is given
+	ShaderUniforms(GLuint programID = 0);
+
+	// read the active uniforms of a linked program
+	void Reflect(GLuint programID);
+	GLuint GetProgramID() const { return m_programID; }
+	int GetUniformCount() const { return (int)m_uniforms.size(); }
+
+	// look up a uniform, returning an invalid handle when the
+	// program has no such uniform or it has another type
+	template<typename T>
+	HANDLE<T> GetHandle(const std::string& name) const
+	{
+		HANDLE<T> handle;
+		const UNIFORM_INFO* pUniform = FindUniform(name);
+		if (pUniform == NULL)
+			return handle;
+
+		if (AcceptsType(pUniform->type, (const T*)NULL) == false)
+		{
+			ReportTypeMismatch(name);
+			return handle;
+		}
+
+		handle.programID = m_programID;
+		handle.location = pUniform->location;
+		return handle;
+	}
+
+	// set a uniform through its handle
+	static void Set(const HANDLE<bool>& handle, bool value);
+	static void Set(const HANDLE<int>& handle, int value);
+	static void Set(const HANDLE<float>& handle, float value);
+	static void Set(const HANDLE<glm::vec2>& handle, const glm::vec2& value);
+	static void Set(const HANDLE<glm::vec3>& handle, const glm::vec3& value);
+	static void Set(const HANDLE<glm::vec4>& handle, const glm::vec4& value);
+	static void Set(const HANDLE<glm::mat4>& handle, const glm::mat4& value);
+
+private:
+	// one active uniform of the program
+	struct UNIFORM_INFO
+	{
+		std::string name;
+		GLenum type;
+		GLint location;
+	};
+
+	GLuint m_programID;
+	std::vector<UNIFORM_INFO> m_uniforms;
+
+	// add a uniform, dropping the [0] that arrays are reported with
+	void AddUniform(const char* name, GLenum type, GLint location);
+	const UNIFORM_INFO* FindUniform(const std::string& name) const;
+	void ReportTypeMismatch(const std::string& name) const;
+
+	// GL types a handle of each value type can be set on
+	static bool AcceptsType(GLenum type, const bool*);
+	static bool AcceptsType(GLenum type, const int*);
+	static bool AcceptsType(GLenum type, const float*);
+	static bool AcceptsType(GLenum type, const glm::vec2*);
+	static bool AcceptsType(GLenum type, const glm::vec3*);
+	static bool AcceptsType(GLenum type, const glm::vec4*);
+	static bool AcceptsType(GLenum type, const glm::mat4*);
+};
@@ -0,0 +1,552 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticscene.cpp
+// ============
+// built-in scene transforms and bounds worked out when the program is compiled
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StaticScene.h"
+#include "TransformHierarchy.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// constant vector and matrix types, since glm's cannot be
+	// built in constant expressions; the matrix is column
+	// major like glm::mat4 so it can be copied straight over
+	struct VEC3
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	struct MAT4
+	{
+		float m[4][4];
+	};
+
+	struct BOUNDS
+	{
+		VEC3 min;
+		VEC3 max;
+	};
+
+	// transform of a node relative to its parent
+	struct NODE_DESC
+	{
+		int parent;
+		VEC3 scale;
+		VEC3 rotationDegrees;
+		VEC3 position;
+	};
+
+	// everything computed from the node table
+	struct BAKED_SCENE
+	{
+		MAT4 local[StaticScene::NODE_COUNT];
+		MAT4 world[StaticScene::NODE_COUNT];
+		BOUNDS bounds[StaticScene::NODE_COUNT][StaticScene::SHAPE_COUNT];
+	};
+
+	constexpr double g_Pi = 3.14159265358979323846;
+
+	// terms of the sine and cosine series, enough for double
+	// precision once the angle is within -pi to pi
+	constexpr int g_SeriesTerms = 12;
+
+	// largest difference from glm that Verify() accepts, per
+	// unit of the compared value
+	const float g_VerifyTolerance = 0.0001f;
+
+	/***********************************************************
+	 *  ReduceAngle()
+	 ***********************************************************/
+	constexpr double ReduceAngle(double radians)
+	{
+		while (radians > g_Pi)
+			radians -= 2.0 * g_Pi;
+		while (radians < -g_Pi)
+			radians += 2.0 * g_Pi;
+		return(radians);
+	}
+
+	/***********************************************************
+	 *  Sine()
+	 ***********************************************************/
+	constexpr double Sine(double radians)
+	{
+		double x = ReduceAngle(radians);
+		double term = x;
+		double sum = x;
+		for (int n = 1; n < g_SeriesTerms; n++)
+		{
+			term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+			sum += term;
+		}
+		return(sum);
+	}
+
+	/***********************************************************
+	 *  Cosine()
+	 ***********************************************************/
+	constexpr double Cosine(double radians)
+	{
+		double x = ReduceAngle(radians);
+		double term = 1.0;
+		double sum = 1.0;
+		for (int n = 1; n < g_SeriesTerms; n++)
+		{
+			term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+			sum += term;
+		}
+		return(sum);
+	}
+
+	/***********************************************************
+	 *  Identity()
+	 ***********************************************************/
+	constexpr MAT4 Identity()
+	{
+		MAT4 result = {};
+		for (int i = 0; i < 4; i++)
+			result.m[i][i] = 1.0f;
+		return(result);
+	}
+
+	/***********************************************************
+	 *  Multiply()
+	 *
+	 *  Column major product a * b, the same as glm's.
+	 ***********************************************************/
+	constexpr MAT4 Multiply(const MAT4& a, const MAT4& b)
+	{
+		MAT4 result = {};
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				float sum = 0.0f;
+				for (int k = 0; k < 4; k++)
+					sum += a.m[k][row] * b.m[column][k];
+				result.m[column][row] = sum;
+			}
+		}
+		return(result);
+	}
+
+	/***********************************************************
+	 *  Rotate()
+	 *
+	 *  Rotation about the X, Y or Z axis by an angle in
+	 *  degrees, for an axis of 0, 1 or 2.
+	 ***********************************************************/
+	constexpr MAT4 Rotate(int axis, float degrees)
+	{
+		double radians = degrees * (g_Pi / 180.0);
+		float c = (float)Cosine(radians);
+		float s = (float)Sine(radians);
+		int u = (axis + 1) % 3;
+		int v = (axis + 2) % 3;
+
+		MAT4 result = Identity();
+		result.m[u][u] = c;
+		result.m[u][v] = s;
+		result.m[v][u] = -s;
+		result.m[v][v] = c;
+		return(result);
+	}
+
+	/***********************************************************
+	 *  Compose()
+	 *
+	 *  Scale, then rotate about X, Y and Z, then translate,
+	 *  the same order as TransformHierarchy uses.
+	 ***********************************************************/
+	constexpr MAT4 Compose(const NODE_DESC& node)
+	{
+		MAT4 scale = Identity();
+		scale.m[0][0] = node.scale.x;
+		scale.m[1][1] = node.scale.y;
+		scale.m[2][2] = node.scale.z;
+
+		MAT4 translation = Identity();
+		translation.m[3][0] = node.position.x;
+		translation.m[3][1] = node.position.y;
+		translation.m[3][2] = node.position.z;
+
+		MAT4 rotation = Multiply(Rotate(2, node.rotationDegrees.z),
+			Multiply(Rotate(1, node.rotationDegrees.y), Rotate(0, node.rotationDegrees.x)));
+		return(Multiply(translation, Multiply(rotation, scale)));
+	}
+
+	/***********************************************************
+	 *  LocalBounds()
+	 ***********************************************************/
+	constexpr BOUNDS LocalBounds(int shape)
+	{
+		BOUNDS bounds = { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+		if (shape == StaticScene::SHAPE_PLANE)
+		{
+			bounds.min.y = 0.0f;
+			bounds.max.y = 0.0f;
+		}
+		else if (shape == StaticScene::SHAPE_BOX)
+		{
+			bounds = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+		}
+		return(bounds);
+	}
+
+	/***********************************************************
+	 *  TransformBounds()
+	 *
+	 *  World bounds enclosing the eight transformed corners of
+	 *  a box, the same as SceneManager::DrawMesh() computes.
+	 ***********************************************************/
+	constexpr BOUNDS TransformBounds(const MAT4& matrix, const BOUNDS& local)
+	{
+		BOUNDS result = {};
+		for (int corner = 0; corner < 8; corner++)
+		{
+			float x = (corner & 1) ? local.max.x : local.min.x;
+			float y = (corner & 2) ? local.max.y : local.min.y;
+			float z = (corner & 4) ? local.max.z : local.min.z;
+
+			float world[3] = {};
+			for (int row = 0; row < 3; row++)
+			{
+				world[row] = matrix.m[0][row] * x + matrix.m[1][row] * y +
+					matrix.m[2][row] * z + matrix.m[3][row];
+			}
+
+			if (corner == 0)
+			{
+				result.min = { world[0], world[1], world[2] };
+				result.max = result.min;
+			}
+			else
+			{
+				result.min.x = (world[0] < result.min.x) ? world[0] : result.min.x;
+				result.min.y = (world[1] < result.min.y) ? world[1] : result.min.y;
+				result.min.z = (world[2] < result.min.z) ? world[2] : result.min.z;
+				result.max.x = (world[0] > result.max.x) ? world[0] : result.max.x;
+				result.max.y = (world[1] > result.max.y) ? world[1] : result.max.y;
+				result.max.z = (world[2] > result.max.z) ? world[2] : result.max.z;
+			}
+		}
+		return(result);
+	}
+
+	/***********************************************************
+	 *  Leaf()
+	 *
+	 *  Leaves are placed relative to the top of the pot.
+	 ***********************************************************/
+	constexpr NODE_DESC Leaf(VEC3 position, float xRot, float yRot, VEC3 scale)
+	{
+		return { StaticScene::NODE_LEAF_BASE, scale, { xRot, yRot, 0.0f }, position };
+	}
+
+	// floor and desk planes
+	constexpr float g_DeskY = 0.05f;
+
+	// keyboard base with the top plate resting on it
+	constexpr VEC3 g_BaseScale = { 6.5f, 0.35f, 2.2f };
+	constexpr VEC3 g_PlateScale = { 6.3f, 0.12f, 2.0f };
+
+	// monitor screen above the stand
+	constexpr VEC3 g_ScreenScale = { 7.2f, 3.4f, 0.18f };
+
+	// mousepad, with the mouse sitting on it
+	constexpr VEC3 g_PadScale = { 3.2f, 0.05f, 2.4f };
+	constexpr float g_MouseR = 0.75f;
+	constexpr VEC3 g_MouseScale = { g_MouseR, g_MouseR * 0.55f, g_MouseR };
+
+	// desk plant: the pot stands on the desk, and the stem
+	// and leaves start at the top of the pot
+	constexpr VEC3 g_PotScale = { 0.55f, 0.45f, 0.55f };
+	constexpr VEC3 g_StemScale = { 0.08f, 0.70f, 0.08f };
+	constexpr float g_LeavesBaseY = g_PotScale.y + 0.02f;
+
+	// leaf sizes and ring heights and radii
+	constexpr VEC3 g_LeafScale = { 0.22f, 0.07f, 0.16f };
+	constexpr VEC3 g_LeafScaleTop = { 0.18f, 0.06f, 0.13f };
+	constexpr VEC3 g_CapScale = { 0.16f, 0.05f, 0.12f };
+	constexpr float g_YBottom = 0.28f;
+	constexpr float g_YMid = 0.45f;
+	constexpr float g_YTop = 0.58f;
+	constexpr float g_YCap = 0.80f;
+	constexpr float g_RCap = 0.09f;
+	constexpr float g_RBottom = 0.20f;
+	constexpr float g_RMid = 0.17f;
+	constexpr float g_RTop = 0.12f;
+
+	constexpr VEC3 g_UnitScale = { 1.0f, 1.0f, 1.0f };
+	constexpr VEC3 g_NoRotation = { 0.0f, 0.0f, 0.0f };
+	constexpr VEC3 g_Origin = { 0.0f, 0.0f, 0.0f };
+
+	// the built-in scene, in StaticScene::NODE order
+	constexpr NODE_DESC g_Nodes[StaticScene::NODE_COUNT] =
+	{
+		{ -1, { 20.0f, 1.0f, 10.0f }, g_NoRotation, g_Origin },
+		{ -1, { 12.0f, 1.0f, 6.0f }, g_NoRotation, { 0.0f, g_DeskY, 0.0f } },
+
+		{ -1, g_UnitScale, g_NoRotation, { 0.0f, 0.20f, -0.40f } },
+		{ StaticScene::NODE_KEYBOARD, g_BaseScale, g_NoRotation, g_Origin },
+		{ StaticScene::NODE_KEYBOARD, g_PlateScale, g_NoRotation,
+			{ 0.0f, (g_BaseScale.y / 2.0f) + (g_PlateScale.y / 2.0f), 0.0f } },
+
+		{ -1, g_UnitScale, g_NoRotation, { 0.0f, g_DeskY, -2.0f } },
+		{ StaticScene::NODE_MONITOR, { 0.18f, 1.6f, 0.18f }, g_NoRotation, g_Origin },
+		{ StaticScene::NODE_MONITOR, g_ScreenScale, { -10.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.2f + (g_ScreenScale.y * 0.5f), 0.0f } },
+
+		{ -1, g_UnitScale, g_NoRotation, { 5.8f, g_DeskY + (g_PadScale.y * 0.5f) + 0.01f, -0.35f } },
+		{ StaticScene::NODE_MOUSEPAD, g_PadScale, g_NoRotation, g_Origin },
+		{ StaticScene::NODE_MOUSEPAD, g_MouseScale, { 0.0f, 200.0f, 0.0f },
+			{ 0.0f, (g_PadScale.y * 0.5f) + (g_MouseScale.y * 0.35f), 0.0f } },
+
+		{ -1, g_UnitScale, g_NoRotation, { -5.2f, g_DeskY, -0.35f } },
+		{ StaticScene::NODE_PLANT, g_PotScale, g_NoRotation, { 0.0f, g_PotScale.y * 0.5f, 0.0f } },
+		{ StaticScene::NODE_PLANT, g_StemScale, g_NoRotation,
+			{ 0.0f, g_LeavesBaseY + (g_StemScale.y * 0.5f) - 0.12f, 0.0f } },
+		{ StaticScene::NODE_PLANT, g_UnitScale, g_NoRotation, { 0.0f, g_LeavesBaseY, 0.0f } },
+
+		// 8 leaves around tip
+		Leaf({ g_RCap, g_YCap, 0.0f }, 40.0f, 90.0f, g_CapScale),
+		Leaf({ -g_RCap, g_YCap, 0.0f }, 40.0f, -90.0f, g_CapScale),
+		Leaf({ 0.0f, g_YCap, g_RCap }, 42.0f, 0.0f, g_CapScale),
+		Leaf({ 0.0f, g_YCap, -g_RCap }, 35.0f, 180.0f, g_CapScale),
+
+		Leaf({ 0.07f, g_YCap, 0.07f }, 45.0f, 45.0f, g_CapScale),
+		Leaf({ -0.07f, g_YCap, 0.07f }, 45.0f, -45.0f, g_CapScale),
+		Leaf({ 0.07f, g_YCap, -0.07f }, 35.0f, 135.0f, g_CapScale),
+		Leaf({ -0.07f, g_YCap, -0.07f }, 35.0f, -135.0f, g_CapScale),
+
+		// tiny top leaf
+		Leaf({ 0.0f, g_YCap + 0.04f, 0.0f }, 90.0f, 0.0f, { 0.13f, 0.04f, 0.13f }),
+
+		// bottom ring
+		Leaf({ g_RBottom, g_YBottom, 0.0f }, 0.0f, 90.0f, g_LeafScale),
+		Leaf({ -g_RBottom, g_YBottom, 0.0f }, 0.0f, -90.0f, g_LeafScale),
+		Leaf({ 0.0f, g_YBottom, g_RBottom }, 10.0f, 0.0f, g_LeafScale),
+		Leaf({ 0.0f, g_YBottom, -g_RBottom }, -10.0f, 180.0f, g_LeafScale),
+		Leaf({ 0.14f, g_YBottom, 0.14f }, 8.0f, 45.0f, g_LeafScale),
+		Leaf({ -0.14f, g_YBottom, 0.14f }, 8.0f, -45.0f, g_LeafScale),
+
+		// middle ring
+		Leaf({ g_RMid, g_YMid, 0.02f }, 5.0f, 80.0f, g_LeafScale),
+		Leaf({ -g_RMid, g_YMid, 0.02f }, 5.0f, -80.0f, g_LeafScale),
+		Leaf({ 0.02f, g_YMid, g_RMid }, 12.0f, 0.0f, g_LeafScale),
+		Leaf({ -0.02f, g_YMid, -g_RMid }, -8.0f, 180.0f, g_LeafScale),
+		Leaf({ 0.0f, g_YMid + 0.01f, 0.0f }, 25.0f, 20.0f, g_LeafScale),
+
+		// top ring
+		Leaf({ g_RTop, g_YTop, 0.0f }, 28.0f, 90.0f, g_LeafScaleTop),
+		Leaf({ -g_RTop, g_YTop, 0.0f }, 28.0f, -90.0f, g_LeafScaleTop),
+		Leaf({ 0.0f, g_YTop, g_RTop }, 30.0f, 0.0f, g_LeafScaleTop),
+		Leaf({ 0.0f, g_YTop, -g_RTop }, 22.0f, 180.0f, g_LeafScaleTop)
+	};
+
+	/***********************************************************
+	 *  BakeScene()
+	 *
+	 *  Every parent comes before its children, so one pass in
+	 *  table order finds all world matrices.
+	 ***********************************************************/
+	constexpr BAKED_SCENE BakeScene()
+	{
+		BAKED_SCENE baked = {};
+		for (int node = 0; node < StaticScene::NODE_COUNT; node++)
+		{
+			baked.local[node] = Compose(g_Nodes[node]);
+			int parent = g_Nodes[node].parent;
+			if (parent >= 0)
+				baked.world[node] = Multiply(baked.world[parent], baked.local[node]);
+			else
+				baked.world[node] = baked.local[node];
+
+			for (int shape = 0; shape < StaticScene::SHAPE_COUNT; shape++)
+				baked.bounds[node][shape] = TransformBounds(baked.world[node], LocalBounds(shape));
+		}
+		return(baked);
+	}
+
+	constexpr BAKED_SCENE g_Baked = BakeScene();
+
+	/***********************************************************
+	 *  IsNear()
+	 ***********************************************************/
+	constexpr bool IsNear(double a, double b, double tolerance)
+	{
+		return((a - b <= tolerance) && (b - a <= tolerance));
+	}
+
+	// checks on the series and the table made while compiling
+	static_assert(IsNear(Sine(g_Pi / 6.0), 0.5, 1e-12), "constexpr sine is inaccurate");
+	static_assert(IsNear(Cosine(200.0 * g_Pi / 180.0), -0.93969262078590838, 1e-12),
+		"constexpr cosine is inaccurate");
+	static_assert(g_Nodes[StaticScene::NODE_LEAF_BASE].parent == StaticScene::NODE_PLANT,
+		"scene table is out of step with StaticScene::NODE");
+	static_assert(g_Nodes[StaticScene::NODE_COUNT - 1].parent == StaticScene::NODE_LEAF_BASE,
+		"scene table is out of step with StaticScene::LEAF_COUNT");
+	static_assert(IsNear(g_Baked.world[StaticScene::NODE_KEYBOARD_PLATE].m[3][1], 0.435, 1e-6),
+		"keyboard plate is not resting on the base");
+	static_assert(IsNear(g_Baked.bounds[StaticScene::NODE_DESK][StaticScene::SHAPE_PLANE].max.x, 12.0, 1e-6),
+		"desk bounds do not match its scale");
+	static_assert(sizeof(MAT4) == sizeof(glm::mat4), "baked matrices cannot be copied to glm");
+
+	/***********************************************************
+	 *  ToVec3()
+	 ***********************************************************/
+	glm::vec3 ToVec3(const VEC3& v)
+	{
+		return(glm::vec3(v.x, v.y, v.z));
+	}
+
+	/***********************************************************
+	 *  IsClose()
+	 ***********************************************************/
+	bool IsClose(float a, float b)
+	{
+		return(std::fabs(a - b) <= g_VerifyTolerance * (1.0f + std::fabs(b)));
+	}
+}
+
+/***********************************************************
+ *  GetParent()
+ ***********************************************************/
+int StaticScene::GetParent(int node)
+{
+	return(g_Nodes[node].parent);
+}
+
+/***********************************************************
+ *  GetLocalTransform()
+ ***********************************************************/
+void StaticScene::GetLocalTransform(int node, glm::vec3& scale,
+	glm::vec3& rotationDegrees, glm::vec3& position)
+{
+	scale = ToVec3(g_Nodes[node].scale);
+	rotationDegrees = ToVec3(g_Nodes[node].rotationDegrees);
+	position = ToVec3(g_Nodes[node].position);
+}
+
+/***********************************************************
+ *  GetLocalMatrix()
+ ***********************************************************/
+void StaticScene::GetLocalMatrix(int node, glm::mat4& localMatrix)
+{
+	std::memcpy(&localMatrix[0][0], g_Baked.local[node].m, sizeof(MAT4));
+}
+
+/***********************************************************
+ *  GetWorldMatrix()
+ ***********************************************************/
+void StaticScene::GetWorldMatrix(int node, glm::mat4& worldMatrix)
+{
+	std::memcpy(&worldMatrix[0][0], g_Baked.world[node].m, sizeof(MAT4));
+}
+
+/***********************************************************
+ *  GetLocalBounds()
+ ***********************************************************/
+void StaticScene::GetLocalBounds(SHAPE shape, glm::vec3& boundsMin, glm::vec3& boundsMax)
+{
+	BOUNDS bounds = LocalBounds(shape);
+	boundsMin = ToVec3(bounds.min);
+	boundsMax = ToVec3(bounds.max);
+}
+
+/***********************************************************
+ *  GetWorldBounds()
+ ***********************************************************/
+void StaticScene::GetWorldBounds(int node, SHAPE shape, glm::vec3& boundsMin, glm::vec3& boundsMax)
+{
+	const BOUNDS& bounds = g_Baked.bounds[node][shape];
+	boundsMin = ToVec3(bounds.min);
+	boundsMax = ToVec3(bounds.max);
+}
+
+/***********************************************************
+ *  Verify()
+ *
+ *  This method is used to check the constexpr math against
+ *  glm. The same table is added to a hierarchy through its
+ *  run time path, and the world matrices it composes, and
+ *  the bounds of each shape under them, have to match the
+ *  compiled ones to within float rounding.
+ ***********************************************************/
+bool StaticScene::Verify()
+{
+	TransformHierarchy hierarchy;
+	for (int node = 0; node < NODE_COUNT; node++)
+	{
+		glm::vec3 scale, rotationDegrees, position;
+		GetLocalTransform(node, scale, rotationDegrees, position);
+		hierarchy.AddNode(GetParent(node), scale, rotationDegrees, position);
+	}
+	hierarchy.Update();
+
+	for (int node = 0; node < NODE_COUNT; node++)
+	{
+		const glm::mat4& world = hierarchy.GetWorldMatrix(node);
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				if (IsClose(g_Baked.world[node].m[column][row], world[column][row]) == false)
+				{
+					std::cout << "ERROR: Compiled world matrix of scene node " << node
+						<< " differs from glm at [" << column << "][" << row << "]: "
+						<< g_Baked.world[node].m[column][row] << " vs " << world[column][row] << std::endl;
+					return false;
+				}
+			}
+		}
+
+		for (int shape = 0; shape < SHAPE_COUNT; shape++)
+		{
+			glm::vec3 localMin, localMax;
+			GetLocalBounds((SHAPE)shape, localMin, localMax);
+
+			glm::vec3 worldMin(0.0f);
+			glm::vec3 worldMax(0.0f);
+			for (int corner = 0; corner < 8; corner++)
+			{
+				glm::vec4 localCorner(
+					(corner & 1) ? localMax.x : localMin.x,
+					(corner & 2) ? localMax.y : localMin.y,
+					(corner & 4) ? localMax.z : localMin.z,
+					1.0f);
+				glm::vec3 worldCorner = glm::vec3(world * localCorner);
+				worldMin = (corner == 0) ? worldCorner : glm::min(worldMin, worldCorner);
+				worldMax = (corner == 0) ? worldCorner : glm::max(worldMax, worldCorner);
+			}
+
+			glm::vec3 bakedMin, bakedMax;
+			GetWorldBounds(node, (SHAPE)shape, bakedMin, bakedMax);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if ((IsClose(bakedMin[axis], worldMin[axis]) == false) ||
+					(IsClose(bakedMax[axis], worldMax[axis]) == false))
+				{
+					std::cout << "ERROR: Compiled bounds of scene node " << node
+						<< " differ from glm for shape " << shape << std::endl;
+					return false;
+				}
+			}
+		}
+	}
+
+	std::cout << "INFO: Compiled transforms of " << NODE_COUNT
+		<< " scene nodes match glm" << std::endl;
+	return true;
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// staticscene.h
+// ============
+// built-in scene transforms and bounds worked out when the program is compiled
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/***********************************************************
+ *  StaticScene
+ *
+ *  This class holds the transform nodes of the built-in
+ *  scene as a constant table. Every scale, rotation and
+ *  position in it is a literal, so the local and world
+ *  matrices of the nodes and the world bounds of the basic
+ *  mesh shapes placed by them are computed by constexpr
+ *  functions while compiling. Building the scene then only
+ *  copies the finished matrices into the hierarchy.
+ ***********************************************************/
+class StaticScene
+{
+public:
+	// nodes of the built-in scene, each parent listed before
+	// its children, in the order they are added to the
+	// transform hierarchy
+	enum NODE
+	{
+		NODE_FLOOR,
+		NODE_DESK,
+		NODE_KEYBOARD,
+		NODE_KEYBOARD_BASE,
+		NODE_KEYBOARD_PLATE,
+		NODE_MONITOR,
+		NODE_MONITOR_STAND,
+		NODE_MONITOR_SCREEN,
+		NODE_MOUSEPAD,
+		NODE_MOUSEPAD_BODY,
+		NODE_MOUSE,
+		NODE_PLANT,
+		NODE_POT,
+		NODE_STEM,
+		NODE_LEAF_BASE,
+		NODE_FIRST_LEAF
+	};
+
+	// leaves of the desk plant, which follow the other nodes
+	static const int LEAF_COUNT = 24;
+	static const int NODE_COUNT = NODE_FIRST_LEAF + LEAF_COUNT;
+
+	// conservative object space bounds of the basic meshes:
+	// the unit shapes span -1 to 1, the plane is flat in Y
+	// and the box sides span -0.5 to 0.5
+	enum SHAPE
+	{
+		SHAPE_UNIT,
+		SHAPE_PLANE,
+		SHAPE_BOX,
+		SHAPE_COUNT
+	};
+
+	// parent of a node, or -1 for a root
+	static int GetParent(int node);
+	// transform of a node relative to its parent, as listed
+	static void GetLocalTransform(int node, glm::vec3& scale,
+		glm::vec3& rotationDegrees, glm::vec3& position);
+	// matrices computed when compiling
+	static void GetLocalMatrix(int node, glm::mat4& localMatrix);
+	static void GetWorldMatrix(int node, glm::mat4& worldMatrix);
+
+	// object space bounds of a shape
+	static void GetLocalBounds(SHAPE shape, glm::vec3& boundsMin, glm::vec3& boundsMax);
+	// world space bounds of a shape placed by a node, computed
+	// when compiling
+	static void GetWorldBounds(int node, SHAPE shape, glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+	// compare the compiled matrices and bounds with the ones
+	// glm composes at run time, returning false and printing
+	// the first node that differs; run with --verify-transforms
+	static bool Verify();
+};
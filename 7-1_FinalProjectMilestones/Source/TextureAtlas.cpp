@@ -0,0 +1,338 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureatlas.cpp
+// ============
+// shared atlas pages for small and solid color scene textures
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TextureAtlas.h"
+#include "ResourceAccounting.h"
+
+#include <algorithm>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// images up to this size on both sides share the atlas
+	const int g_MaxImageSize = 128;
+
+	// images whose channels all stay within this range are
+	// stored as a single texel of their average color
+	const int g_SolidTolerance = 6;
+
+	// smallest mip level the pages keep; tiles are aligned to
+	// its texel size, and the guard band is one texel wide at
+	// that level, so no level filters across tiles
+	const int g_MaxMipLevel = 4;
+	const int g_TileAlignment = 1 << g_MaxMipLevel;
+	const int g_GuardBand = g_TileAlignment;
+
+	// page sizes tried, smallest first, before the images are
+	// spread over several pages of the largest size
+	const int g_MinPageSize = 64;
+	const int g_MaxPageSize = 1024;
+
+	int RoundUpToTile(int size)
+	{
+		return (size + g_TileAlignment - 1) / g_TileAlignment * g_TileAlignment;
+	}
+
+	// texel of the image a tile position shows, wrapping or
+	// clamping positions in the guard band
+	int GetSourceTexel(int position, int size, bool bRepeat)
+	{
+		if (bRepeat == true)
+			return ((position % size) + size) % size;
+		return std::min(std::max(position, 0), size - 1);
+	}
+}
+
+/***********************************************************
+ *  TextureAtlas()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TextureAtlas::TextureAtlas()
+{
+	m_bDirty = false;
+}
+
+/***********************************************************
+ *  ~TextureAtlas()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+TextureAtlas::~TextureAtlas()
+{
+	DestroyPages();
+}
+
+/***********************************************************
+ *  AddImage()
+ *
+ *  This method is used to take an image into the atlas. A
+ *  single color image becomes one texel whatever its size,
+ *  so it costs as little as the smallest image.
+ ***********************************************************/
+bool TextureAtlas::AddImage(const std::string& tag, const unsigned char* image,
+	int width, int height, int colorChannels, bool bRepeat)
+{
+	RemoveImage(tag);
+
+	if ((image == NULL) || (width <= 0) || (height <= 0) ||
+		((colorChannels != 3) && (colorChannels != 4)))
+		return false;
+
+	// channel ranges, stopping once the image cannot be solid
+	int minValue[4] = { 255, 255, 255, 255 };
+	int maxValue[4] = { 0, 0, 0, 0 };
+	bool bSolid = true;
+	int pixelCount = width * height;
+	for (int i = 0; (i < pixelCount) && (bSolid == true); i++)
+	{
+		for (int c = 0; c < colorChannels; c++)
+		{
+			int value = image[i * colorChannels + c];
+			minValue[c] = std::min(minValue[c], value);
+			maxValue[c] = std::max(maxValue[c], value);
+			if (maxValue[c] - minValue[c] > g_SolidTolerance * 2)
+				bSolid = false;
+		}
+	}
+
+	if ((bSolid == false) && ((width > g_MaxImageSize) || (height > g_MaxImageSize)))
+		return false;
+
+	ATLAS_ENTRY entry;
+	entry.tag = tag;
+	entry.page = 0;
+	entry.rect = glm::vec4(0.0f);
+	entry.bRepeat = bRepeat;
+	if (bSolid == true)
+	{
+		entry.width = 1;
+		entry.height = 1;
+		entry.pixels.resize(4);
+		for (int c = 0; c < 4; c++)
+		{
+			entry.pixels[c] = (c < colorChannels) ?
+				(unsigned char)((minValue[c] + maxValue[c]) / 2) : 255;
+		}
+	}
+	else
+	{
+		entry.width = width;
+		entry.height = height;
+		entry.pixels.resize(pixelCount * 4);
+		for (int i = 0; i < pixelCount; i++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				entry.pixels[i * 4 + c] = (c < colorChannels) ?
+					image[i * colorChannels + c] : 255;
+			}
+		}
+	}
+
+	std::cout << "INFO: Texture " << tag << " moved to the atlas"
+		<< ((bSolid == true) ? " as a solid color" : "") << std::endl;
+
+	m_entries.push_back(entry);
+	m_bDirty = true;
+	return true;
+}
+
+/***********************************************************
+ *  RemoveImage()
+ ***********************************************************/
+void TextureAtlas::RemoveImage(const std::string& tag)
+{
+	int index = FindEntry(tag);
+	if (index >= 0)
+	{
+		m_entries.erase(m_entries.begin() + index);
+		m_bDirty = true;
+	}
+}
+
+/***********************************************************
+ *  Clear()
+ ***********************************************************/
+void TextureAtlas::Clear()
+{
+	m_entries.clear();
+	DestroyPages();
+	m_bDirty = false;
+}
+
+/***********************************************************
+ *  FindEntry()
+ ***********************************************************/
+int TextureAtlas::FindEntry(const std::string& tag) const
+{
+	for (int i = 0; i < (int)m_entries.size(); i++)
+	{
+		if (m_entries[i].tag == tag)
+			return i;
+	}
+	return -1;
+}
+
+/***********************************************************
+ *  DestroyPages()
+ ***********************************************************/
+void TextureAtlas::DestroyPages()
+{
+	if (m_pageIDs.empty() == false)
+	{
+		glDeleteTextures((GLsizei)m_pageIDs.size(), m_pageIDs.data());
+		m_pageIDs.clear();
+	}
+	ResourceAccounting::Untrack(ResourceAccounting::CATEGORY_TEXTURE, "atlas pages");
+}
+
+/***********************************************************
+ *  PackEntries()
+ *
+ *  This method is used to place the tiles in rows, tallest
+ *  first, starting a new page when a row does not fit.
+ ***********************************************************/
+int TextureAtlas::PackEntries(int pageSize, std::vector<glm::ivec2>& tileCorners)
+{
+	std::vector<int> order(m_entries.size());
+	for (int i = 0; i < (int)order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [this](int a, int b) {
+		return m_entries[a].height > m_entries[b].height; });
+
+	tileCorners.resize(m_entries.size());
+	int page = 0;
+	int x = 0;
+	int y = 0;
+	int rowHeight = 0;
+	for (int index : order)
+	{
+		ATLAS_ENTRY& entry = m_entries[index];
+		int tileWidth = RoundUpToTile(entry.width + g_GuardBand * 2);
+		int tileHeight = RoundUpToTile(entry.height + g_GuardBand * 2);
+
+		if (x + tileWidth > pageSize)
+		{
+			x = 0;
+			y += rowHeight;
+			rowHeight = 0;
+		}
+		if (y + tileHeight > pageSize)
+		{
+			page++;
+			x = 0;
+			y = 0;
+			rowHeight = 0;
+		}
+
+		entry.page = page;
+		tileCorners[index] = glm::ivec2(x, y);
+		x += tileWidth;
+		rowHeight = std::max(rowHeight, tileHeight);
+	}
+
+	return(m_entries.empty() ? 0 : page + 1);
+}
+
+/***********************************************************
+ *  Build()
+ *
+ *  This method is used to rebuild the pages from the kept
+ *  images, on the smallest page that holds all of them. The
+ *  mip chain stops at the level the tiles are aligned to.
+ ***********************************************************/
+void TextureAtlas::Build()
+{
+	if (m_bDirty == false)
+		return;
+	m_bDirty = false;
+
+	DestroyPages();
+	if (m_entries.empty())
+		return;
+
+	std::vector<glm::ivec2> tileCorners;
+	int pageSize = g_MinPageSize;
+	int pageCount = PackEntries(pageSize, tileCorners);
+	while ((pageCount > 1) && (pageSize < g_MaxPageSize))
+	{
+		pageSize *= 2;
+		pageCount = PackEntries(pageSize, tileCorners);
+	}
+
+	std::vector<unsigned char> pagePixels;
+	for (int page = 0; page < pageCount; page++)
+	{
+		pagePixels.assign((size_t)pageSize * pageSize * 4, 0);
+		for (int i = 0; i < (int)m_entries.size(); i++)
+		{
+			ATLAS_ENTRY& entry = m_entries[i];
+			if (entry.page != page)
+				continue;
+
+			int tileWidth = RoundUpToTile(entry.width + g_GuardBand * 2);
+			int tileHeight = RoundUpToTile(entry.height + g_GuardBand * 2);
+			for (int ty = 0; ty < tileHeight; ty++)
+			{
+				int sourceY = GetSourceTexel(ty - g_GuardBand, entry.height, entry.bRepeat);
+				for (int tx = 0; tx < tileWidth; tx++)
+				{
+					int sourceX = GetSourceTexel(tx - g_GuardBand, entry.width, entry.bRepeat);
+					const unsigned char* pSource = &entry.pixels[(sourceY * entry.width + sourceX) * 4];
+					unsigned char* pTarget = &pagePixels[
+						((size_t)(tileCorners[i].y + ty) * pageSize + tileCorners[i].x + tx) * 4];
+					pTarget[0] = pSource[0];
+					pTarget[1] = pSource[1];
+					pTarget[2] = pSource[2];
+					pTarget[3] = pSource[3];
+				}
+			}
+
+			entry.rect = glm::vec4(
+				(float)(tileCorners[i].x + g_GuardBand) / pageSize,
+				(float)(tileCorners[i].y + g_GuardBand) / pageSize,
+				(float)entry.width / pageSize,
+				(float)entry.height / pageSize);
+		}
+
+		// the shader does the wrapping inside each tile, and
+		// anisotropic filtering is left off, since its wider
+		// footprint could reach past the guard band
+		GLuint pageID = 0;
+		glGenTextures(1, &pageID);
+		glBindTexture(GL_TEXTURE_2D, pageID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, g_MaxMipLevel);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, pageSize, pageSize, 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, pagePixels.data());
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		m_pageIDs.push_back(pageID);
+	}
+
+	std::cout << "INFO: Texture atlas holds " << m_entries.size() << " images on "
+		<< pageCount << " pages of " << pageSize << "x" << pageSize << std::endl;
+
+	// the pixel copies kept for repacking count as CPU memory
+	unsigned long long cpuBytes = 0;
+	for (const ATLAS_ENTRY& entry : m_entries)
+	{
+		cpuBytes += entry.pixels.size();
+	}
+	ResourceAccounting::Track(ResourceAccounting::CATEGORY_TEXTURE, "atlas pages",
+		pageCount * ResourceAccounting::GetTextureBytes(pageSize, pageSize, 4, g_MaxMipLevel + 1),
+		cpuBytes);
+}
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// textureatlas.h
+// ============
+// shared atlas pages for small and solid color scene textures
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  TextureAtlas
+ *
+ *  This class packs small textures, and textures that are
+ *  a single color, into shared atlas pages, so draws using
+ *  them sample the same texture unit. Each image is placed
+ *  in a tile on a grid aligned to the smallest mip level
+ *  the pages keep, and surrounded by a guard band filled
+ *  the way the image wraps, so filtering at any of those
+ *  levels never reads a neighboring tile. The shader maps
+ *  a draw's texture coordinates into its tile, repeating
+ *  or clamping them there.
+ ***********************************************************/
+class TextureAtlas
+{
+public:
+	// constructor
+	TextureAtlas();
+	// destructor
+	~TextureAtlas();
+
+	// an image placed in the atlas
+	struct ATLAS_ENTRY
+	{
+		std::string tag;
+		// page the image is on, and its tile in atlas texture
+		// coordinates: xy is the corner, zw the size
+		int page;
+		glm::vec4 rect;
+		// repeat the image across the tile, otherwise clamp
+		bool bRepeat;
+		// image size and RGBA pixels, kept for repacking
+		int width;
+		int height;
+		std::vector<unsigned char> pixels;
+	};
+
+	// add an image if it is small or a single color, replacing
+	// any image with the same tag; returns false when the
+	// image has to stay a texture of its own
+	bool AddImage(const std::string& tag, const unsigned char* image,
+		int width, int height, int colorChannels, bool bRepeat);
+	// remove the image with a tag, if it is in the atlas
+	void RemoveImage(const std::string& tag);
+	// remove every image and free the pages
+	void Clear();
+
+	// pack and upload the pages if images were added or
+	// removed since the last build
+	void Build();
+
+	// index of the entry for a tag, or -1
+	int FindEntry(const std::string& tag) const;
+	const ATLAS_ENTRY& GetEntry(int index) const { return m_entries[index]; }
+	int GetPageCount() const { return (int)m_pageIDs.size(); }
+	GLuint GetPageTexture(int page) const { return m_pageIDs[page]; }
+
+private:
+	std::vector<ATLAS_ENTRY> m_entries;
+	std::vector<GLuint> m_pageIDs;
+	// images changed since the pages were built
+	bool m_bDirty;
+
+	// assign tiles to every entry on pages of one size,
+	// returning the number of pages used
+	int PackEntries(int pageSize, std::vector<glm::ivec2>& tileCorners);
+	// free the page textures
+	void DestroyPages();
+};
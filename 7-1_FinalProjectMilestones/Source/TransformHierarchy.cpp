@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformhierarchy.cpp
+// ============
+// parent and child transforms with incremental world matrix updates
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TransformHierarchy.h"
+
+#include <glm/gtx/transform.hpp>
+
+/***********************************************************
+ *  TransformHierarchy()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+TransformHierarchy::TransformHierarchy()
+{
+	m_pass = 0;
+	m_firstDirty = 0;
+	m_lastUpdateCount = 0;
+}
+
+/***********************************************************
+ *  Clear()
+ ***********************************************************/
+void TransformHierarchy::Clear()
+{
+	m_parents.clear();
+	m_localMatrices.clear();
+	m_worldMatrices.clear();
+	m_dirty.clear();
+	m_baked.clear();
+	m_updatePass.clear();
+	m_firstDirty = 0;
+	m_lastUpdateCount = 0;
+}
+
+/***********************************************************
+ *  ComposeTransform()
+ ***********************************************************/
+glm::mat4 TransformHierarchy::ComposeTransform(const glm::vec3& scale,
+	const glm::vec3& rotationDegrees, const glm::vec3& position)
+{
+	glm::mat4 rotationX = glm::rotate(glm::radians(rotationDegrees.x), glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::mat4 rotationY = glm::rotate(glm::radians(rotationDegrees.y), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 rotationZ = glm::rotate(glm::radians(rotationDegrees.z), glm::vec3(0.0f, 0.0f, 1.0f));
+
+	return(glm::translate(position) * rotationZ * rotationY * rotationX * glm::scale(scale));
+}
+
+/***********************************************************
+ *  AddNode()
+ *
+ *  This method is used to append a node. Since a parent has
+ *  to be added before its children, appending keeps every
+ *  parent at a lower index than the nodes below it.
+ ***********************************************************/
+int TransformHierarchy::AddNode(int parent, const glm::vec3& scale,
+	const glm::vec3& rotationDegrees, const glm::vec3& position)
+{
+	int node = (int)m_parents.size();
+	if (parent >= node)
+		parent = -1;
+
+	m_parents.push_back(parent);
+	m_localMatrices.push_back(ComposeTransform(scale, rotationDegrees, position));
+	m_worldMatrices.push_back(glm::mat4(1.0f));
+	m_dirty.push_back(1);
+	m_baked.push_back(0);
+	m_updatePass.push_back(0);
+
+	if (m_firstDirty > node)
+		m_firstDirty = node;
+
+	return(node);
+}
+
+/***********************************************************
+ *  AddBakedNode()
+ *
+ *  This method is used to append a node with its world
+ *  matrix already known, so the next update can skip it.
+ *  The world matrix has to be the parent's world matrix
+ *  times the local one; a node under a parent that is still
+ *  dirty is recomputed along with it anyway.
+ ***********************************************************/
+int TransformHierarchy::AddBakedNode(int parent, const glm::mat4& localMatrix,
+	const glm::mat4& worldMatrix)
+{
+	int node = (int)m_parents.size();
+	if (parent >= node)
+		parent = -1;
+
+	m_parents.push_back(parent);
+	m_localMatrices.push_back(localMatrix);
+	m_worldMatrices.push_back(worldMatrix);
+	m_dirty.push_back(0);
+	m_baked.push_back(1);
+	m_updatePass.push_back(0);
+
+	// the first dirty node stays the node count when none is
+	if (m_firstDirty == node)
+		m_firstDirty = node + 1;
+
+	return(node);
+}
+
+/***********************************************************
+ *  SetLocalTransform()
+ *
+ *  This method is used to move a node. Setting the transform
+ *  a node already has leaves it clean.
+ ***********************************************************/
+void TransformHierarchy::SetLocalTransform(int node, const glm::vec3& scale,
+	const glm::vec3& rotationDegrees, const glm::vec3& position)
+{
+	if ((node < 0) || (node >= (int)m_parents.size()))
+		return;
+
+	glm::mat4 local = ComposeTransform(scale, rotationDegrees, position);
+	if (local == m_localMatrices[node])
+		return;
+
+	m_localMatrices[node] = local;
+	m_dirty[node] = 1;
+	if (m_firstDirty > node)
+		m_firstDirty = node;
+}
+
+/***********************************************************
+ *  Update()
+ *
+ *  This method is used to bring the world matrices up to
+ *  date in one pass from the first dirty node. A node is
+ *  recomputed when it is dirty or its parent was recomputed
+ *  in this pass, which its lower index guarantees has
+ *  already happened. Nodes before the first dirty node are
+ *  never visited.
+ ***********************************************************/
+void TransformHierarchy::Update()
+{
+	int nodeCount = (int)m_parents.size();
+	m_lastUpdateCount = 0;
+	if (m_firstDirty >= nodeCount)
+		return;
+
+	m_pass++;
+	for (int node = m_firstDirty; node < nodeCount; node++)
+	{
+		int parent = m_parents[node];
+		bool bParentMoved = (parent >= 0) && (m_updatePass[parent] == m_pass);
+		if ((m_dirty[node] == 0) && (bParentMoved == false))
+			continue;
+
+		if (parent >= 0)
+			m_worldMatrices[node] = m_worldMatrices[parent] * m_localMatrices[node];
+		else
+			m_worldMatrices[node] = m_localMatrices[node];
+		m_dirty[node] = 0;
+		m_baked[node] = 0;
+		m_updatePass[node] = m_pass;
+		m_lastUpdateCount++;
+	}
+
+	m_firstDirty = nodeCount;
+}
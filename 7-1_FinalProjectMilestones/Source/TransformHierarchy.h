@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// transformhierarchy.h
+// ============
+// parent and child transforms with incremental world matrix updates
+//
+//  AUTHOR: agent <agent@local>
+//	Created for CS-330-Computational Graphics and Visualization, Oct. 18th, 2026
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+/***********************************************************
+ *  TransformHierarchy
+ *
+ *  This class keeps scene transforms as a tree of nodes,
+ *  each placed relative to its parent. The nodes are stored
+ *  in flat arrays with every parent before its children, so
+ *  one forward pass computes all world matrices. Changing a
+ *  node only marks it dirty; the next update starts at the
+ *  first dirty node and recomputes just the dirty nodes and
+ *  the nodes below them, and does nothing at all when no
+ *  transform changed.
+ ***********************************************************/
+class TransformHierarchy
+{
+public:
+	// constructor
+	TransformHierarchy();
+
+	// remove every node
+	void Clear();
+	// add a node under a parent, or a root for a parent of -1,
+	// returning its index; the parent has to exist already
+	int AddNode(int parent, const glm::vec3& scale,
+		const glm::vec3& rotationDegrees, const glm::vec3& position);
+	// add a node whose local and world matrices were worked
+	// out ahead of time, which starts clean
+	int AddBakedNode(int parent, const glm::mat4& localMatrix, const glm::mat4& worldMatrix);
+	// change a node's transform relative to its parent
+	void SetLocalTransform(int node, const glm::vec3& scale,
+		const glm::vec3& rotationDegrees, const glm::vec3& position);
+
+	// recompute the world matrices of changed nodes and the
+	// nodes below them
+	void Update();
+
+	const glm::mat4& GetWorldMatrix(int node) const { return m_worldMatrices[node]; }
+	int GetParent(int node) const { return m_parents[node]; }
+	// whether a node still has the world matrix it was added
+	// with, not having been recomputed since
+	bool IsBaked(int node) const { return m_baked[node] != 0; }
+	int GetNodeCount() const { return (int)m_parents.size(); }
+	// number of world matrices recomputed by the last update
+	int GetLastUpdateCount() const { return m_lastUpdateCount; }
+
+private:
+	// parent of each node, always at a lower index, or -1
+	std::vector<int> m_parents;
+	std::vector<glm::mat4> m_localMatrices;
+	std::vector<glm::mat4> m_worldMatrices;
+	// set on nodes whose own transform changed
+	std::vector<unsigned char> m_dirty;
+	// set on nodes added with a baked world matrix, cleared
+	// once the matrix is recomputed
+	std::vector<unsigned char> m_baked;
+	// update pass in which each world matrix was last computed
+	std::vector<unsigned int> m_updatePass;
+	unsigned int m_pass;
+	// lowest dirty node, or the node count when none is dirty
+	int m_firstDirty;
+	int m_lastUpdateCount;
+
+	// scale, then rotate about X, Y and Z, then translate, the
+	// same order as SceneManager::SetTransformations()
+	static glm::mat4 ComposeTransform(const glm::vec3& scale,
+		const glm::vec3& rotationDegrees, const glm::vec3& position);
+};
@@ -8,6 +8,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ViewManager.h"
+#include "SceneManager.h"
+#include "FramePacer.h"
+#include "DynamicResolution.h"
+#include "GLCallTrace.h"
+#include "FrameCapture.h"
+#include "ResourceAccounting.h"
 #include <iostream>
 
 
@@ -24,6 +30,7 @@ namespace
 	const int WINDOW_HEIGHT = 800;
 	const char* g_ViewName = "view";
 	const char* g_ProjectionName = "projection";
+	const char* g_ViewPositionName = "viewPosition";
 
 	// camera object used for viewing and interacting with
 	// the 3D scene
@@ -34,6 +41,12 @@ namespace
 	float gLastY = WINDOW_HEIGHT / 2.0f;
 	bool gFirstMouse = true;
 
+	// mouse movement not yet applied to the camera, and the
+	// time the first of it arrived, or negative for none
+	float gMouseOffsetX = 0.0f;
+	float gMouseOffsetY = 0.0f;
+	double gMouseMotionTime = -1.0;
+
 	// time between current frame and last frame
 	float gDeltaTime = 0.0f; 
 	float gLastFrame = 0.0f;
@@ -41,6 +54,22 @@ namespace
 	// the following variable is false when orthographic projection
 	// is off and true when it is on
 	bool bOrthographicProjection = false;
+
+	// half the width of the scene shown by orthographic views
+	const float g_OrthoHalfWidth = 10.0f;
+
+	// time of the earliest input event not yet used by a
+	// frame, or negative when there is none
+	double gPendingInputTime = -1.0;
+
+	// set when the next frame would look different, and when
+	// the window needs repainting
+	bool gViewDirty = true;
+	bool gRefreshRequested = false;
+
+	// window framebuffer size seen by the last frame
+	int gLastFramebufferWidth = 0;
+	int gLastFramebufferHeight = 0;
 }
 
 /***********************************************************
@@ -54,6 +83,25 @@ ViewManager::ViewManager(
 	// initialize the member variables
 	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_pSceneManager = NULL;
+	m_pFramePacer = NULL;
+	m_frameInputTime = -1.0;
+	m_pDynamicResolution = NULL;
+	m_pCallTrace = NULL;
+	m_pFrameCapture = NULL;
+	m_bLateLatch = true;
+	m_aspectRatio = (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+	m_viewMatrix = glm::mat4(1.0f);
+	m_projectionMatrix = glm::mat4(1.0f);
+	m_viewCount = 1;
+	for (int i = 0; i < CameraBuffer::MAX_VIEWS; i++)
+	{
+		m_views[i].view = glm::mat4(1.0f);
+		m_views[i].projection = glm::mat4(1.0f);
+		m_views[i].position = glm::vec3(0.0f);
+		m_views[i].viewport = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	}
+	m_uniformProgramID = 0;
 	g_pCamera = new Camera();
 	// default camera view parameters
 	g_pCamera->Position = glm::vec3(0.0f, 5.0f, 12.0f);
@@ -105,11 +153,22 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 
 	// tell GLFW to capture all mouse events
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	// unaccelerated mouse movement for the camera when the
+	// platform has it
+	if (glfwRawMouseMotionSupported() == GLFW_TRUE)
+	{
+		glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+	}
 
 	// this callback is used to receive mouse moving events
 	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
 	// this callback is used to receive mouse scroll events
 	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Callback);
+	// this callback is used to timestamp key events
+	glfwSetKeyCallback(window, &ViewManager::Key_Callback);
+	// this callback is used to repaint the window after it is
+	// uncovered while rendering is idle
+	glfwSetWindowRefreshCallback(window, &ViewManager::Window_Refresh_Callback);
 
 	// set the initial viewport size (helps when window size differs from framebuffer size)
 	int fbWidth = 0, fbHeight = 0;
@@ -134,6 +193,12 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
  ***********************************************************/
 void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
 {
+	if (gPendingInputTime < 0.0)
+	{
+		gPendingInputTime = glfwGetTime();
+	}
+	gViewDirty = true;
+
 	if (gFirstMouse)
 	{
 		gLastX = xMousePos;
@@ -147,10 +212,89 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 	gLastX = xMousePos;
 	gLastY = yMousePos;
 
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+	// applied by the frame, at its start or when it latches
+	// the camera
+	if (gMouseMotionTime < 0.0)
+	{
+		gMouseMotionTime = glfwGetTime();
+	}
+	gMouseOffsetX += xOffset;
+	gMouseOffsetY += yOffset;
+}
+
+/***********************************************************
+ *  ApplyMouseMotion()
+ *
+ *  This method is used to turn the camera by the mouse
+ *  movement received since it was last applied, returning
+ *  the time the movement began, or a negative time if
+ *  there was none.
+ ***********************************************************/
+double ViewManager::ApplyMouseMotion()
+{
+	double motionTime = gMouseMotionTime;
+	if (motionTime >= 0.0)
+	{
+		g_pCamera->ProcessMouseMovement(gMouseOffsetX, gMouseOffsetY);
+		gMouseOffsetX = 0.0f;
+		gMouseOffsetY = 0.0f;
+		gMouseMotionTime = -1.0;
+	}
+	return(motionTime);
+}
+
+/***********************************************************
+ *  LatchCamera()
+ *
+ *  This method is used right before a recorded frame is
+ *  submitted. It polls the events again and turns the
+ *  camera by any mouse movement that arrived while the
+ *  frame was being recorded, updating the view matrix of
+ *  the interactive camera view. Only the orientation is
+ *  latched: the camera position and the keys stay as they
+ *  were at frame start, while culling and every pass of the
+ *  frame use the latched view.
+ ***********************************************************/
+bool ViewManager::LatchCamera(CameraBuffer::CAMERA_VIEW& view)
+{
+	if ((m_bLateLatch == false) || (bOrthographicProjection == true))
+		return false;
+
+	glfwPollEvents();
+	double motionTime = ApplyMouseMotion();
+	if (motionTime < 0.0)
+		return false;
+
+	// the frame now shows this movement, so the latency
+	// probe measures it from when it arrived and the input
+	// is no longer pending for the next frame
+	if ((m_frameInputTime < 0.0) || (motionTime < m_frameInputTime))
+	{
+		m_frameInputTime = motionTime;
+	}
+	gPendingInputTime = -1.0;
+
+	m_viewMatrix = g_pCamera->GetViewMatrix();
+	m_views[0].view = m_viewMatrix;
+	view.view = m_viewMatrix;
+	return true;
+}
+
+/***********************************************************
+ *  SetLateLatch()
+ ***********************************************************/
+void ViewManager::SetLateLatch(bool bEnabled)
+{
+	m_bLateLatch = bEnabled;
+	std::cout << "INFO: Late camera latching " << (bEnabled ? "enabled" : "disabled") << std::endl;
 }
 void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset)
 {
+	if (gPendingInputTime < 0.0)
+	{
+		gPendingInputTime = glfwGetTime();
+	}
+
 	if (g_pCamera != nullptr)
 	{
 		g_pCamera->MovementSpeed += static_cast<float>(yOffset) * 2.0f;
@@ -162,6 +306,68 @@ void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, doub
 	}
 }
 
+/***********************************************************
+ *  Key_Callback()
+ *
+ *  This method is automatically called from GLFW for key
+ *  events. Keys are read by polling, so the callback only
+ *  records when the input arrived.
+ ***********************************************************/
+void ViewManager::Key_Callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	if ((action == GLFW_PRESS) && (gPendingInputTime < 0.0))
+	{
+		gPendingInputTime = glfwGetTime();
+	}
+	gViewDirty = true;
+}
+
+/***********************************************************
+ *  Window_Refresh_Callback()
+ ***********************************************************/
+void ViewManager::Window_Refresh_Callback(GLFWwindow* window)
+{
+	gRefreshRequested = true;
+}
+
+/***********************************************************
+ *  IsViewDirty()
+ ***********************************************************/
+bool ViewManager::IsViewDirty() const
+{
+	return gViewDirty;
+}
+
+/***********************************************************
+ *  ClearViewDirty()
+ ***********************************************************/
+void ViewManager::ClearViewDirty()
+{
+	gViewDirty = false;
+}
+
+/***********************************************************
+ *  ConsumeRefreshRequest()
+ ***********************************************************/
+bool ViewManager::ConsumeRefreshRequest()
+{
+	bool bRequested = gRefreshRequested;
+	gRefreshRequested = false;
+	return bRequested;
+}
+
+/***********************************************************
+ *  ResetFrameTimer()
+ *
+ *  This method is used after the loop waited for events,
+ *  so the first frame after the wait does not move the
+ *  camera by the whole time spent waiting.
+ ***********************************************************/
+void ViewManager::ResetFrameTimer()
+{
+	gLastFrame = glfwGetTime();
+}
+
 /***********************************************************
  *  ProcessKeyboardEvents()
  *
@@ -176,6 +382,17 @@ void ViewManager::ProcessKeyboardEvents()
 		glfwSetWindowShouldClose(m_pWindow, true);
 	}
 
+	// a held movement key changes the view every frame
+	if ((glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS) ||
+		(glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS))
+	{
+		gViewDirty = true;
+	}
+
 	// process camera zooming in and out
 	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
 	{
@@ -217,15 +434,212 @@ void ViewManager::ProcessKeyboardEvents()
 	if (pDown && !pWasDown)
 	{
 		bOrthographicProjection = false; // perspective
+		gViewDirty = true;
 	}
 	if (oDown && !oWasDown)
 	{
 		bOrthographicProjection = true; // orthographic
+		gViewDirty = true;
 	}
 
 	pWasDown = pDown;
 	oWasDown = oDown;
 
+	// V cycles between one view, the camera beside a front
+	// view, and four views adding top and side views
+	static bool vWasDown = false;
+	bool vDown = (glfwGetKey(m_pWindow, GLFW_KEY_V) == GLFW_PRESS);
+	if (vDown && !vWasDown)
+	{
+		m_viewCount = (m_viewCount == 1) ? 2 : ((m_viewCount == 2) ? CameraBuffer::MAX_VIEWS : 1);
+		std::cout << "INFO: Showing " << m_viewCount << " view(s)" << std::endl;
+		gViewDirty = true;
+	}
+	vWasDown = vDown;
+
+	// M prints the estimated memory of every resource and
+	// writes the full table out for offline comparison
+	static bool mWasDown = false;
+	bool mDown = (glfwGetKey(m_pWindow, GLFW_KEY_M) == GLFW_PRESS);
+	if (mDown && !mWasDown)
+	{
+		ResourceAccounting::PrintSummary();
+		ResourceAccounting::WriteJSON("memory_report.json");
+	}
+	mWasDown = mDown;
+
+	// L toggles late camera latching, to compare the input
+	// latency with and without it using the F8 probe
+	static bool lWasDown = false;
+	bool lDown = (glfwGetKey(m_pWindow, GLFW_KEY_L) == GLFW_PRESS);
+	if (lDown && !lWasDown)
+	{
+		SetLateLatch(!m_bLateLatch);
+		if ((m_pFramePacer != NULL) && (m_pFramePacer->IsLatencyProbeEnabled() == true))
+		{
+			// start the statistics over for the new setting
+			m_pFramePacer->SetLatencyProbe(true);
+		}
+	}
+	lWasDown = lDown;
+
+	// B toggles lighting the static surfaces from the lightmap
+	static bool bWasDown = false;
+	bool bDown = (glfwGetKey(m_pWindow, GLFW_KEY_B) == GLFW_PRESS);
+	if (bDown && !bWasDown && (m_pSceneManager != NULL))
+	{
+		m_pSceneManager->SetBakedLighting(!m_pSceneManager->IsBakedLightingEnabled());
+	}
+	bWasDown = bDown;
+
+	// I toggles the billboard impostors of distant props
+	static bool iWasDown = false;
+	bool iDown = (glfwGetKey(m_pWindow, GLFW_KEY_I) == GLFW_PRESS);
+	if (iDown && !iWasDown && (m_pSceneManager != NULL))
+	{
+		m_pSceneManager->SetImpostors(!m_pSceneManager->IsImpostorsEnabled());
+	}
+	iWasDown = iDown;
+
+	// F1 toggles the depth pre-pass, F2 the overdraw view,
+	// F3 occlusion culling, F4 the shader permutations, F5 the
+	// per-draw data buffer, F6 multi-draw indirect, F7 cycles
+	// the presentation mode, F8 the input latency probe, F9
+	// dynamic resolution, F10 on-demand rendering, F11 the GL
+	// call statistics, F12 recording frames
+	static bool f1WasDown = false;
+	static bool f2WasDown = false;
+	static bool f3WasDown = false;
+	static bool f4WasDown = false;
+	static bool f5WasDown = false;
+	static bool f6WasDown = false;
+	static bool f7WasDown = false;
+	static bool f8WasDown = false;
+	static bool f9WasDown = false;
+	static bool f10WasDown = false;
+	static bool f11WasDown = false;
+	static bool f12WasDown = false;
+
+	bool f1Down = (glfwGetKey(m_pWindow, GLFW_KEY_F1) == GLFW_PRESS);
+	bool f2Down = (glfwGetKey(m_pWindow, GLFW_KEY_F2) == GLFW_PRESS);
+	bool f3Down = (glfwGetKey(m_pWindow, GLFW_KEY_F3) == GLFW_PRESS);
+	bool f4Down = (glfwGetKey(m_pWindow, GLFW_KEY_F4) == GLFW_PRESS);
+	bool f5Down = (glfwGetKey(m_pWindow, GLFW_KEY_F5) == GLFW_PRESS);
+	bool f6Down = (glfwGetKey(m_pWindow, GLFW_KEY_F6) == GLFW_PRESS);
+	bool f7Down = (glfwGetKey(m_pWindow, GLFW_KEY_F7) == GLFW_PRESS);
+	bool f8Down = (glfwGetKey(m_pWindow, GLFW_KEY_F8) == GLFW_PRESS);
+	bool f9Down = (glfwGetKey(m_pWindow, GLFW_KEY_F9) == GLFW_PRESS);
+	bool f10Down = (glfwGetKey(m_pWindow, GLFW_KEY_F10) == GLFW_PRESS);
+	bool f11Down = (glfwGetKey(m_pWindow, GLFW_KEY_F11) == GLFW_PRESS);
+	bool f12Down = (glfwGetKey(m_pWindow, GLFW_KEY_F12) == GLFW_PRESS);
+
+	if (m_pSceneManager != NULL)
+	{
+		if (f1Down && !f1WasDown)
+		{
+			m_pSceneManager->SetDepthPrePass(!m_pSceneManager->IsDepthPrePassEnabled());
+		}
+		if (f2Down && !f2WasDown)
+		{
+			m_pSceneManager->SetOverdrawView(!m_pSceneManager->IsOverdrawViewEnabled());
+		}
+		if (f3Down && !f3WasDown)
+		{
+			m_pSceneManager->SetOcclusionCulling(!m_pSceneManager->IsOcclusionCullingEnabled());
+		}
+		if (f4Down && !f4WasDown)
+		{
+			m_pSceneManager->SetShaderPermutations(!m_pSceneManager->IsShaderPermutationsEnabled());
+		}
+		if (f5Down && !f5WasDown)
+		{
+			m_pSceneManager->SetDrawDataBuffer(!m_pSceneManager->IsDrawDataBufferEnabled());
+		}
+		if (f6Down && !f6WasDown)
+		{
+			m_pSceneManager->SetMultiDraw(!m_pSceneManager->IsMultiDrawEnabled());
+		}
+	}
+	if (m_pFramePacer != NULL)
+	{
+		if (f7Down && !f7WasDown)
+		{
+			m_pFramePacer->CyclePresentMode();
+		}
+		if (f8Down && !f8WasDown)
+		{
+			m_pFramePacer->SetLatencyProbe(!m_pFramePacer->IsLatencyProbeEnabled());
+			std::cout << "INFO: Latency probe "
+				<< (m_pFramePacer->IsLatencyProbeEnabled() ? "enabled" : "disabled") << std::endl;
+		}
+		if (f10Down && !f10WasDown)
+		{
+			m_pFramePacer->SetOnDemand(!m_pFramePacer->IsOnDemand());
+		}
+	}
+	if ((m_pDynamicResolution != NULL) && f9Down && !f9WasDown)
+	{
+		m_pDynamicResolution->SetEnabled(!m_pDynamicResolution->IsEnabled());
+	}
+	if ((m_pCallTrace != NULL) && f11Down && !f11WasDown)
+	{
+		if (m_pCallTrace->IsInstalled() == true)
+			m_pCallTrace->Uninstall();
+		else
+			m_pCallTrace->Install();
+	}
+	if ((m_pFrameCapture != NULL) && f12Down && !f12WasDown)
+	{
+		if (m_pFrameCapture->IsCapturing() == true)
+			m_pFrameCapture->Stop();
+		else
+			m_pFrameCapture->Start("capture", FrameCapture::FORMAT_IMAGE_SEQUENCE);
+	}
+
+	f1WasDown = f1Down;
+	f2WasDown = f2Down;
+	f3WasDown = f3Down;
+	f4WasDown = f4Down;
+	f5WasDown = f5Down;
+	f6WasDown = f6Down;
+	f7WasDown = f7Down;
+	f8WasDown = f8Down;
+	f9WasDown = f9Down;
+	f10WasDown = f10Down;
+	f11WasDown = f11Down;
+	f12WasDown = f12Down;
+
+	// the left mouse button picks the object at the center of
+	// the view, where the mouse-look camera is aimed
+	static bool leftWasDown = false;
+	bool leftDown = (glfwGetMouseButton(m_pWindow, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS);
+	if ((m_pSceneManager != NULL) && leftDown && !leftWasDown)
+	{
+		// unproject the view center from the near to the far
+		// plane, which works for either projection
+		glm::mat4 inverseViewProjection = glm::inverse(m_projectionMatrix * m_viewMatrix);
+		glm::vec4 nearPoint = inverseViewProjection * glm::vec4(0.0f, 0.0f, -1.0f, 1.0f);
+		glm::vec4 farPoint = inverseViewProjection * glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		glm::vec3 origin = glm::vec3(nearPoint) / nearPoint.w;
+		glm::vec3 ray = glm::vec3(farPoint) / farPoint.w - origin;
+		float rayLength = glm::length(ray);
+
+		float hitDistance = 0.0f;
+		int objectID = -1;
+		if (rayLength > 0.0f)
+		{
+			objectID = m_pSceneManager->PickObject(origin, ray / rayLength, rayLength, hitDistance);
+		}
+		if (objectID >= 0)
+		{
+			std::cout << "INFO: Picked object " << objectID << " at distance " << hitDistance << std::endl;
+		}
+		else
+		{
+			std::cout << "INFO: No object at the view center" << std::endl;
+		}
+	}
+	leftWasDown = leftDown;
 }
 
 /***********************************************************
@@ -245,7 +659,37 @@ void ViewManager::PrepareSceneView()
 	gDeltaTime = currentFrame - gLastFrame;
 	gLastFrame = currentFrame;
 
+	// input received since the last frame is shown by this one
+	m_frameInputTime = gPendingInputTime;
+	gPendingInputTime = -1.0;
+
 	ProcessKeyboardEvents();
+	ApplyMouseMotion();
+
+	// follow the window size, keeping the last aspect ratio
+	// while the window is minimized
+	int framebufferWidth = 0;
+	int framebufferHeight = 0;
+	glfwGetFramebufferSize(m_pWindow, &framebufferWidth, &framebufferHeight);
+	if ((framebufferWidth > 0) && (framebufferHeight > 0))
+	{
+		m_aspectRatio = (float)framebufferWidth / (float)framebufferHeight;
+	}
+	if ((framebufferWidth != gLastFramebufferWidth) || (framebufferHeight != gLastFramebufferHeight))
+	{
+		gLastFramebufferWidth = framebufferWidth;
+		gLastFramebufferHeight = framebufferHeight;
+		gViewDirty = true;
+	}
+
+	// the interactive camera fills the window, or shares it
+	// with the fixed views of the current layout
+	glm::vec4 cameraViewport(0.0f, 0.0f, 1.0f, 1.0f);
+	if (m_viewCount == 2)
+		cameraViewport = glm::vec4(0.0f, 0.0f, 0.5f, 1.0f);
+	else if (m_viewCount > 2)
+		cameraViewport = glm::vec4(0.0f, 0.5f, 0.5f, 0.5f);
+	float aspectRatio = m_aspectRatio * cameraViewport.z / cameraViewport.w;
 
 	// Default: perspective uses the interactive camera
 	view = g_pCamera->GetViewMatrix();
@@ -259,7 +703,7 @@ void ViewManager::PrepareSceneView()
 		// Perspective projection
 		projection = glm::perspective(
 			glm::radians(g_pCamera->Zoom),
-			(GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT,
+			aspectRatio,
 			0.1f, 100.0f
 		);
 	}
@@ -273,8 +717,8 @@ void ViewManager::PrepareSceneView()
 		view = glm::lookAt(orthoCamPos, orthoTarget, orthoUp);
 
 		// Correct aspect ratio (prof specifically called this out)
-		float orthoHalfWidth = 10.0f;
-		float orthoHalfHeight = orthoHalfWidth * ((float)WINDOW_HEIGHT / (float)WINDOW_WIDTH);
+		float orthoHalfWidth = g_OrthoHalfWidth;
+		float orthoHalfHeight = orthoHalfWidth / aspectRatio;
 
 		projection = glm::ortho(
 			-orthoHalfWidth, orthoHalfWidth,
@@ -283,15 +727,70 @@ void ViewManager::PrepareSceneView()
 		);
 	}
 
+	m_viewMatrix = view;
+	m_projectionMatrix = projection;
+	m_views[0].view = view;
+	m_views[0].projection = projection;
+	m_views[0].position = usingOrtho ? orthoCamPos : g_pCamera->Position;
+	m_views[0].viewport = cameraViewport;
+
+	// fixed front view beside the camera, with top and side
+	// views below them in the four view layout
+	const glm::vec3 sceneCenter(0.0f, 1.0f, 0.0f);
+	if (m_viewCount == 2)
+	{
+		m_views[1].viewport = glm::vec4(0.5f, 0.0f, 0.5f, 1.0f);
+		SetOrthographicView(m_views[1], glm::vec3(0.0f, 1.0f, 8.0f), sceneCenter, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+	else if (m_viewCount > 2)
+	{
+		m_views[1].viewport = glm::vec4(0.5f, 0.5f, 0.5f, 0.5f);
+		SetOrthographicView(m_views[1], glm::vec3(0.0f, 1.0f, 8.0f), sceneCenter, glm::vec3(0.0f, 1.0f, 0.0f));
+		m_views[2].viewport = glm::vec4(0.0f, 0.0f, 0.5f, 0.5f);
+		SetOrthographicView(m_views[2], glm::vec3(0.0f, 20.0f, 0.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+		m_views[3].viewport = glm::vec4(0.5f, 0.0f, 0.5f, 0.5f);
+		SetOrthographicView(m_views[3], glm::vec3(12.0f, 1.0f, 0.0f), sceneCenter, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
 	if (m_pShaderManager != NULL)
 	{
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
+		if (m_uniformProgramID != m_pShaderManager->m_programID)
+		{
+			ShaderUniforms uniforms(m_pShaderManager->m_programID);
+			m_uniformProgramID = m_pShaderManager->m_programID;
+			m_viewUniform = uniforms.GetHandle<glm::mat4>(g_ViewName);
+			m_projectionUniform = uniforms.GetHandle<glm::mat4>(g_ProjectionName);
+			m_viewPositionUniform = uniforms.GetHandle<glm::vec3>(g_ViewPositionName);
+		}
+
+		ShaderUniforms::Set(m_viewUniform, view);
+		ShaderUniforms::Set(m_projectionUniform, projection);
 
 		// Use the correct camera position for lighting
 		if (!usingOrtho)
-			m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+			ShaderUniforms::Set(m_viewPositionUniform, g_pCamera->Position);
 		else
-			m_pShaderManager->setVec3Value("viewPosition", orthoCamPos);
+			ShaderUniforms::Set(m_viewPositionUniform, orthoCamPos);
 	}
 }
+
+/***********************************************************
+ *  SetOrthographicView()
+ *
+ *  This method is used to aim a fixed orthographic view,
+ *  sized to keep the scene's proportions in its part of the
+ *  window.
+ ***********************************************************/
+void ViewManager::SetOrthographicView(CameraBuffer::CAMERA_VIEW& view, const glm::vec3& eye,
+	const glm::vec3& target, const glm::vec3& up)
+{
+	float aspectRatio = m_aspectRatio * view.viewport.z / view.viewport.w;
+	float halfHeight = g_OrthoHalfWidth / aspectRatio;
+
+	view.view = glm::lookAt(eye, target, up);
+	view.projection = glm::ortho(
+		-g_OrthoHalfWidth, g_OrthoHalfWidth,
+		-halfHeight, halfHeight,
+		0.1f, 100.0f);
+	view.position = eye;
+}
@@ -10,11 +10,19 @@
 #pragma once
 
 #include "ShaderManager.h"
+#include "ShaderUniforms.h"
+#include "CameraBuffer.h"
 #include "camera.h"
 
 // GLFW library
 #include "GLFW/glfw3.h" 
 
+class SceneManager;
+class FramePacer;
+class DynamicResolution;
+class GLCallTrace;
+class FrameCapture;
+
 class ViewManager
 {
 public:
@@ -28,6 +36,10 @@ public:
 	static void Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos);
 	// mouse scroll callback for adjusting camera movement speed
 	static void Mouse_Scroll_Callback(GLFWwindow* window, double xOffset, double yOffset);
+	// key callback for timestamping input for the latency probe
+	static void Key_Callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+	// refresh callback for windows uncovered or damaged while idle
+	static void Window_Refresh_Callback(GLFWwindow* window);
 
 
 private:
@@ -35,9 +47,42 @@ private:
 	ShaderManager* m_pShaderManager;
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
+	// scene manager that receives the render mode toggles
+	SceneManager* m_pSceneManager;
+	// frame pacer that receives the presentation mode keys
+	FramePacer* m_pFramePacer;
+	// time of the earliest input applied to the current frame
+	double m_frameInputTime;
+	// render scaling that receives the dynamic resolution key
+	DynamicResolution* m_pDynamicResolution;
+	// GL call statistics toggled by the call trace key
+	GLCallTrace* m_pCallTrace;
+	// frame recording started and stopped by the capture key
+	FrameCapture* m_pFrameCapture;
+	// whether the camera is latched again before submission
+	bool m_bLateLatch;
+	// width over height of the window framebuffer
+	float m_aspectRatio;
+	// camera matrices from the last call to PrepareSceneView()
+	glm::mat4 m_viewMatrix;
+	glm::mat4 m_projectionMatrix;
+	// views shown side by side, the interactive camera first
+	CameraBuffer::CAMERA_VIEW m_views[CameraBuffer::MAX_VIEWS];
+	int m_viewCount;
+	// camera uniform handles, looked up again whenever the
+	// shader manager holds another program
+	GLuint m_uniformProgramID;
+	ShaderUniforms::HANDLE<glm::mat4> m_viewUniform;
+	ShaderUniforms::HANDLE<glm::mat4> m_projectionUniform;
+	ShaderUniforms::HANDLE<glm::vec3> m_viewPositionUniform;
 
 	// process keyboard events for interaction with the 3D scene
 	void ProcessKeyboardEvents();
+	// turn the camera by the mouse movement not yet applied
+	double ApplyMouseMotion();
+	// set a fixed orthographic view looking at the scene
+	void SetOrthographicView(CameraBuffer::CAMERA_VIEW& view, const glm::vec3& eye,
+		const glm::vec3& target, const glm::vec3& up);
 
 public:
 	// create the initial OpenGL display window
@@ -45,4 +90,40 @@ public:
 	
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+
+	// set the scene manager controlled by the render mode keys
+	void SetSceneManager(SceneManager* pSceneManager) { m_pSceneManager = pSceneManager; }
+	// set the frame pacer controlled by the presentation keys
+	void SetFramePacer(FramePacer* pFramePacer) { m_pFramePacer = pFramePacer; }
+	// set the render scaling controlled by the resolution key
+	void SetDynamicResolution(DynamicResolution* pDynamicResolution) { m_pDynamicResolution = pDynamicResolution; }
+	// set the GL call statistics controlled by the call trace key
+	void SetCallTrace(GLCallTrace* pCallTrace) { m_pCallTrace = pCallTrace; }
+	// set the frame recording controlled by the capture key
+	void SetFrameCapture(FrameCapture* pFrameCapture) { m_pFrameCapture = pFrameCapture; }
+	// time of the earliest input the current frame shows, or
+	// a negative time if no input arrived since the last frame
+	double GetFrameInputTime() const { return m_frameInputTime; }
+	// poll the newest input and update the interactive view
+	// with mouse look that arrived since PrepareSceneView(),
+	// returning false if the view did not change
+	bool LatchCamera(CameraBuffer::CAMERA_VIEW& view);
+	// enable or disable latching the camera before submission
+	void SetLateLatch(bool bEnabled);
+	bool IsLateLatchEnabled() const { return m_bLateLatch; }
+	// whether the camera, projection or window size changed
+	// since the last call to ClearViewDirty()
+	bool IsViewDirty() const;
+	void ClearViewDirty();
+	// whether the window asked to be repainted, clearing the request
+	bool ConsumeRefreshRequest();
+	// restart the frame timer after the loop slept while idle
+	void ResetFrameTimer();
+	// camera matrices for the current frame
+	const glm::mat4& GetViewMatrix() const { return m_viewMatrix; }
+	const glm::mat4& GetProjectionMatrix() const { return m_projectionMatrix; }
+	// every view of the current frame, the camera matrices
+	// above being those of the first
+	const CameraBuffer::CAMERA_VIEW* GetViews() const { return m_views; }
+	int GetViewCount() const { return m_viewCount; }
 };
\ No newline at end of file
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenefragmentshader.glsl
+// ============
+// fragment shader for the specialized scene shader permutations
+//
+// Uses the same uniforms as the course fragment shader, but the
+// texture, lighting and light count choices are compile-time
+// defines, so each permutation only contains the path it runs.
+// With USE_DRAW_DATA_BUFFER the per-draw color, UV scale and
+// material are read from the DrawDataRing storage buffer.
+// Textures with a TextureAtlas tile are sampled from the
+// tile, wrapped the way their own texture would wrap.
+// The camera position comes from the CameraBuffer entry of
+// the view the vertex shader rendered the fragment into.
+// With USE_BAKED_LIGHTING the ambient and diffuse light is
+// read from the LightBaker lightmap tile, leaving only the
+// specular highlights to be lit per fragment.
+///////////////////////////////////////////////////////////////////////////////
+#version 330 core
+
+// feature defines, normally supplied by ShaderPermutations
+#ifndef USE_TEXTURE
+#define USE_TEXTURE 0
+#endif
+#ifndef USE_LIGHTING
+#define USE_LIGHTING 0
+#endif
+#ifndef USE_DIRECTIONAL_LIGHT
+#define USE_DIRECTIONAL_LIGHT 0
+#endif
+#ifndef USE_DRAW_DATA_BUFFER
+#define USE_DRAW_DATA_BUFFER 0
+#endif
+#ifndef USE_BAKED_LIGHTING
+#define USE_BAKED_LIGHTING 0
+#endif
+#ifndef POINT_LIGHT_COUNT
+#define POINT_LIGHT_COUNT 0
+#endif
+
+#define TOTAL_POINT_LIGHTS 5
+#define MAX_VIEWS 4
+
+struct Material
+{
+	vec3 diffuseColor;
+	vec3 specularColor;
+	float shininess;
+};
+
+struct DirectionalLight
+{
+	vec3 direction;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool bActive;
+};
+
+struct PointLight
+{
+	vec3 position;
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+	bool bActive;
+};
+
+in vec3 fragmentPosition;
+in vec3 fragmentVertexNormal;
+in vec2 fragmentTextureCoordinate;
+flat in int fragmentViewIndex;
+
+out vec4 outFragmentColor;
+
+// cameras of the views rendered this frame, matching CameraBuffer
+struct CameraView
+{
+	mat4 view;
+	mat4 projection;
+	vec4 position;
+};
+
+layout (std140) uniform CameraBlock
+{
+	CameraView cameras[MAX_VIEWS];
+};
+
+#define viewPosition cameras[fragmentViewIndex].position.xyz
+
+uniform sampler2D objectTexture;
+uniform sampler2D lightmapTexture;
+uniform DirectionalLight directionalLight;
+uniform PointLight pointLights[TOTAL_POINT_LIGHTS];
+
+#if USE_DRAW_DATA_BUFFER
+// per-draw data, matching DrawDataRing::DRAW_DATA
+struct DrawData
+{
+	mat4 model;
+	vec4 color;
+	vec4 uvScale;
+	vec4 atlasRect;
+	vec4 diffuseColor;
+	vec4 specularColor;
+	vec4 lightmapRect;
+};
+
+layout (std430, binding = 0) readonly buffer DrawDataBuffer
+{
+	DrawData drawData[];
+};
+
+flat in int fragmentDrawIndex;
+
+#define objectColor drawData[fragmentDrawIndex].color
+#define UVscale drawData[fragmentDrawIndex].uvScale.xy
+#define atlasRect drawData[fragmentDrawIndex].atlasRect
+#define bAtlasRepeat (drawData[fragmentDrawIndex].uvScale.z > 0.0)
+#define materialDiffuseColor drawData[fragmentDrawIndex].diffuseColor.xyz
+#define materialSpecularColor drawData[fragmentDrawIndex].specularColor.xyz
+#define materialShininess drawData[fragmentDrawIndex].diffuseColor.w
+#define lightmapRect drawData[fragmentDrawIndex].lightmapRect
+#else
+uniform vec4 objectColor;
+uniform vec2 UVscale;
+uniform vec4 atlasRect;
+uniform bool bAtlasRepeat;
+uniform Material material;
+uniform vec4 lightmapRect;
+
+#define materialDiffuseColor material.diffuseColor
+#define materialSpecularColor material.specularColor
+#define materialShininess material.shininess
+#endif
+
+#if USE_LIGHTING
+// ambient, diffuse and specular terms of one light
+vec3 CalcLight(vec3 lightDirection, vec3 ambient, vec3 diffuse, vec3 specular,
+	vec3 normal, vec3 viewDirection)
+{
+	float diffuseImpact = max(dot(normal, lightDirection), 0.0);
+	vec3 reflectDirection = reflect(-lightDirection, normal);
+	float specularImpact = pow(max(dot(viewDirection, reflectDirection), 0.0), materialShininess);
+
+#if USE_BAKED_LIGHTING
+	// ambient and diffuse terms come from the lightmap
+	return specular * specularImpact * materialSpecularColor;
+#else
+	return (ambient * materialDiffuseColor) +
+		(diffuse * diffuseImpact * materialDiffuseColor) +
+		(specular * specularImpact * materialSpecularColor);
+#endif
+}
+#endif
+
+void main()
+{
+#if USE_TEXTURE
+	vec2 textureCoordinate = fragmentTextureCoordinate * UVscale;
+	vec4 baseColor;
+	if (atlasRect.z > 0.0)
+	{
+		// wrap into the tile, taking the gradients from the
+		// unwrapped coordinates so the seam keeps its mip level
+		vec2 tileCoordinate = bAtlasRepeat ?
+			fract(textureCoordinate) : clamp(textureCoordinate, 0.0, 1.0);
+		baseColor = textureGrad(objectTexture,
+			atlasRect.xy + tileCoordinate * atlasRect.zw,
+			dFdx(textureCoordinate) * atlasRect.zw,
+			dFdy(textureCoordinate) * atlasRect.zw);
+	}
+	else
+	{
+		baseColor = texture(objectTexture, textureCoordinate);
+	}
+#else
+	vec4 baseColor = objectColor;
+#endif
+
+#if USE_LIGHTING
+	vec3 normal = normalize(fragmentVertexNormal);
+	vec3 viewDirection = normalize(viewPosition - fragmentPosition);
+#if USE_BAKED_LIGHTING
+	vec3 phongResult = texture(lightmapTexture,
+		lightmapRect.xy + fragmentTextureCoordinate * lightmapRect.zw).rgb * materialDiffuseColor;
+#else
+	vec3 phongResult = vec3(0.0);
+#endif
+
+#if USE_DIRECTIONAL_LIGHT
+	phongResult += CalcLight(normalize(-directionalLight.direction),
+		directionalLight.ambient, directionalLight.diffuse, directionalLight.specular,
+		normal, viewDirection);
+#endif
+
+#if POINT_LIGHT_COUNT > 0
+	for (int i = 0; i < POINT_LIGHT_COUNT; i++)
+	{
+		phongResult += CalcLight(normalize(pointLights[i].position - fragmentPosition),
+			pointLights[i].ambient, pointLights[i].diffuse, pointLights[i].specular,
+			normal, viewDirection);
+	}
+#endif
+
+	outFragmentColor = vec4(phongResult * baseColor.xyz, baseColor.w);
+#else
+	outFragmentColor = baseColor;
+#endif
+}
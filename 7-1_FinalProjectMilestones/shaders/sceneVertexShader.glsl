@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenevertexshader.glsl
+// ============
+// vertex shader for the specialized scene shader permutations
+//
+// The camera matrices come from the CameraBuffer uniform
+// block. A draw with one instance per view renders into
+// every view, selecting the viewport here when
+// VIEWPORT_FROM_VERTEX is defined.
+///////////////////////////////////////////////////////////////////////////////
+#version 330 core
+
+#ifndef USE_DRAW_DATA_BUFFER
+#define USE_DRAW_DATA_BUFFER 0
+#endif
+#ifndef VIEWPORT_FROM_VERTEX
+#define VIEWPORT_FROM_VERTEX 0
+#endif
+
+#define MAX_VIEWS 4
+
+layout (location = 0) in vec3 inVertexPosition;
+layout (location = 1) in vec3 inVertexNormal;
+layout (location = 2) in vec2 inTextureCoordinate;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+flat out int fragmentViewIndex;
+
+// cameras of the views rendered this frame, matching CameraBuffer
+struct CameraView
+{
+	mat4 view;
+	mat4 projection;
+	vec4 position;
+};
+
+layout (std140) uniform CameraBlock
+{
+	CameraView cameras[MAX_VIEWS];
+};
+
+// view of the first instance; further instances of a draw
+// are rendered into the views after it
+uniform int viewOffset;
+
+#if USE_DRAW_DATA_BUFFER
+// per-draw data, matching DrawDataRing::DRAW_DATA
+struct DrawData
+{
+	mat4 model;
+	vec4 color;
+	vec4 uvScale;
+	vec4 atlasRect;
+	vec4 diffuseColor;
+	vec4 specularColor;
+	vec4 lightmapRect;
+};
+
+layout (std430, binding = 0) readonly buffer DrawDataBuffer
+{
+	DrawData drawData[];
+};
+
+// index of the current draw in the buffer, an instanced
+// attribute in the shared geometry or a constant otherwise
+layout (location = 3) in int inDrawIndex;
+flat out int fragmentDrawIndex;
+#else
+uniform mat4 model;
+#endif
+
+void main()
+{
+	int viewIndex = viewOffset + gl_InstanceID;
+	mat4 view = cameras[viewIndex].view;
+	mat4 projection = cameras[viewIndex].projection;
+	fragmentViewIndex = viewIndex;
+#if VIEWPORT_FROM_VERTEX
+	gl_ViewportIndex = viewIndex;
+#endif
+
+#if USE_DRAW_DATA_BUFFER
+	mat4 model = drawData[inDrawIndex].model;
+	fragmentDrawIndex = inDrawIndex;
+#endif
+
+	// same expression as the depth pre-pass, so GL_EQUAL matches
+	gl_Position = projection * view * model * vec4(inVertexPosition, 1.0f);
+
+	fragmentPosition = vec3(model * vec4(inVertexPosition, 1.0f));
+	fragmentVertexNormal = mat3(transpose(inverse(model))) * inVertexNormal;
+	fragmentTextureCoordinate = inTextureCoordinate;
+}